@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+namespace kgraph {
+
+/* plain disjoint set union with union by size */
+class dsu_t final {
+public:
+    explicit dsu_t(std::size_t size = 0u) : parent_(size), size_(size, 1u) {
+        for(std::size_t i = 0; i < size; ++i) {
+            parent_[i] = i;
+        }
+    }
+
+    std::size_t find(std::size_t v) {
+        /* path halving */
+        while(parent_[v] != v) {
+            parent_[v] = parent_[parent_[v]];
+            v = parent_[v];
+        }
+        return v;
+    }
+
+    /* return false if v1 and v2 are already in one set */
+    bool unite(std::size_t v1, std::size_t v2) {
+        v1 = find(v1); v2 = find(v2);
+        if(v1 == v2) {
+            return false;
+        }
+
+        if(size_[v1] < size_[v2]) {
+            std::swap(v1, v2);
+        }
+        parent_[v2] = v1;
+        size_[v1] += size_[v2];
+        return true;
+    }
+
+    std::size_t size() const {return parent_.size();}
+
+private:
+    std::vector<std::size_t> parent_;
+    std::vector<std::size_t> size_;
+};
+
+/*  disjoint set union, which also keeps parity of the path from vertex to its root
+    (i.e. if vertex has the same color as root in 2-coloring) */
+class parity_dsu_t final {
+public:
+    struct find_result_t {
+        std::size_t root;
+        bool parity; /* false - same color with root */
+    };
+
+    /* add singleton set, return its id */
+    std::size_t push() {
+        parent_.push_back(parent_.size());
+        size_.push_back(1u);
+        parity_.push_back(0u);
+        return parent_.size() - 1;
+    }
+
+    find_result_t find(std::size_t v);
+
+    /*  lhs, rhs - find results for different sets
+        unite sets so that lhs and rhs vertices get different colors */
+    void link(const find_result_t& lhs, const find_result_t& rhs);
+
+    std::size_t size() const {return parent_.size();}
+    std::size_t set_size(std::size_t root) const {return size_[root];}
+
+private:
+    std::vector<std::size_t> parent_;
+    std::vector<std::size_t> size_;   /* valid only for roots */
+    std::vector<unsigned char> parity_; /* parity of edge to parent */
+};
+
+inline parity_dsu_t::find_result_t parity_dsu_t::find(std::size_t v) {
+    std::size_t root = v;
+    unsigned char parity = 0u;
+    while(parent_[root] != root) {
+        parity ^= parity_[root];
+        root = parent_[root];
+    }
+
+    const bool ret = parity;
+
+    /* path compression: every vertex on the path now points to root */
+    while(parent_[v] != root) {
+        std::size_t next = parent_[v];
+        unsigned char next_parity = parity ^ parity_[v];
+
+        parent_[v] = root;
+        parity_[v] = parity;
+
+        v = next;
+        parity = next_parity;
+    }
+
+    return {root, ret};
+}
+
+inline void parity_dsu_t::link(const find_result_t& lhs, const find_result_t& rhs) {
+    std::size_t big = lhs.root, small = rhs.root;
+    if(size_[big] < size_[small]) {
+        std::swap(big, small);
+    }
+
+    parent_[small] = big;
+    parity_[small] = lhs.parity ^ rhs.parity ^ 1u;
+    size_[big] += size_[small];
+}
+
+} /* namespace kgraph */
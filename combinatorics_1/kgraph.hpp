@@ -8,6 +8,16 @@
 #include <stack>	
 #include <cassert>
 #include <optional>
+#include <queue>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <limits>
+#include <atomic>
+
+#include "dsu.hpp"
+#include "pairing_heap.hpp"
 
 namespace kgraph {
 
@@ -38,6 +48,25 @@ struct color_t {
 template<typename VT, typename ET>
 class kgraph_t final {
 public:
+    struct edge_t {
+        std::size_t v1, v2; /* user idx */
+        ET data;
+    };
+
+    /* connected components, component ids are from 0 to sizes.size() - 1 */
+    struct components_t {
+        std::vector<std::pair<std::size_t, std::size_t>> labels; /* pair's of user idx and component id */
+        std::vector<std::size_t> sizes;
+        std::vector<std::size_t> representatives; /* user idx of some vertex of component */
+    };
+
+    /*  compressed sparse row snapshot of graph, all idx are internal
+        neighbours of v are adjacent[offsets[v]] ... adjacent[offsets[v + 1] - 1] */
+    struct csr_t {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> adjacent;
+        std::vector<std::size_t> edges; /* idx of edge data for every adjacent vertex */
+    };
     kgraph_t() : vertex_size_(0u), vertex_capacity_(1u) {
         graph_.resize(vertex_capacity_);
         vertex_data_.resize(vertex_capacity_);
@@ -51,8 +80,56 @@ public:
        return cycle of odd len, if it exists */
     std::optional<std::vector<std::size_t>> fill_bipartite_color(std::size_t v, color_t::COLOR v_color);
 
+    /*  the same, but components are colored in parallel. Unlike fill_bipartite_color all components
+        are colored even if odd cycle is found, returned cycle is the one fill_bipartite_color would find */
+    std::optional<std::vector<std::size_t>> fill_bipartite_color_parallel(std::size_t v, color_t::COLOR v_color, std::size_t threads_count);
+
+    /* lock-free parallel union-find with path splitting */
+    components_t get_components(std::size_t threads_count = 1u) const;
+    /* parallel min label propagation, O(diameter) iterations */
+    components_t get_components_propagation(std::size_t threads_count = 1u) const;
+
     /* return vector of pair's of user idx and color */
     std::vector<std::pair<std::size_t, color_t::COLOR>> get_color() const;
+    /* all vertices become empty, fill_bipartite_color doesn't recolor already colored vertices */
+    void reset_color();
+
+    /* incremental mode: bipartite flag is updated by every push_edge in O(alpha(n)) */
+    bool is_bipartite() const {return !odd_edge_.has_value();}
+
+    /* return cycle of odd len (user idx), if graph isn't bipartite */
+    std::optional<std::vector<std::size_t>> get_odd_cycle() const;
+
+    std::size_t get_vertex_number() const {return vertex_size_;}
+    std::size_t get_edge_number() const {return edge_data_.size();}
+
+    /* approximate number of bytes allocated by graph */
+    std::size_t get_memory_usage() const;
+
+    /*  weighted algorithms, edge data is used as weight (must be non negative)
+        return vector of pair's of user idx and distance for all reachable vertices */
+
+    /* dijkstra with pairing heap */
+    std::vector<std::pair<std::size_t, ET>> shortest_paths(std::size_t source) const;
+
+    /* delta-stepping, relaxations of every bucket are split between threads_count threads */
+    std::vector<std::pair<std::size_t, ET>> shortest_paths_parallel(std::size_t source, ET delta, std::size_t threads_count) const;
+
+    /* minimum spanning forest */
+    std::vector<edge_t> minimum_spanning_tree() const; /* kruskal */
+    std::vector<edge_t> minimum_spanning_tree_boruvka(std::size_t threads_count = 1u) const;
+
+    csr_t get_csr() const;
+
+    /*  matching algorithms require graph colored by fill_bipartite_color
+        return pair's of user idx (blue vertex, red vertex) */
+
+    /* maximum matching, hopcroft-karp on csr layout, O(E * sqrt(V)) */
+    std::vector<std::pair<std::size_t, std::size_t>> max_bipartite_matching() const;
+
+    /*  maximum weight matching, hungarian algorithm on dense blue * red table,
+        O(V^3) time and O(blue * red) memory, so it is for moderate sizes */
+    std::vector<edge_t> max_weight_bipartite_matching() const;
 
 private:
     void vertex_realloc(std::size_t new_vertex_capacity);
@@ -60,11 +137,47 @@ private:
         retern  - internal idx */
     std::size_t push_vertex(std::size_t v);
 
+    /* v - user idx, return internal idx */
+    std::size_t internal_vertex(std::size_t v) const;
+
     /* return internal idx */
-    std::size_t pair_incident_vertex(std::size_t edge_id);
+    std::size_t pair_incident_vertex(std::size_t edge_id) const;
+
+    /* essense idx -> idx in edge_data_ */
+    std::size_t get_edge_id(std::size_t essense) const;
+
+    /* throw if graph isn't correctly 2-colored */
+    void check_bipartite_color() const;
 
-    /* v - internal id */
-    bool fill_bipartite_itirate(std::size_t w, std::vector<std::size_t>& odd_cycle);
+    /* return first essense idx of every edge */
+    std::vector<std::size_t> get_first_essenses() const;
+
+    /* number of self loops, which essenses are placed before essense idx */
+    std::size_t loops_before(std::size_t essense) const;
+
+    /*  relax edges (light - weight <= delta, heavy - others) of vertices from [first, last)
+        and put improving pairs of vertex and distance into requests */
+    void relax_edges(const std::size_t* first, const std::size_t* last, const std::vector<ET>& dist,
+                     const std::vector<char>& reached, ET delta, bool light,
+                     std::vector<std::pair<std::size_t, ET>>& requests) const;
+
+    /*  w - internal id
+        parents - dfs tree, can be shared between calls for different components */
+    bool fill_bipartite_itirate(std::size_t w, std::vector<std::size_t>& odd_cycle, std::vector<std::size_t>& parents);
+
+    /* return component id for every internal idx, ids are ordered by the smallest internal idx of component */
+    std::vector<std::size_t> label_components(std::size_t threads_count) const;
+    std::vector<std::size_t> label_components_propagation(std::size_t threads_count) const;
+
+    /* convert internal labels to components_t */
+    components_t make_components(const std::vector<std::size_t>& labels) const;
+
+    /* call func(thread_id) in threads_count threads */
+    template<typename F>
+    static void run_parallel(std::size_t threads_count, F func);
+
+    /* v1, v2 - internal idx */
+    void update_bipartite(std::size_t v1, std::size_t v2);
 private:
     /* essense can be vertex or edge */
     struct essense_t {
@@ -84,12 +197,22 @@ private:
         color_t::COLOR color = color_t::empty;
     };
     std::vector<vertex_data_t> vertex_data_;
-    /* edge_data_[i] matchs to graph_[i + vertex_capacity_] edge */
+    /*  edge_data_[i] matchs to i-th pushed edge. Edge has 2 essenses, self loop - only one,
+        so essenses of i-th edge start from (vertex_capacity_ + 2 * i - loops before it) */
     std::vector<ET> edge_data_;
+    /* essense idx of self loops minus vertex_capacity_, sorted */
+    std::vector<std::size_t> loops_;
 
     /* bijection between iser id's and internal idx for vertices */
     std::unordered_map<std::size_t, std::size_t> user2internal_;
     std::unordered_map<std::size_t, std::size_t> internal2user_;
+
+    /* incremental bipartite check: dsu_ ids are internal idx */
+    parity_dsu_t dsu_;
+    /* edges (internal idx), which united dsu_ sets - spanning forest, used for odd cycle witness */
+    std::vector<std::pair<std::size_t, std::size_t>> forest_edges_;
+    /* first edge, which closed odd cycle */
+    std::optional<std::pair<std::size_t, std::size_t>> odd_edge_;
 };
 
 
@@ -107,6 +230,7 @@ std::size_t kgraph_t<VT, ET>::push_vertex(std::size_t v) {
     internal2user_[vertex_size_] = v;
     
     graph_[ret] = {0, ret, ret};
+    dsu_.push();
 
     ++vertex_size_;
     return ret;
@@ -117,6 +241,11 @@ void kgraph_t<VT, ET>::push_edge(std::size_t v1, std::size_t v2, const ET& edge_
     std::size_t internal_v1 = push_vertex(v1);
     std::size_t internal_v2 = push_vertex(v2);
 
+    if(internal_v1 == internal_v2) {
+        loops_.push_back(graph_.size() - vertex_capacity_);
+    }
+    edge_data_.push_back(edge_data);
+
     /* first essesnse */
     {
         std::size_t last_essense = graph_[internal_v1].prev;
@@ -132,6 +261,81 @@ void kgraph_t<VT, ET>::push_edge(std::size_t v1, std::size_t v2, const ET& edge_
         graph_[last_essense].next = graph_.size();
         graph_.push_back({internal_v2, internal_v2, last_essense});
     }
+
+    update_bipartite(internal_v1, internal_v2);
+}
+
+template<typename VT, typename ET>
+void kgraph_t<VT, ET>::update_bipartite(std::size_t v1, std::size_t v2) {
+    /* graph only grows, so odd cycle can't disappear */
+    if(odd_edge_.has_value()) {
+        return;
+    }
+
+    parity_dsu_t::find_result_t lhs = dsu_.find(v1);
+    parity_dsu_t::find_result_t rhs = dsu_.find(v2);
+
+    if(lhs.root != rhs.root) {
+        dsu_.link(lhs, rhs);
+        forest_edges_.push_back({v1, v2});
+    } else if(lhs.parity == rhs.parity) {
+        odd_edge_ = std::make_pair(v1, v2);
+    }
+}
+
+template<typename VT, typename ET>
+std::optional<std::vector<std::size_t>> kgraph_t<VT, ET>::get_odd_cycle() const {
+    if(!odd_edge_.has_value()) {
+        return std::optional<std::vector<std::size_t>>();
+    }
+
+    auto [start, finish] = odd_edge_.value();
+    if(start == finish) {
+        return std::vector<std::size_t>{internal2user_.at(start)};
+    }
+
+    /* start and finish have the same parity in spanning forest, so path between them has even len */
+    std::vector<std::size_t> offsets(vertex_size_ + 1, 0u);
+    for(auto&& edge : forest_edges_) {
+        ++offsets[edge.first + 1];
+        ++offsets[edge.second + 1];
+    }
+    for(std::size_t i = 0; i < vertex_size_; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<std::size_t> adjacent(offsets.back());
+    std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+    for(auto&& edge : forest_edges_) {
+        adjacent[pos[edge.first]++] = edge.second;
+        adjacent[pos[edge.second]++] = edge.first;
+    }
+
+    const std::size_t none = vertex_size_;
+    std::vector<std::size_t> parents(vertex_size_, none);
+    std::queue<std::size_t> queue;
+    parents[start] = start;
+    queue.push(start);
+
+    while(!queue.empty() && (parents[finish] == none)) {
+        std::size_t current_vertex = queue.front();
+        queue.pop();
+
+        for(std::size_t i = offsets[current_vertex]; i < offsets[current_vertex + 1]; ++i) {
+            if(parents[adjacent[i]] == none) {
+                parents[adjacent[i]] = current_vertex;
+                queue.push(adjacent[i]);
+            }
+        }
+    }
+
+    std::vector<std::size_t> odd_cycle;
+    for(std::size_t v = finish; v != start; v = parents[v]) {
+        odd_cycle.push_back(internal2user_.at(v));
+    }
+    odd_cycle.push_back(internal2user_.at(start));
+
+    return odd_cycle;
 }
 
 template<typename VT, typename ET>
@@ -141,13 +345,13 @@ void kgraph_t<VT, ET>::vertex_realloc(std::size_t new_vertex_capacity) {
     for(std::size_t i = 0, maxi = vertex_size_; i < maxi; ++i) {
         tmp[i].incident_vertex = 0u;
         tmp[i].next = (graph_[i].next >= vertex_capacity_) ? graph_[i].next + cap_delta : graph_[i].next;
-        tmp[i].prev = (graph_[i].next >= vertex_capacity_) ? graph_[i].prev + cap_delta : graph_[i].prev;
+        tmp[i].prev = (graph_[i].prev >= vertex_capacity_) ? graph_[i].prev + cap_delta : graph_[i].prev;
     }
 
     for(std::size_t i = vertex_capacity_, maxi = graph_.size(); i < maxi; ++i) {
         tmp[i + cap_delta].incident_vertex = graph_[i].incident_vertex;
         tmp[i + cap_delta].next = (graph_[i].next >= vertex_capacity_) ? graph_[i].next + cap_delta : graph_[i].next;
-        tmp[i + cap_delta].prev = (graph_[i].next >= vertex_capacity_) ? graph_[i].prev + cap_delta : graph_[i].prev;
+        tmp[i + cap_delta].prev = (graph_[i].prev >= vertex_capacity_) ? graph_[i].prev + cap_delta : graph_[i].prev;
     }
 
     vertex_capacity_ += cap_delta;
@@ -160,12 +364,13 @@ std::optional<std::vector<std::size_t>> kgraph_t<VT, ET>::fill_bipartite_color(s
     std::size_t ret = true;
     std::size_t start_v = vertex_capacity_ + 1;
     std::vector<std::size_t> odd_cycle;
+    std::vector<std::size_t> parents(vertex_size_);
 
     for(std::size_t w = 0; w < vertex_size_; ++w) {
         if(internal2user_[w] == v) {
             start_v = w;
             vertex_data_[w].color = v_color;
-            ret = fill_bipartite_itirate(w, odd_cycle);
+            ret = fill_bipartite_itirate(w, odd_cycle, parents);
             break;
         }
     }
@@ -184,16 +389,204 @@ std::optional<std::vector<std::size_t>> kgraph_t<VT, ET>::fill_bipartite_color(s
         }
 
         vertex_data_[w].color = v_color;
-        ret = fill_bipartite_itirate(w, odd_cycle);
+        ret = fill_bipartite_itirate(w, odd_cycle, parents);
     }
 
     return (ret) ? std::optional<std::vector<std::size_t>>() : odd_cycle;
 }
 
 template<typename VT, typename ET>
-bool kgraph_t<VT, ET>::fill_bipartite_itirate(std::size_t w, std::vector<std::size_t>& odd_cycle) {
+template<typename F>
+void kgraph_t<VT, ET>::run_parallel(std::size_t threads_count, F func) {
+    std::vector<std::thread> threads;
+    for(std::size_t i = 1; i < threads_count; ++i) {
+        threads.emplace_back(func, i);
+    }
+
+    func(0u);
+    for(auto&& thread : threads) {
+        thread.join();
+    }
+}
+
+template<typename VT, typename ET>
+std::vector<std::size_t> kgraph_t<VT, ET>::label_components(std::size_t threads_count) const {
+    threads_count = std::max<std::size_t>(threads_count, 1u);
+    std::vector<std::size_t> essenses = get_first_essenses();
+
+    std::vector<std::atomic<std::size_t>> parents(vertex_size_);
+    for(std::size_t v = 0; v < vertex_size_; ++v) {
+        parents[v].store(v, std::memory_order_relaxed);
+    }
+
+    auto find = [&parents](std::size_t v) {
+        /* path splitting: every vertex on the path is linked to its grandparent */
+        for(;;) {
+            std::size_t parent = parents[v].load(std::memory_order_relaxed);
+            if(parent == v) {
+                return v;
+            }
+
+            std::size_t grandparent = parents[parent].load(std::memory_order_relaxed);
+            if(parent != grandparent) {
+                parents[v].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+            }
+            v = grandparent;
+        }
+    };
+
+    /* roots with bigger idx are linked to smaller ones, so links never form a cycle */
+    auto unite = [&](std::size_t v1, std::size_t v2) {
+        for(;;) {
+            v1 = find(v1);
+            v2 = find(v2);
+            if(v1 == v2) {
+                return;
+            }
+
+            if(v1 < v2) {
+                std::swap(v1, v2);
+            }
+
+            std::size_t expected = v1;
+            if(parents[v1].compare_exchange_strong(expected, v2, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    };
+
+    run_parallel(threads_count, [&](std::size_t thread_id) {
+        std::size_t size = essenses.size();
+        for(std::size_t id = size * thread_id / threads_count, maxid = size * (thread_id + 1) / threads_count; id < maxid; ++id) {
+            unite(graph_[essenses[id]].incident_vertex, pair_incident_vertex(essenses[id]));
+        }
+    });
+
+    /* root of every component is its smallest vertex */
+    std::vector<std::size_t> labels(vertex_size_);
+    run_parallel(threads_count, [&](std::size_t thread_id) {
+        for(std::size_t v = vertex_size_ * thread_id / threads_count, maxv = vertex_size_ * (thread_id + 1) / threads_count; v < maxv; ++v) {
+            labels[v] = find(v);
+        }
+    });
+
+    return labels;
+}
+
+template<typename VT, typename ET>
+std::vector<std::size_t> kgraph_t<VT, ET>::label_components_propagation(std::size_t threads_count) const {
+    threads_count = std::max<std::size_t>(threads_count, 1u);
+    csr_t csr = get_csr();
+
+    std::vector<std::size_t> labels(vertex_size_), new_labels(vertex_size_);
+    std::iota(labels.begin(), labels.end(), 0u);
+
+    /* every vertex takes minimal label of its neighbourhood, labels of previous iteration are only read */
+    for(bool changed = true; changed;) {
+        std::vector<char> thread_changed(threads_count, 0);
+        run_parallel(threads_count, [&](std::size_t thread_id) {
+            for(std::size_t v = vertex_size_ * thread_id / threads_count, maxv = vertex_size_ * (thread_id + 1) / threads_count; v < maxv; ++v) {
+                std::size_t label = labels[v];
+                for(std::size_t i = csr.offsets[v], maxi = csr.offsets[v + 1]; i < maxi; ++i) {
+                    label = std::min(label, labels[csr.adjacent[i]]);
+                }
+
+                /* pointer jumping: label is a vertex, which may already know smaller label */
+                label = std::min(label, labels[label]);
+                new_labels[v] = label;
+                thread_changed[thread_id] |= (label != labels[v]);
+            }
+        });
+
+        labels.swap(new_labels);
+        changed = std::find(thread_changed.begin(), thread_changed.end(), 1) != thread_changed.end();
+    }
+
+    return labels;
+}
+
+template<typename VT, typename ET>
+typename kgraph_t<VT, ET>::components_t kgraph_t<VT, ET>::make_components(const std::vector<std::size_t>& labels) const {
+    components_t ret;
+    ret.labels.reserve(vertex_size_);
+
+    /* label is the smallest vertex of component, so roots are met in increasing order */
+    std::vector<std::size_t> ids(vertex_size_);
+    for(std::size_t v = 0; v < vertex_size_; ++v) {
+        if(labels[v] == v) {
+            ids[v] = ret.sizes.size();
+            ret.sizes.push_back(0u);
+            ret.representatives.push_back(internal2user_.at(v));
+        }
+
+        std::size_t id = ids[labels[v]];
+        ++ret.sizes[id];
+        ret.labels.push_back({internal2user_.at(v), id});
+    }
+
+    return ret;
+}
+
+template<typename VT, typename ET>
+typename kgraph_t<VT, ET>::components_t kgraph_t<VT, ET>::get_components(std::size_t threads_count /* = 1u */) const {
+    return make_components(label_components(threads_count));
+}
+
+template<typename VT, typename ET>
+typename kgraph_t<VT, ET>::components_t kgraph_t<VT, ET>::get_components_propagation(std::size_t threads_count /* = 1u */) const {
+    return make_components(label_components_propagation(threads_count));
+}
+
+template<typename VT, typename ET>
+std::optional<std::vector<std::size_t>> kgraph_t<VT, ET>::fill_bipartite_color_parallel(std::size_t v, color_t::COLOR v_color, std::size_t threads_count) {
+    threads_count = std::max<std::size_t>(threads_count, 1u);
+    std::size_t start_v = internal_vertex(v);
+    std::vector<std::size_t> labels = label_components(threads_count);
+
+    /*  dfs starts from v in its component and from the smallest vertex in others,
+        as in fill_bipartite_color, so colors are the same */
+    std::vector<std::size_t> starts;
+    for(std::size_t w = 0; w < vertex_size_; ++w) {
+        if(labels[w] == w) {
+            starts.push_back((w == labels[start_v]) ? start_v : w);
+        }
+    }
+
+    /* fill_bipartite_color checks v component first, then others in order of their smallest vertex */
+    auto order = [&](std::size_t component) {
+        return (starts[component] == start_v) ? 0u : component + 1;
+    };
+
+    std::vector<std::size_t> parents(vertex_size_);
+    std::vector<std::vector<std::size_t>> odd_cycles(threads_count);
+    std::vector<std::size_t> odd_orders(threads_count, static_cast<std::size_t>(-1));
+    std::atomic<std::size_t> next_component{0u};
+
+    run_parallel(threads_count, [&](std::size_t thread_id) {
+        std::vector<std::size_t> odd_cycle;
+        for(std::size_t component = next_component++; component < starts.size(); component = next_component++) {
+            std::size_t w = starts[component];
+            vertex_data_[w].color = v_color;
+            odd_cycle.clear();
+
+            if(!fill_bipartite_itirate(w, odd_cycle, parents) && (order(component) < odd_orders[thread_id])) {
+                odd_orders[thread_id] = order(component);
+                odd_cycles[thread_id] = odd_cycle;
+            }
+        }
+    });
+
+    std::size_t best = std::min_element(odd_orders.begin(), odd_orders.end()) - odd_orders.begin();
+    if(odd_orders[best] == static_cast<std::size_t>(-1)) {
+        return std::optional<std::vector<std::size_t>>();
+    }
+
+    return odd_cycles[best];
+}
+
+template<typename VT, typename ET>
+bool kgraph_t<VT, ET>::fill_bipartite_itirate(std::size_t w, std::vector<std::size_t>& odd_cycle, std::vector<std::size_t>& parents) {
     std::stack<std::size_t> stack;
-    std::vector<size_t> parents(vertex_size_);
 
     stack.push(w);
 
@@ -210,7 +603,7 @@ bool kgraph_t<VT, ET>::fill_bipartite_itirate(std::size_t w, std::vector<std::si
             std::size_t tmp_vertex = pair_incident_vertex(current_edge);
 
             if(tmp_vertex == current_vertex) {
-                odd_cycle.push_back(internal2user_[tmp_vertex]);
+                odd_cycle.push_back(internal2user_.at(tmp_vertex));
                 return false;
             }
 
@@ -224,14 +617,14 @@ bool kgraph_t<VT, ET>::fill_bipartite_itirate(std::size_t w, std::vector<std::si
 
                 std::size_t p = parents[current_vertex];
                 
-                odd_cycle.push_back(internal2user_[current_vertex]);
+                odd_cycle.push_back(internal2user_.at(current_vertex));
                 while(p != parents[tmp_vertex]) {
-                    odd_cycle.push_back(internal2user_[p]);
+                    odd_cycle.push_back(internal2user_.at(p));
                     p = parents[p];
                 }
 
-                odd_cycle.push_back(internal2user_[p]);
-                odd_cycle.push_back(internal2user_[tmp_vertex]);
+                odd_cycle.push_back(internal2user_.at(p));
+                odd_cycle.push_back(internal2user_.at(tmp_vertex));
 
                 return false;
             }
@@ -258,8 +651,608 @@ std::vector<std::pair<std::size_t, color_t::COLOR>> kgraph_t<VT, ET>::get_color(
 }
 
 template<typename VT, typename ET>
-std::size_t kgraph_t<VT, ET>::pair_incident_vertex(std::size_t edge_id) {
-    return ((edge_id) % 2) ? graph_[edge_id - 1].incident_vertex : graph_[edge_id + 1].incident_vertex;
+void kgraph_t<VT, ET>::reset_color() {
+    for(std::size_t i = 0; i < vertex_size_; ++i) {
+        vertex_data_[i].color = color_t::empty;
+    }
+}
+
+template<typename VT, typename ET>
+std::size_t kgraph_t<VT, ET>::loops_before(std::size_t essense) const {
+    if(loops_.empty()) {
+        return 0u;
+    }
+
+    return std::lower_bound(loops_.begin(), loops_.end(), essense - vertex_capacity_) - loops_.begin();
+}
+
+template<typename VT, typename ET>
+std::size_t kgraph_t<VT, ET>::pair_incident_vertex(std::size_t edge_id) const {
+    std::size_t loops = loops_before(edge_id);
+    if((loops < loops_.size()) && (loops_[loops] == edge_id - vertex_capacity_)) {
+        return graph_[edge_id].incident_vertex;
+    }
+
+    return ((edge_id - vertex_capacity_ - loops) % 2) ? graph_[edge_id - 1].incident_vertex : graph_[edge_id + 1].incident_vertex;
+}
+
+template<typename VT, typename ET>
+std::size_t kgraph_t<VT, ET>::get_edge_id(std::size_t essense) const {
+    std::size_t loops = loops_before(essense);
+    return loops + (essense - vertex_capacity_ - loops) / 2;
+}
+
+template<typename VT, typename ET>
+std::size_t kgraph_t<VT, ET>::get_memory_usage() const {
+    /* node of unordered_map holds next pointer and pair, buckets are pointers */
+    std::size_t map_node = sizeof(void*) + sizeof(std::pair<const std::size_t, std::size_t>);
+    std::size_t maps = (user2internal_.size() + internal2user_.size()) * map_node +
+                       (user2internal_.bucket_count() + internal2user_.bucket_count()) * sizeof(void*);
+
+    return graph_.capacity() * sizeof(essense_t) + vertex_data_.capacity() * sizeof(vertex_data_t) +
+           edge_data_.capacity() * sizeof(ET) + loops_.capacity() * sizeof(std::size_t) + maps +
+           dsu_.size() * (2 * sizeof(std::size_t) + sizeof(unsigned char)) +
+           forest_edges_.capacity() * sizeof(std::pair<std::size_t, std::size_t>);
+}
+
+template<typename VT, typename ET>
+std::vector<std::size_t> kgraph_t<VT, ET>::get_first_essenses() const {
+    std::vector<std::size_t> ret;
+    ret.reserve(edge_data_.size());
+
+    for(std::size_t i = vertex_capacity_, maxi = graph_.size(); i < maxi; ++i) {
+        if(get_edge_id(i) == ret.size()) {
+            ret.push_back(i);
+        }
+    }
+
+    return ret;
+}
+
+template<typename VT, typename ET>
+typename kgraph_t<VT, ET>::csr_t kgraph_t<VT, ET>::get_csr() const {
+    csr_t csr;
+    csr.offsets.reserve(vertex_size_ + 1);
+    csr.adjacent.reserve(graph_.size() - vertex_capacity_);
+    csr.edges.reserve(graph_.size() - vertex_capacity_);
+
+    csr.offsets.push_back(0u);
+    for(std::size_t v = 0; v < vertex_size_; ++v) {
+        for(std::size_t current_edge = graph_[v].next; current_edge != v; current_edge = graph_[current_edge].next) {
+            csr.adjacent.push_back(pair_incident_vertex(current_edge));
+            csr.edges.push_back(get_edge_id(current_edge));
+        }
+        csr.offsets.push_back(csr.adjacent.size());
+    }
+
+    return csr;
+}
+
+template<typename VT, typename ET>
+void kgraph_t<VT, ET>::check_bipartite_color() const {
+    for(std::size_t v = 0; v < vertex_size_; ++v) {
+        color_t::COLOR v_color = vertex_data_[v].color;
+        if(v_color == color_t::empty) {
+            throw std::runtime_error("graph isn't colored, call fill_bipartite_color first");
+        }
+
+        for(std::size_t current_edge = graph_[v].next; current_edge != v; current_edge = graph_[current_edge].next) {
+            if(vertex_data_[pair_incident_vertex(current_edge)].color == v_color) {
+                throw std::runtime_error("graph isn't bipartite");
+            }
+        }
+    }
+}
+
+template<typename VT, typename ET>
+std::vector<std::pair<std::size_t, std::size_t>> kgraph_t<VT, ET>::max_bipartite_matching() const {
+    check_bipartite_color();
+    csr_t csr = get_csr();
+
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> blue;
+    for(std::size_t v = 0; v < vertex_size_; ++v) {
+        if(vertex_data_[v].color == color_t::blue) {
+            blue.push_back(v);
+        }
+    }
+
+    std::vector<std::size_t> match(vertex_size_, none); /* for both blue and red vertices */
+    std::vector<std::size_t> dist(vertex_size_, none);  /* bfs layers for blue vertices */
+    std::vector<std::size_t> iterators(vertex_size_);
+    std::vector<std::size_t> queue;
+    std::vector<std::pair<std::size_t, std::size_t>> stack; /* blue vertex and red vertex, through which we came */
+    queue.reserve(blue.size());
+
+    /* greedy initial matching removes most of the phases */
+    for(auto&& v : blue) {
+        for(std::size_t j = csr.offsets[v], maxj = csr.offsets[v + 1]; j < maxj; ++j) {
+            if(match[csr.adjacent[j]] == none) {
+                match[v] = csr.adjacent[j];
+                match[csr.adjacent[j]] = v;
+                break;
+            }
+        }
+    }
+
+    for(;;) {
+        /* bfs from free blue vertices builds layered graph */
+        queue.clear();
+        for(auto&& v : blue) {
+            dist[v] = (match[v] == none) ? 0u : none;
+            if(match[v] == none) {
+                queue.push_back(v);
+            }
+        }
+
+        /* layer of the shortest augmenting paths ends */
+        std::size_t limit = none;
+        for(std::size_t i = 0; i < queue.size(); ++i) {
+            std::size_t v = queue[i];
+            if(dist[v] >= limit) {
+                break;
+            }
+
+            for(std::size_t j = csr.offsets[v], maxj = csr.offsets[v + 1]; j < maxj; ++j) {
+                std::size_t w = match[csr.adjacent[j]];
+                if(w == none) {
+                    limit = dist[v] + 1;
+                } else if(dist[w] == none) {
+                    dist[w] = dist[v] + 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+
+        if(limit == none) {
+            break;
+        }
+
+        /* iterative dfs finds maximal set of vertex disjoint shortest augmenting paths */
+        for(auto&& v : blue) {
+            iterators[v] = csr.offsets[v];
+        }
+
+        for(auto&& start : blue) {
+            if(match[start] != none) {
+                continue;
+            }
+
+            stack.clear();
+            stack.push_back({start, none});
+            while(!stack.empty()) {
+                std::size_t v = stack.back().first;
+                if(iterators[v] == csr.offsets[v + 1]) {
+                    dist[v] = none; /* dead end */
+                    stack.pop_back();
+                    continue;
+                }
+
+                std::size_t u = csr.adjacent[iterators[v]++];
+                std::size_t w = match[u];
+                if((w == none) && (dist[v] + 1 == limit)) {
+                    /* augment: every blue vertex on stack takes red vertex after it */
+                    stack.back().second = u;
+                    for(auto&& [blue_v, red_v] : stack) {
+                        match[blue_v] = red_v;
+                        match[red_v] = blue_v;
+                    }
+                    break;
+                }
+
+                if((w != none) && (dist[w] == dist[v] + 1)) {
+                    stack.back().second = u;
+                    stack.push_back({w, none});
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> ret;
+    for(auto&& v : blue) {
+        if(match[v] != none) {
+            ret.push_back({internal2user_.at(v), internal2user_.at(match[v])});
+        }
+    }
+
+    return ret;
+}
+
+template<typename VT, typename ET>
+std::vector<typename kgraph_t<VT, ET>::edge_t> kgraph_t<VT, ET>::max_weight_bipartite_matching() const {
+    static_assert(std::is_arithmetic_v<ET>, "weighted matching requires arithmetic edge data");
+    using cost_t = std::conditional_t<std::is_integral_v<ET>, long long, long double>;
+
+    check_bipartite_color();
+
+    /* rows - smaller part, cols - bigger part */
+    std::vector<std::size_t> rows, cols;
+    for(std::size_t v = 0; v < vertex_size_; ++v) {
+        (vertex_data_[v].color == color_t::blue ? rows : cols).push_back(v);
+    }
+
+    bool swapped = rows.size() > cols.size();
+    if(swapped) {
+        rows.swap(cols);
+    }
+
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> position(vertex_size_);
+    for(std::size_t i = 0; i < rows.size(); ++i) {position[rows[i]] = i;}
+    for(std::size_t j = 0; j < cols.size(); ++j) {position[cols[j]] = j;}
+
+    /* cost = -weight of the heaviest edge between vertices, 0 if there is no edge */
+    std::size_t n = rows.size(), m = cols.size();
+    std::vector<cost_t> cost(n * m, cost_t{});
+    std::vector<std::size_t> best_edge(n * m, none);
+    std::vector<std::size_t> essenses = get_first_essenses();
+    for(std::size_t id = 0; id < essenses.size(); ++id) {
+        std::size_t v1 = graph_[essenses[id]].incident_vertex;
+        std::size_t v2 = pair_incident_vertex(essenses[id]);
+        if((vertex_data_[v1].color == color_t::blue) == swapped) {
+            std::swap(v1, v2);
+        }
+
+        std::size_t cell = position[v1] * m + position[v2];
+        cost_t tmp_cost = -static_cast<cost_t>(edge_data_[id]);
+        if(tmp_cost < cost[cell]) {
+            cost[cell] = tmp_cost;
+            best_edge[cell] = id;
+        }
+    }
+
+    /* hungarian algorithm with potentials, rows and cols are 1-indexed, col 0 is fictive */
+    const cost_t inf = std::numeric_limits<cost_t>::max();
+    std::vector<cost_t> u(n + 1), v(m + 1), minv(m + 1);
+    std::vector<std::size_t> p(m + 1, 0u), way(m + 1, 0u);
+    std::vector<char> used(m + 1);
+
+    for(std::size_t i = 1; i <= n; ++i) {
+        p[0] = i;
+        std::size_t j0 = 0;
+        std::fill(minv.begin(), minv.end(), inf);
+        std::fill(used.begin(), used.end(), 0);
+
+        do {
+            used[j0] = 1;
+            std::size_t i0 = p[j0], j1 = 0;
+            cost_t delta = inf;
+            for(std::size_t j = 1; j <= m; ++j) {
+                if(used[j]) {
+                    continue;
+                }
+
+                cost_t current = cost[(i0 - 1) * m + (j - 1)] - u[i0] - v[j];
+                if(current < minv[j]) {
+                    minv[j] = current;
+                    way[j] = j0;
+                }
+                if(minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+
+            for(std::size_t j = 0; j <= m; ++j) {
+                if(used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while(p[j0] != 0);
+
+        do {
+            std::size_t j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while(j0 != 0);
+    }
+
+    std::vector<edge_t> ret;
+    for(std::size_t j = 1; j <= m; ++j) {
+        if(p[j] == 0) {
+            continue;
+        }
+
+        std::size_t cell = (p[j] - 1) * m + (j - 1);
+        if((best_edge[cell] == none) || !(cost[cell] < cost_t{})) {
+            continue;
+        }
+
+        std::size_t blue_v = rows[p[j] - 1], red_v = cols[j - 1];
+        if(swapped) {
+            std::swap(blue_v, red_v);
+        }
+        ret.push_back({internal2user_.at(blue_v), internal2user_.at(red_v), edge_data_[best_edge[cell]]});
+    }
+
+    return ret;
+}
+
+template<typename VT, typename ET>
+std::size_t kgraph_t<VT, ET>::internal_vertex(std::size_t v) const {
+    auto it = user2internal_.find(v);
+    if(it == user2internal_.end()) {
+        throw std::runtime_error("invalid vertex id");
+    }
+
+    return it->second;
+}
+
+template<typename VT, typename ET>
+std::vector<std::pair<std::size_t, ET>> kgraph_t<VT, ET>::shortest_paths(std::size_t source) const {
+    std::size_t start_v = internal_vertex(source);
+
+    std::vector<std::pair<std::size_t, ET>> ret;
+    std::vector<char> done(vertex_size_, 0);
+    pairing_heap_t<ET> heap(vertex_size_);
+    heap.push(start_v, ET{});
+
+    while(!heap.empty()) {
+        auto [current_vertex, current_dist] = heap.pop();
+        done[current_vertex] = 1;
+        ret.push_back({internal2user_.at(current_vertex), current_dist});
+
+        for(std::size_t current_edge = graph_[current_vertex].next; current_edge != current_vertex; current_edge = graph_[current_edge].next) {
+            const ET& weight = edge_data_[get_edge_id(current_edge)];
+            if(weight < ET{}) {
+                throw std::runtime_error("negative weight in shortest_paths");
+            }
+
+            std::size_t tmp_vertex = pair_incident_vertex(current_edge);
+            if(done[tmp_vertex]) {
+                continue;
+            }
+
+            ET tmp_dist = current_dist + weight;
+            if(!heap.contains(tmp_vertex)) {
+                heap.push(tmp_vertex, tmp_dist);
+            } else if(tmp_dist < heap.get_key(tmp_vertex)) {
+                heap.decrease_key(tmp_vertex, tmp_dist);
+            }
+        }
+    }
+
+    return ret;
+}
+
+template<typename VT, typename ET>
+void kgraph_t<VT, ET>::relax_edges(const std::size_t* first, const std::size_t* last, const std::vector<ET>& dist,
+                                   const std::vector<char>& reached, ET delta, bool light,
+                                   std::vector<std::pair<std::size_t, ET>>& requests) const {
+    requests.clear();
+    for(; first != last; ++first) {
+        std::size_t current_vertex = *first;
+        for(std::size_t current_edge = graph_[current_vertex].next; current_edge != current_vertex; current_edge = graph_[current_edge].next) {
+            const ET& weight = edge_data_[get_edge_id(current_edge)];
+            if((delta < weight) == light) {
+                continue;
+            }
+
+            std::size_t tmp_vertex = pair_incident_vertex(current_edge);
+            ET tmp_dist = dist[current_vertex] + weight;
+            if(!reached[tmp_vertex] || (tmp_dist < dist[tmp_vertex])) {
+                requests.push_back({tmp_vertex, tmp_dist});
+            }
+        }
+    }
+}
+
+template<typename VT, typename ET>
+std::vector<std::pair<std::size_t, ET>> kgraph_t<VT, ET>::shortest_paths_parallel(std::size_t source, ET delta, std::size_t threads_count) const {
+    static_assert(std::is_arithmetic_v<ET>, "delta-stepping requires arithmetic edge data");
+
+    if(!(ET{} < delta)) {
+        throw std::runtime_error("invalid delta in shortest_paths_parallel");
+    }
+    threads_count = std::max<std::size_t>(threads_count, 1u);
+    std::size_t start_v = internal_vertex(source);
+
+    ET max_weight{};
+    for(auto&& weight : edge_data_) {
+        if(weight < ET{}) {
+            throw std::runtime_error("negative weight in shortest_paths_parallel");
+        }
+        max_weight = std::max(max_weight, weight);
+    }
+
+    /*  tentative distances of queued vertices lie in [current * delta, (current + 1) * delta + max_weight),
+        so buckets can be reused cyclically */
+    const std::size_t buckets_count = static_cast<std::size_t>(max_weight / delta) + 2u;
+    auto bucket_idx = [delta](const ET& dist) {return static_cast<std::size_t>(dist / delta);};
+
+    std::vector<ET> dist(vertex_size_);
+    std::vector<char> reached(vertex_size_, 0);
+    std::vector<std::vector<std::size_t>> buckets(buckets_count);
+    std::size_t queued = 1u;
+
+    dist[start_v] = ET{};
+    reached[start_v] = 1;
+    buckets[0].push_back(start_v);
+
+    std::vector<std::vector<std::pair<std::size_t, ET>>> requests(threads_count);
+    auto relax = [&](const std::vector<std::size_t>& vertices, bool light) {
+        /* small frontiers aren't worth threads creation */
+        const std::size_t workers = (vertices.size() < 1024u) ? 1u : std::min(threads_count, vertices.size());
+        const std::size_t* data = vertices.data();
+        std::size_t size = vertices.size();
+
+        std::vector<std::thread> threads;
+        for(std::size_t i = 1; i < workers; ++i) {
+            threads.emplace_back([&, i]() {
+                relax_edges(data + size * i / workers, data + size * (i + 1) / workers, dist, reached, delta, light, requests[i]);
+            });
+        }
+        relax_edges(data, data + size / workers, dist, reached, delta, light, requests[0]);
+        for(auto&& thread : threads) {
+            thread.join();
+        }
+
+        /* requests are applied sequentially in thread order, so result doesn't depend on scheduling */
+        for(std::size_t i = 0; i < workers; ++i) {
+            for(auto&& [tmp_vertex, tmp_dist] : requests[i]) {
+                if(!reached[tmp_vertex] || (tmp_dist < dist[tmp_vertex])) {
+                    dist[tmp_vertex] = tmp_dist;
+                    reached[tmp_vertex] = 1;
+                    buckets[bucket_idx(tmp_dist) % buckets_count].push_back(tmp_vertex);
+                    ++queued;
+                }
+            }
+        }
+    };
+
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> marks(vertex_size_, none); /* last phase, where vertex was put into frontier */
+    std::vector<char> removed_marks(vertex_size_, 0);
+    std::vector<std::size_t> frontier, removed;
+    std::size_t phase = 0u;
+
+    for(std::size_t current = 0; queued != 0; ++current) {
+        std::vector<std::size_t>& bucket = buckets[current % buckets_count];
+        removed.clear();
+
+        while(!bucket.empty()) {
+            frontier.clear();
+            frontier.swap(bucket);
+            queued -= frontier.size();
+
+            /* drop outdated and repeated entries */
+            std::size_t last = 0u;
+            for(std::size_t i = 0, maxi = frontier.size(); i < maxi; ++i) {
+                std::size_t v = frontier[i];
+                if((bucket_idx(dist[v]) != current) || (marks[v] == phase)) {
+                    continue;
+                }
+
+                marks[v] = phase;
+                frontier[last++] = v;
+                if(!removed_marks[v]) {
+                    removed_marks[v] = 1;
+                    removed.push_back(v);
+                }
+            }
+            frontier.resize(last);
+            ++phase;
+
+            relax(frontier, true);
+        }
+
+        relax(removed, false);
+    }
+
+    std::vector<std::pair<std::size_t, ET>> ret;
+    for(std::size_t i = 0; i < vertex_size_; ++i) {
+        if(reached[i]) {
+            ret.push_back({internal2user_.at(i), dist[i]});
+        }
+    }
+
+    return ret;
+}
+
+template<typename VT, typename ET>
+std::vector<typename kgraph_t<VT, ET>::edge_t> kgraph_t<VT, ET>::minimum_spanning_tree() const {
+    std::vector<std::size_t> order(edge_data_.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return edge_data_[lhs] < edge_data_[rhs];
+    });
+
+    std::vector<std::size_t> essenses = get_first_essenses();
+
+    std::vector<edge_t> ret;
+    dsu_t dsu(vertex_size_);
+    for(auto&& id : order) {
+        std::size_t v1 = graph_[essenses[id]].incident_vertex;
+        std::size_t v2 = pair_incident_vertex(essenses[id]);
+        if(dsu.unite(v1, v2)) {
+            ret.push_back({internal2user_.at(v1), internal2user_.at(v2), edge_data_[id]});
+        }
+    }
+
+    return ret;
+}
+
+template<typename VT, typename ET>
+std::vector<typename kgraph_t<VT, ET>::edge_t> kgraph_t<VT, ET>::minimum_spanning_tree_boruvka(std::size_t threads_count /* = 1u */) const {
+    threads_count = std::max<std::size_t>(threads_count, 1u);
+    const std::size_t none = static_cast<std::size_t>(-1);
+
+    /* (weight, id) is a strict order, so cheapest edges never form a cycle */
+    auto less = [this](std::size_t lhs, std::size_t rhs) {
+        if(edge_data_[lhs] < edge_data_[rhs]) {return true;}
+        if(edge_data_[rhs] < edge_data_[lhs]) {return false;}
+        return lhs < rhs;
+    };
+
+    std::vector<std::size_t> essenses = get_first_essenses();
+
+    std::vector<edge_t> ret;
+    dsu_t dsu(vertex_size_);
+    std::vector<std::size_t> components(vertex_size_);
+    std::vector<std::vector<std::size_t>> cheapest(threads_count, std::vector<std::size_t>(vertex_size_));
+
+    /* every component finds its cheapest outgoing edge, edges are split between threads */
+    auto find_cheapest = [&](std::size_t thread_id) {
+        std::vector<std::size_t>& local = cheapest[thread_id];
+        std::fill(local.begin(), local.end(), none);
+
+        std::size_t size = essenses.size();
+        for(std::size_t id = size * thread_id / threads_count, maxid = size * (thread_id + 1) / threads_count; id < maxid; ++id) {
+            std::size_t c1 = components[graph_[essenses[id]].incident_vertex];
+            std::size_t c2 = components[pair_incident_vertex(essenses[id])];
+            if(c1 == c2) {
+                continue;
+            }
+
+            if((local[c1] == none) || less(id, local[c1])) {local[c1] = id;}
+            if((local[c2] == none) || less(id, local[c2])) {local[c2] = id;}
+        }
+    };
+
+    for(bool merged = true; merged;) {
+        for(std::size_t v = 0; v < vertex_size_; ++v) {
+            components[v] = dsu.find(v);
+        }
+
+        std::vector<std::thread> threads;
+        for(std::size_t i = 1; i < threads_count; ++i) {
+            threads.emplace_back(find_cheapest, i);
+        }
+        find_cheapest(0);
+        for(auto&& thread : threads) {
+            thread.join();
+        }
+
+        for(std::size_t i = 1; i < threads_count; ++i) {
+            for(std::size_t c = 0; c < vertex_size_; ++c) {
+                std::size_t id = cheapest[i][c];
+                if((id != none) && ((cheapest[0][c] == none) || less(id, cheapest[0][c]))) {
+                    cheapest[0][c] = id;
+                }
+            }
+        }
+
+        merged = false;
+        for(std::size_t c = 0; c < vertex_size_; ++c) {
+            std::size_t id = cheapest[0][c];
+            if(id == none) {
+                continue;
+            }
+
+            std::size_t v1 = graph_[essenses[id]].incident_vertex;
+            std::size_t v2 = pair_incident_vertex(essenses[id]);
+            if(dsu.unite(v1, v2)) {
+                ret.push_back({internal2user_.at(v1), internal2user_.at(v2), edge_data_[id]});
+                merged = true;
+            }
+        }
+    }
+
+    return ret;
 }
 
 template<typename VT, typename ET>
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+
+namespace kgraph {
+
+/*  addressable min pairing heap, elements are ids from [0, capacity)
+    push, decrease_key - O(1), pop - O(log n) amortized */
+template<typename KT>
+class pairing_heap_t final {
+public:
+    explicit pairing_heap_t(std::size_t capacity) : nodes_(capacity), root_(none_) {}
+
+    bool empty() const {return root_ == none_;}
+    bool contains(std::size_t id) const {return nodes_[id].in_heap;}
+    const KT& get_key(std::size_t id) const {return nodes_[id].key;}
+
+    void push(std::size_t id, const KT& key);
+    /* key must be not greater, than current key of id */
+    void decrease_key(std::size_t id, const KT& key);
+
+    /* return id and key of minimal element */
+    std::pair<std::size_t, KT> pop();
+
+private:
+    std::size_t meld(std::size_t lhs, std::size_t rhs);
+    /* two pass merge of siblings list */
+    std::size_t merge_pairs(std::size_t first);
+
+private:
+    static constexpr std::size_t none_ = static_cast<std::size_t>(-1);
+
+    struct node_t {
+        KT key;
+        std::size_t child = none_;
+        std::size_t sibling = none_;
+        std::size_t prev = none_; /* parent for leftmost child, left sibling for others */
+        bool in_heap = false;
+    };
+    std::vector<node_t> nodes_;
+    std::size_t root_;
+
+    /* buffer for merge_pairs, to avoid allocation in every pop */
+    std::vector<std::size_t> pairs_;
+};
+
+template<typename KT>
+void pairing_heap_t<KT>::push(std::size_t id, const KT& key) {
+    if(nodes_[id].in_heap) {
+        throw std::runtime_error("pairing_heap_t::push: element already in heap");
+    }
+
+    nodes_[id] = {key, none_, none_, none_, true};
+    root_ = (root_ == none_) ? id : meld(root_, id);
+}
+
+template<typename KT>
+void pairing_heap_t<KT>::decrease_key(std::size_t id, const KT& key) {
+    node_t& node = nodes_[id];
+    node.key = key;
+    if(id == root_) {
+        return;
+    }
+
+    /* cut subtree from its parent and meld it with root */
+    node_t& prev = nodes_[node.prev];
+    if(prev.child == id) {
+        prev.child = node.sibling;
+    } else {
+        prev.sibling = node.sibling;
+    }
+
+    if(node.sibling != none_) {
+        nodes_[node.sibling].prev = node.prev;
+    }
+
+    node.sibling = node.prev = none_;
+    root_ = meld(root_, id);
+}
+
+template<typename KT>
+std::pair<std::size_t, KT> pairing_heap_t<KT>::pop() {
+    if(empty()) {
+        throw std::runtime_error("pairing_heap_t::pop: heap is empty");
+    }
+
+    std::size_t ret = root_;
+    nodes_[ret].in_heap = false;
+    root_ = merge_pairs(nodes_[ret].child);
+
+    return {ret, nodes_[ret].key};
+}
+
+template<typename KT>
+std::size_t pairing_heap_t<KT>::meld(std::size_t lhs, std::size_t rhs) {
+    if(nodes_[rhs].key < nodes_[lhs].key) {
+        std::swap(lhs, rhs);
+    }
+
+    /* rhs becomes leftmost child of lhs */
+    node_t& parent = nodes_[lhs];
+    node_t& child = nodes_[rhs];
+
+    child.sibling = parent.child;
+    if(parent.child != none_) {
+        nodes_[parent.child].prev = rhs;
+    }
+    child.prev = lhs;
+    parent.child = rhs;
+
+    return lhs;
+}
+
+template<typename KT>
+std::size_t pairing_heap_t<KT>::merge_pairs(std::size_t first) {
+    if(first == none_) {
+        return none_;
+    }
+
+    pairs_.clear();
+    while(first != none_) {
+        std::size_t second = nodes_[first].sibling;
+        std::size_t next = (second == none_) ? none_ : nodes_[second].sibling;
+
+        nodes_[first].sibling = nodes_[first].prev = none_;
+        if(second != none_) {
+            nodes_[second].sibling = nodes_[second].prev = none_;
+            pairs_.push_back(meld(first, second));
+        } else {
+            pairs_.push_back(first);
+        }
+
+        first = next;
+    }
+
+    std::size_t ret = pairs_.back();
+    for(std::size_t i = pairs_.size() - 1; i > 0; --i) {
+        ret = meld(pairs_[i - 1], ret);
+    }
+
+    return ret;
+}
+
+} /* namespace kgraph */
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <string>
+#include <fstream>
+#include <functional>
+
+#include "../kgraph.hpp"
+#include "generator.hpp"
+
+/*  ingestion and coloring benchmark of kgraph_t, prints csv
+    usage: ./benchmark.out [max edges count] [output file] [threads count]
+    edges count goes from 10^4 up to max edges count (100M is supported) with step x10 */
+
+using graph_t = kgraph::kgraph_t<std::size_t, std::size_t>;
+using generator_func_t = std::function<void(edge_generator_t&, std::size_t, graph_t&)>;
+
+/* return value of field from /proc/self/status in megabytes */
+double get_memory_mb(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line)) {
+        if(line.compare(0, field.size(), field) == 0) {
+            return std::stod(line.substr(field.size() + 1)) / 1024.0;
+        }
+    }
+
+    return 0.0;
+}
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+void run_benchmark(std::ostream& out, const std::string& name, std::size_t edges_count, const generator_func_t& generate, std::size_t threads_count) {
+    edge_generator_t generator;
+
+    graph_t graph;
+    double push_time = measure([&]() {generate(generator, edges_count, graph);});
+
+    std::optional<std::vector<std::size_t>> odd_cycle;
+    double color_time = measure([&]() {odd_cycle = graph.fill_bipartite_color(0u, kgraph::color_t::blue);});
+    graph.reset_color();
+    double parallel_color_time = measure([&]() {graph.fill_bipartite_color_parallel(0u, kgraph::color_t::blue, threads_count);});
+
+    graph_t::components_t components;
+    double components_time = measure([&]() {components = graph.get_components(threads_count);});
+    double propagation_time = measure([&]() {graph.get_components_propagation(threads_count);});
+
+    out << name << "," << graph.get_vertex_number() << "," << graph.get_edge_number() << ","
+        << push_time << "," << color_time << "," << parallel_color_time << ","
+        << components.sizes.size() << "," << components_time << "," << propagation_time << "," << (odd_cycle.has_value() ? 0 : 1) << ","
+        << graph.is_bipartite() << "," << graph.get_memory_usage() / (1024.0 * 1024.0) << "," << get_memory_mb("VmHWM:") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_edges_count = (argc > 1) ? std::stoull(argv[1]) : 1000000u;
+
+    std::ofstream file;
+    if(argc > 2) {
+        file.open(argv[2]);
+    }
+    std::ostream& out = (argc > 2) ? file : std::cout;
+    std::size_t threads_count = (argc > 3) ? std::stoull(argv[3]) : std::max(std::thread::hardware_concurrency(), 1u);
+
+    /* vertex 0 always exists, it's start of coloring */
+    std::vector<std::pair<std::string, generator_func_t>> generators = {
+        {"erdos_renyi", [](edge_generator_t& gen, std::size_t edges_count, graph_t& graph) {
+            graph.push_edge(0u, 1u);
+            gen.erdos_renyi(edges_count / 4u + 2u, edges_count - 1u, [&](std::size_t v1, std::size_t v2, std::size_t w) {graph.push_edge(v1, v2, w);});
+        }},
+        {"planted_odd_cycle", [](edge_generator_t& gen, std::size_t edges_count, graph_t& graph) {
+            graph.push_edge(0u, 1u);
+            gen.planted_odd_cycle(edges_count / 4u + 2u, edges_count - 1u, 101u, [&](std::size_t v1, std::size_t v2, std::size_t w) {graph.push_edge(v1, v2, w);});
+        }},
+        {"grid", [](edge_generator_t& gen, std::size_t edges_count, graph_t& graph) {
+            std::size_t side = static_cast<std::size_t>(std::sqrt(edges_count / 2.0)) + 1u;
+            gen.grid(side, side, [&](std::size_t v1, std::size_t v2, std::size_t w) {graph.push_edge(v1, v2, w);});
+        }},
+        {"power_law", [](edge_generator_t& gen, std::size_t edges_count, graph_t& graph) {
+            graph.push_edge(0u, 1u);
+            gen.power_law(edges_count / 4u + 2u, edges_count - 1u, 2.5, [&](std::size_t v1, std::size_t v2, std::size_t w) {graph.push_edge(v1, v2, w);});
+        }},
+    };
+
+    try {
+        out << "generator,vertices,edges,ingestion_s,coloring_s,parallel_coloring_s,components,union_find_s,propagation_s,bipartite,incremental_bipartite,graph_mb,peak_rss_mb" << std::endl;
+        for(std::size_t edges_count = 10000u; edges_count <= max_edges_count; edges_count *= 10u) {
+            for(auto&& [name, generate] : generators) {
+                run_benchmark(out, name, edges_count, generate, threads_count);
+            }
+        }
+    } catch(std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
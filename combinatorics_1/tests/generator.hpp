@@ -0,0 +1,104 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+/*  graph generators for benchmarks
+    edges are not stored, every generated edge is passed to push(v1, v2, weight),
+    so graphs with 100M edges can be generated straight into kgraph_t */
+
+class edge_generator_t {
+public:
+    explicit edge_generator_t(std::size_t seed = 42u, std::size_t max_weight = 1000u) :
+        gen_(seed), dis_weight_(1u, max_weight) {}
+
+    /* erdos-renyi G(n, m): m uniform random edges between n vertices */
+    template<typename F>
+    void erdos_renyi(std::size_t vertex_count, std::size_t edges_count, F push);
+
+    /*  random bipartite graph (even vertices - one part, odd - another),
+        if odd_cycle_len != 0, cycle of this odd len is planted into it */
+    template<typename F>
+    void planted_odd_cycle(std::size_t vertex_count, std::size_t edges_count, std::size_t odd_cycle_len, F push);
+
+    /* rows * cols grid, every vertex is connected with right and bottom neighbours */
+    template<typename F>
+    void grid(std::size_t rows, std::size_t cols, F push);
+
+    /*  chung-lu graph with power law degree distribution: P(deg = k) ~ k^(-exponent),
+        endpoints are chosen with probability proportional to expected degree */
+    template<typename F>
+    void power_law(std::size_t vertex_count, std::size_t edges_count, double exponent, F push);
+
+private:
+    std::size_t random_vertex(std::size_t vertex_count) {
+        return std::uniform_int_distribution<std::size_t>(0u, vertex_count - 1)(gen_);
+    }
+
+private:
+    std::mt19937_64 gen_;
+    std::uniform_int_distribution<std::size_t> dis_weight_;
+};
+
+template<typename F>
+void edge_generator_t::erdos_renyi(std::size_t vertex_count, std::size_t edges_count, F push) {
+    for(std::size_t i = 0; i < edges_count; ++i) {
+        push(random_vertex(vertex_count), random_vertex(vertex_count), dis_weight_(gen_));
+    }
+}
+
+template<typename F>
+void edge_generator_t::planted_odd_cycle(std::size_t vertex_count, std::size_t edges_count, std::size_t odd_cycle_len, F push) {
+    std::size_t half = std::max<std::size_t>(vertex_count / 2u, 1u);
+    std::size_t cycle_edges = (odd_cycle_len % 2u) ? odd_cycle_len : 0u;
+
+    for(std::size_t i = 0; i + cycle_edges < edges_count; ++i) {
+        push(2u * random_vertex(half), 2u * random_vertex(half) + 1u, dis_weight_(gen_));
+    }
+
+    /* path of even len through alternating parts and one edge inside the part closes it */
+    if(cycle_edges) {
+        std::size_t first = 2u * random_vertex(half);
+        std::size_t v = first;
+        for(std::size_t i = 1; i < cycle_edges; ++i) {
+            std::size_t u = 2u * random_vertex(half) + ((i % 2u) ? 1u : 0u);
+            push(v, u, dis_weight_(gen_));
+            v = u;
+        }
+        push(v, first, dis_weight_(gen_));
+    }
+}
+
+template<typename F>
+void edge_generator_t::grid(std::size_t rows, std::size_t cols, F push) {
+    for(std::size_t i = 0; i < rows; ++i) {
+        for(std::size_t j = 0; j < cols; ++j) {
+            std::size_t v = i * cols + j;
+            if(j + 1 < cols) {push(v, v + 1, dis_weight_(gen_));}
+            if(i + 1 < rows) {push(v, v + cols, dis_weight_(gen_));}
+        }
+    }
+}
+
+template<typename F>
+void edge_generator_t::power_law(std::size_t vertex_count, std::size_t edges_count, double exponent, F push) {
+    /* expected degree of i-th vertex ~ (i + 1)^(-1 / (exponent - 1)) */
+    std::vector<double> cumulative(vertex_count);
+    double sum = 0.0;
+    for(std::size_t i = 0; i < vertex_count; ++i) {
+        sum += std::pow(static_cast<double>(i + 1), -1.0 / (exponent - 1.0));
+        cumulative[i] = sum;
+    }
+
+    std::uniform_real_distribution<double> dis(0.0, sum);
+    auto sample = [&]() -> std::size_t {
+        std::size_t v = std::upper_bound(cumulative.begin(), cumulative.end(), dis(gen_)) - cumulative.begin();
+        return std::min(v, vertex_count - 1);
+    };
+
+    for(std::size_t i = 0; i < edges_count; ++i) {
+        push(sample(), sample(), dis_weight_(gen_));
+    }
+}
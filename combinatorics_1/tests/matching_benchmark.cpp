@@ -0,0 +1,69 @@
+#include <random>
+#include <chrono>
+#include <string>
+
+#include "../kgraph.hpp"
+
+/*  benchmark of bipartite matching
+    usage: ./matching_benchmark.out [edges count] [vertices count for weighted matching] */
+
+using graph_t = kgraph::kgraph_t<std::size_t, std::size_t>;
+
+/* random bipartite graph: blue vertices are even, red are odd */
+graph_t generate_bipartite_graph(std::size_t edges_count, std::size_t vertex_count, std::mt19937& gen) {
+    std::uniform_int_distribution<std::size_t> dis_vertex(0u, std::max<std::size_t>(vertex_count / 2u, 1u) - 1);
+    std::uniform_int_distribution<std::size_t> dis_weight(1u, 1000u);
+
+    graph_t graph;
+    for(std::size_t i = 0; i < edges_count; ++i) {
+        graph.push_edge(2u * dis_vertex(gen), 2u * dis_vertex(gen) + 1u, dis_weight(gen));
+    }
+
+    return graph;
+}
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t edges_count = (argc > 1) ? std::stoull(argv[1]) : 4000000u;
+    std::size_t weighted_vertex_count = (argc > 2) ? std::stoull(argv[2]) : 2000u;
+
+    std::mt19937 gen(42);
+
+    try {
+        graph_t graph = generate_bipartite_graph(edges_count, edges_count / 4u, gen);
+        double color_time = measure([&]() {graph.fill_bipartite_color(0u, kgraph::color_t::blue);});
+
+        std::vector<std::pair<std::size_t, std::size_t>> matching;
+        double csr_time = measure([&]() {graph.get_csr();});
+        double matching_time = measure([&]() {matching = graph.max_bipartite_matching();});
+
+        std::cout << "hopcroft-karp: V = " << graph.get_vertex_number() << ", E = " << graph.get_edge_number() << std::endl;
+        std::cout << "    coloring:  " << color_time << " s" << std::endl;
+        std::cout << "    csr:       " << csr_time << " s" << std::endl;
+        std::cout << "    matching:  " << matching_time << " s, size = " << matching.size() << std::endl;
+
+        graph_t weighted = generate_bipartite_graph(weighted_vertex_count * 8u, weighted_vertex_count, gen);
+        weighted.fill_bipartite_color(0u, kgraph::color_t::blue);
+
+        std::vector<graph_t::edge_t> weighted_matching;
+        double weighted_time = measure([&]() {weighted_matching = weighted.max_weight_bipartite_matching();});
+
+        std::size_t weight = 0u;
+        for(auto&& edge : weighted_matching) {
+            weight += edge.data;
+        }
+
+        std::cout << "hungarian: V = " << weighted.get_vertex_number() << ", E = " << weighted.get_edge_number() << std::endl;
+        std::cout << "    matching:  " << weighted_time << " s, size = " << weighted_matching.size() << ", weight = " << weight << std::endl;
+    } catch(std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,4 +1,7 @@
 #include <random>
+#include <limits>
+#include <numeric>
+#include <algorithm>
 
 #include "../kgraph.hpp"
 
@@ -10,6 +13,9 @@ public:
     kgraph::kgraph_t<VT, ET> generate_bipartite_graph();
     kgraph::kgraph_t<VT, ET> generate_unbipartite_graph();
     kgraph::kgraph_t<VT, ET> generate_odd_loop();
+
+    /* small weighted graph with vertices from 0 to vertex_count - 1, loops and multiple edges are possible */
+    std::vector<typename kgraph::kgraph_t<VT, ET>::edge_t> generate_weighted_edges(std::size_t vertex_count, std::size_t edges_count);
 private:
     std::random_device rd_;
     std::mt19937 gen_;
@@ -60,6 +66,147 @@ kgraph::kgraph_t<VT, ET> graph_generator_t<VT, ET>::generate_odd_loop() {
     return ret;
 }
 
+template<typename VT, typename ET>
+std::vector<typename kgraph::kgraph_t<VT, ET>::edge_t> graph_generator_t<VT, ET>::generate_weighted_edges(std::size_t vertex_count, std::size_t edges_count) {
+    std::uniform_int_distribution<std::size_t> dis_vertex(0u, vertex_count - 1);
+    std::uniform_int_distribution<std::size_t> dis_weight(0u, 20u);
+
+    std::vector<typename kgraph::kgraph_t<VT, ET>::edge_t> ret;
+    for(std::size_t i = 0; i < edges_count; ++i) {
+        ret.push_back({dis_vertex(gen_), dis_vertex(gen_), static_cast<ET>(dis_weight(gen_))});
+    }
+
+    return ret;
+}
+
+using graph_t = kgraph::kgraph_t<std::size_t, std::size_t>;
+using edges_t = std::vector<graph_t::edge_t>;
+
+graph_t make_graph(const edges_t& edges) {
+    graph_t ret;
+    for(auto&& edge : edges) {
+        ret.push_edge(edge.v1, edge.v2, edge.data);
+    }
+
+    return ret;
+}
+
+/* distance of every vertex, max for unreachable ones */
+std::vector<std::size_t> bellman_ford(const edges_t& edges, std::size_t vertex_count, std::size_t source) {
+    const std::size_t inf = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> ret(vertex_count, inf);
+    ret[source] = 0u;
+
+    for(std::size_t i = 1; i < vertex_count; ++i) {
+        for(auto&& edge : edges) {
+            if(ret[edge.v1] != inf) {ret[edge.v2] = std::min(ret[edge.v2], ret[edge.v1] + edge.data);}
+            if(ret[edge.v2] != inf) {ret[edge.v1] = std::min(ret[edge.v1], ret[edge.v2] + edge.data);}
+        }
+    }
+
+    return ret;
+}
+
+std::vector<std::size_t> distances(const std::vector<std::pair<std::size_t, std::size_t>>& paths, std::size_t vertex_count) {
+    std::vector<std::size_t> ret(vertex_count, std::numeric_limits<std::size_t>::max());
+    for(auto&& [v, dist] : paths) {
+        ret[v] = dist;
+    }
+
+    return ret;
+}
+
+/* weight of minimum spanning forest, all acyclic subsets of edges with max size are checked */
+std::size_t brute_force_forest_weight(const edges_t& edges, std::size_t vertex_count) {
+    std::size_t best_size = 0u, best_weight = 0u;
+    for(std::size_t mask = 0; mask < (std::size_t{1} << edges.size()); ++mask) {
+        std::vector<std::size_t> parents(vertex_count);
+        std::iota(parents.begin(), parents.end(), 0u);
+        auto find = [&parents](std::size_t v) {
+            while(parents[v] != v) {v = parents[v];}
+            return v;
+        };
+
+        bool acyclic = true;
+        std::size_t size = 0u, weight = 0u;
+        for(std::size_t i = 0; (i < edges.size()) && acyclic; ++i) {
+            if(((mask >> i) & 1u) == 0) {
+                continue;
+            }
+
+            std::size_t root1 = find(edges[i].v1), root2 = find(edges[i].v2);
+            acyclic = (root1 != root2);
+            parents[root1] = root2;
+            ++size;
+            weight += edges[i].data;
+        }
+
+        if(acyclic && ((size > best_size) || ((size == best_size) && (weight < best_weight)))) {
+            best_size = size;
+            best_weight = weight;
+        }
+    }
+
+    return best_weight;
+}
+
+std::size_t total_weight(const edges_t& edges) {
+    std::size_t ret = 0u;
+    for(auto&& edge : edges) {
+        ret += edge.data;
+    }
+
+    return ret;
+}
+
+/* max size and max weight of matching, all subsets of edges are checked */
+std::pair<std::size_t, std::size_t> brute_force_matching(const edges_t& edges, std::size_t vertex_count) {
+    std::size_t best_size = 0u, best_weight = 0u;
+    for(std::size_t mask = 0; mask < (std::size_t{1} << edges.size()); ++mask) {
+        std::vector<char> used(vertex_count, 0);
+        bool matching = true;
+        std::size_t size = 0u, weight = 0u;
+        for(std::size_t i = 0; (i < edges.size()) && matching; ++i) {
+            if(((mask >> i) & 1u) == 0) {
+                continue;
+            }
+
+            matching = !used[edges[i].v1] && !used[edges[i].v2];
+            used[edges[i].v1] = used[edges[i].v2] = 1;
+            ++size;
+            weight += edges[i].data;
+        }
+
+        if(matching) {
+            best_size = std::max(best_size, size);
+            best_weight = std::max(best_weight, weight);
+        }
+    }
+
+    return {best_size, best_weight};
+}
+
+/* every edge of matching is edge of graph, vertices aren't repeated */
+bool is_matching(const edges_t& matching, const edges_t& edges, std::size_t vertex_count) {
+    std::vector<char> used(vertex_count, 0);
+    for(auto&& edge : matching) {
+        if(used[edge.v1] || used[edge.v2]) {
+            return false;
+        }
+        used[edge.v1] = used[edge.v2] = 1;
+
+        auto it = std::find_if(edges.begin(), edges.end(), [&edge](const graph_t::edge_t& tmp) {
+            return (tmp.data == edge.data) && (((tmp.v1 == edge.v1) && (tmp.v2 == edge.v2)) || ((tmp.v1 == edge.v2) && (tmp.v2 == edge.v1)));
+        });
+
+        if(it == edges.end()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     graph_generator_t<std::size_t, std::size_t> gen;
 
@@ -82,6 +229,130 @@ int main() {
             std::cout << "generate_odd_loop TEST: SUCCESS" << std::endl;
         }
 
+        if(!graph1.is_bipartite() || graph1.get_odd_cycle().has_value()) {
+            std::cout << "incremental bipartite TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "incremental bipartite TEST: SUCCESS" << std::endl;
+        }
+
+        auto&& witness = graph2.get_odd_cycle();
+        if(graph2.is_bipartite() || !witness.has_value() || ((witness.value().size() % 2) == 0)) {
+            std::cout << "incremental odd cycle TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "incremental odd cycle TEST: SUCCESS" << std::endl;
+        }
+
+        auto&& components = graph1.get_components(4u);
+        auto&& propagation = graph1.get_components_propagation(4u);
+        std::size_t components_size = 0u;
+        for(auto&& size : components.sizes) {components_size += size;}
+
+        if((components.labels != propagation.labels) || (components.sizes != propagation.sizes) ||
+           (components_size != graph1.get_vertex_number())) {
+            std::cout << "connected components TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "connected components TEST: SUCCESS" << std::endl;
+        }
+
+        /* fresh identical graphs, colors and odd cycle must be the same as sequential ones */
+        bool parallel_success = true;
+        for(auto&& graph : {gen.generate_bipartite_graph(), gen.generate_odd_loop()}) {
+            auto sequential = graph;
+            auto parallel = graph;
+
+            auto&& sequential_cycle = sequential.fill_bipartite_color(1, kgraph::color_t::blue);
+            auto&& parallel_cycle = parallel.fill_bipartite_color_parallel(1, kgraph::color_t::blue, 4u);
+            if((sequential_cycle != parallel_cycle) || (sequential.get_color() != parallel.get_color())) {
+                parallel_success = false;
+            }
+        }
+
+        if(!parallel_success) {
+            std::cout << "parallel coloring TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "parallel coloring TEST: SUCCESS" << std::endl;
+        }
+
+        bool paths_success = true, tree_success = true;
+        for(std::size_t i = 0; i < 200u; ++i) {
+            const std::size_t vertex_count = 7u;
+            edges_t edges = gen.generate_weighted_edges(vertex_count, 12u);
+            graph_t graph = make_graph(edges);
+
+            std::size_t source = edges[0].v1;
+            std::vector<std::size_t> expected = bellman_ford(edges, vertex_count, source);
+            if((distances(graph.shortest_paths(source), vertex_count) != expected) ||
+               (distances(graph.shortest_paths_parallel(source, 3u, 4u), vertex_count) != expected)) {
+                paths_success = false;
+            }
+
+            std::size_t forest_weight = brute_force_forest_weight(edges, vertex_count);
+            if((total_weight(graph.minimum_spanning_tree()) != forest_weight) ||
+               (total_weight(graph.minimum_spanning_tree_boruvka(4u)) != forest_weight)) {
+                tree_success = false;
+            }
+        }
+
+        if(!paths_success) {
+            std::cout << "shortest paths TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "shortest paths TEST: SUCCESS" << std::endl;
+        }
+
+        if(!tree_success) {
+            std::cout << "minimum spanning tree TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "minimum spanning tree TEST: SUCCESS" << std::endl;
+        }
+
+        bool matching_success = true, weighted_matching_success = true;
+        for(std::size_t i = 0; i < 200u; ++i) {
+            /* blue vertices are even, red are odd */
+            const std::size_t vertex_count = 10u;
+            edges_t edges = gen.generate_weighted_edges(vertex_count / 2u, 12u);
+            for(auto&& edge : edges) {
+                edge.v1 = 2u * edge.v1;
+                edge.v2 = 2u * edge.v2 + 1u;
+            }
+
+            graph_t graph = make_graph(edges);
+            graph.fill_bipartite_color(edges[0].v1, kgraph::color_t::blue);
+            auto [max_size, max_weight] = brute_force_matching(edges, vertex_count);
+
+            /* matching of maximum cardinality may use any of multiple edges, so weight is the max one */
+            edges_t matching;
+            for(auto&& [v1, v2] : graph.max_bipartite_matching()) {
+                std::size_t weight = 0u;
+                for(auto&& edge : edges) {
+                    if(((edge.v1 == v1) && (edge.v2 == v2)) || ((edge.v1 == v2) && (edge.v2 == v1))) {
+                        weight = std::max(weight, edge.data);
+                    }
+                }
+                matching.push_back({v1, v2, weight});
+            }
+
+            if((matching.size() != max_size) || !is_matching(matching, edges, vertex_count)) {
+                matching_success = false;
+            }
+
+            edges_t weighted_matching = graph.max_weight_bipartite_matching();
+            if((total_weight(weighted_matching) != max_weight) || !is_matching(weighted_matching, edges, vertex_count)) {
+                weighted_matching_success = false;
+            }
+        }
+
+        if(!matching_success) {
+            std::cout << "bipartite matching TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "bipartite matching TEST: SUCCESS" << std::endl;
+        }
+
+        if(!weighted_matching_success) {
+            std::cout << "weighted bipartite matching TEST: FAILED" << std::endl;
+        } else {
+            std::cout << "weighted bipartite matching TEST: SUCCESS" << std::endl;
+        }
+
     } catch(std::exception& ex) {
         std::cerr << ex.what() << std::endl;
         return 1;
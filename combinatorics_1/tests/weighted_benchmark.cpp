@@ -0,0 +1,108 @@
+#include <random>
+#include <chrono>
+#include <string>
+#include <cmath>
+
+#include "../kgraph.hpp"
+
+/*  benchmark of weighted algorithms
+    usage: ./weighted_benchmark.out [edges count] [threads count] */
+
+struct edge_t {
+    std::size_t v1, v2, w;
+};
+
+/* uniform random graph with E edges and E / 4 vertices */
+std::vector<edge_t> generate_random_graph(std::size_t edges_count, std::mt19937& gen) {
+    std::size_t vertex_count = std::max<std::size_t>(edges_count / 4u, 2u);
+    std::uniform_int_distribution<std::size_t> dis_vertex(0u, vertex_count - 1);
+    std::uniform_int_distribution<std::size_t> dis_weight(1u, 1000u);
+
+    std::vector<edge_t> edges;
+    edges.reserve(edges_count);
+    for(std::size_t i = 0; i < edges_count; ++i) {
+        edges.push_back({dis_vertex(gen), dis_vertex(gen), dis_weight(gen)});
+    }
+
+    return edges;
+}
+
+/* road network like graph: grid with local weights and rare long highways */
+std::vector<edge_t> generate_road_graph(std::size_t edges_count, std::mt19937& gen) {
+    std::size_t side = std::max<std::size_t>(static_cast<std::size_t>(std::sqrt(edges_count / 2.0)), 2u);
+    std::uniform_int_distribution<std::size_t> dis_weight(10u, 100u);
+    std::uniform_int_distribution<std::size_t> dis_vertex(0u, side * side - 1);
+    std::uniform_int_distribution<std::size_t> dis_highway(0u, 99u);
+
+    std::vector<edge_t> edges;
+    edges.reserve(edges_count);
+    for(std::size_t i = 0; (i < side) && (edges.size() < edges_count); ++i) {
+        for(std::size_t j = 0; (j < side) && (edges.size() < edges_count); ++j) {
+            std::size_t v = i * side + j;
+            if(j + 1 < side) {edges.push_back({v, v + 1, dis_weight(gen)});}
+            if(i + 1 < side) {edges.push_back({v, v + side, dis_weight(gen)});}
+
+            if(dis_highway(gen) == 0u) {
+                edges.push_back({v, dis_vertex(gen), 50u * dis_weight(gen)});
+            }
+        }
+    }
+
+    return edges;
+}
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+void run_benchmark(const std::string& name, const std::vector<edge_t>& edges, std::size_t threads_count) {
+    kgraph::kgraph_t<std::size_t, std::size_t> graph;
+
+    double push_time = measure([&]() {
+        for(auto&& edge : edges) {
+            graph.push_edge(edge.v1, edge.v2, edge.w);
+        }
+    });
+
+    std::vector<std::pair<std::size_t, std::size_t>> dijkstra, delta_stepping;
+    double dijkstra_time = measure([&]() {dijkstra = graph.shortest_paths(edges[0].v1);});
+    double delta_time = measure([&]() {delta_stepping = graph.shortest_paths_parallel(edges[0].v1, 100u, threads_count);});
+
+    std::vector<kgraph::kgraph_t<std::size_t, std::size_t>::edge_t> kruskal, boruvka;
+    double kruskal_time = measure([&]() {kruskal = graph.minimum_spanning_tree();});
+    double boruvka_time = measure([&]() {boruvka = graph.minimum_spanning_tree_boruvka(threads_count);});
+
+    std::sort(dijkstra.begin(), dijkstra.end());
+    std::sort(delta_stepping.begin(), delta_stepping.end());
+    std::size_t kruskal_weight = 0u, boruvka_weight = 0u;
+    for(auto&& edge : kruskal) {kruskal_weight += edge.data;}
+    for(auto&& edge : boruvka) {boruvka_weight += edge.data;}
+
+    std::cout << name << ": V = " << graph.get_vertex_number() << ", E = " << graph.get_edge_number() << std::endl;
+    std::cout << "    push_edge:       " << push_time << " s" << std::endl;
+    std::cout << "    dijkstra:        " << dijkstra_time << " s" << std::endl;
+    std::cout << "    delta-stepping:  " << delta_time << " s (" << threads_count << " threads) "
+              << ((dijkstra == delta_stepping) ? "SUCCESS" : "FAILED") << std::endl;
+    std::cout << "    kruskal:         " << kruskal_time << " s" << std::endl;
+    std::cout << "    boruvka:         " << boruvka_time << " s (" << threads_count << " threads) "
+              << ((kruskal_weight == boruvka_weight) ? "SUCCESS" : "FAILED") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t edges_count = (argc > 1) ? std::stoull(argv[1]) : 1000000u;
+    std::size_t threads_count = (argc > 2) ? std::stoull(argv[2]) : std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::mt19937 gen(42);
+
+    try {
+        run_benchmark("random", generate_random_graph(edges_count, gen), threads_count);
+        run_benchmark("road", generate_road_graph(edges_count, gen), threads_count);
+    } catch(std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
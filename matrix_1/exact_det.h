@@ -0,0 +1,347 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <optional>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+namespace matrix {
+
+/*
+    ***exact determinant of integer matrix***
+
+    function contract:
+
+        1) a: n * n, row major, lda - distance between rows (in elements)
+        2) T - integral type, result must fit in T, otherwise std::runtime_error is thrown
+
+    small matrices go through bareiss fraction-free elimination (every intermediate value
+    is a minor of the matrix, so division is exact), big ones or ones which overflow
+    128 bits in bareiss - through modular method: det mod p for several 31-bit primes
+    in parallel and chinese remainder reconstruction
+*/
+template<typename T>
+T exact_det(const T* a, std::size_t n, std::size_t lda, std::size_t threads_count = std::thread::hardware_concurrency());
+
+/* bareiss elimination in __int128, std::nullopt if intermediate value overflows */
+template<typename T>
+std::optional<T> bareiss_det(const T* a, std::size_t n, std::size_t lda);
+
+/*  number of primes is taken from hadamard bound, but no more than needed to cover range of T
+    plus two check primes: if det doesn't fit in T, it is detected with probability ~ 1 - 2^-60 */
+template<typename T>
+T modular_det(const T* a, std::size_t n, std::size_t lda, std::size_t threads_count = std::thread::hardware_concurrency());
+
+namespace detail {
+
+using int128_t = __int128;
+using uint128_t = unsigned __int128;
+
+/* bareiss does O(n^3) 128-bit divisions, modular method is faster since this size */
+constexpr std::size_t bareiss_max_size = 16u;
+
+constexpr std::uint64_t max_det_prime = (1ull << 31) - 1u;
+
+inline std::uint64_t pow_mod(std::uint64_t base, std::uint64_t exp, std::uint64_t p) {
+    std::uint64_t ret = 1u;
+    for(base %= p; exp; exp >>= 1, base = base * base % p) {
+        if(exp & 1u) {
+            ret = ret * base % p;
+        }
+    }
+
+    return ret;
+}
+
+/* deterministic miller-rabin, bases 2, 7, 61 are enough for numbers < 4759123141 */
+inline bool is_prime(std::uint64_t x) {
+    if(x < 2u) {
+        return false;
+    }
+
+    for(std::uint64_t p : {2u, 3u, 5u, 7u, 61u}) {
+        if(x % p == 0u) {
+            return x == p;
+        }
+    }
+
+    std::uint64_t d = x - 1u;
+    std::size_t s = 0;
+    for(; (d & 1u) == 0u; d >>= 1, ++s) {}
+
+    for(std::uint64_t base : {2u, 7u, 61u}) {
+        std::uint64_t y = pow_mod(base, d, x);
+        if((y == 1u) || (y == x - 1u)) {
+            continue;
+        }
+
+        std::size_t i = 1;
+        for(; (i < s) && (y != x - 1u); ++i) {
+            y = y * y % x;
+        }
+
+        if(y != x - 1u) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* primes going down from 2^31 with sum of log2 more than bits */
+inline std::vector<std::uint64_t> get_det_primes(long double bits) {
+    std::vector<std::uint64_t> primes;
+    long double covered = 0.0L;
+    for(std::uint64_t p = max_det_prime; covered <= bits; p -= 2u) {
+        if(is_prime(p)) {
+            primes.push_back(p);
+            covered += std::log2(static_cast<long double>(p));
+        }
+    }
+
+    return primes;
+}
+
+template<typename T>
+std::uint64_t reduce_mod(T x, std::uint64_t p) {
+    if constexpr (std::is_signed_v<T>) {
+        long long r = static_cast<long long>(static_cast<int128_t>(x) % static_cast<int128_t>(p));
+        return static_cast<std::uint64_t>(r < 0 ? r + static_cast<long long>(p) : r);
+    } else {
+        return static_cast<std::uint64_t>(static_cast<uint128_t>(x) % p);
+    }
+}
+
+/* gauss elimination in Z/pZ, p < 2^32 so products fit in 64 bits */
+template<typename T>
+std::uint64_t det_mod(const T* a, std::size_t n, std::size_t lda, std::uint64_t p) {
+    std::vector<std::uint64_t> m(n * n);
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t j = 0; j < n; ++j) {
+            m[i * n + j] = reduce_mod(a[i * lda + j], p);
+        }
+    }
+
+    std::uint64_t ret = 1u;
+    for(std::size_t k = 0; k < n; ++k) {
+        std::size_t pivot = k;
+        for(; (pivot < n) && (m[pivot * n + k] == 0u); ++pivot) {}
+        if(pivot == n) {
+            return 0u;
+        }
+
+        if(pivot != k) {
+            std::swap_ranges(m.begin() + pivot * n + k, m.begin() + (pivot + 1) * n, m.begin() + k * n + k);
+            ret = p - ret;
+        }
+
+        std::uint64_t* row_k = m.data() + k * n;
+        ret = ret * row_k[k] % p;
+        std::uint64_t inverse = pow_mod(row_k[k], p - 2u, p);
+
+        for(std::size_t i = k + 1; i < n; ++i) {
+            std::uint64_t* row_i = m.data() + i * n;
+            if(row_i[k] == 0u) {
+                continue;
+            }
+
+            /* row_i -= f * row_k written as row_i += (p - f) * row_k to stay unsigned */
+            std::uint64_t f = p - row_i[k] * inverse % p;
+            for(std::size_t j = k + 1; j < n; ++j) {
+                row_i[j] = (row_i[j] + f * row_k[j]) % p;
+            }
+        }
+    }
+
+    return ret % p;
+}
+
+/*  horner scheme over mixed radix digits: digits[0] + digits[1] * p0 + digits[2] * p0 * p1 + ...
+    std::nullopt on 128-bit overflow */
+inline std::optional<uint128_t> mixed_radix_value(const std::vector<std::uint64_t>& digits, const std::vector<std::uint64_t>& primes) {
+    uint128_t ret = 0u;
+    for(std::size_t i = digits.size(); i-- > 0;) {
+        if(i + 1 < digits.size() && __builtin_mul_overflow(ret, static_cast<uint128_t>(primes[i]), &ret)) {
+            return std::nullopt;
+        }
+
+        if(__builtin_add_overflow(ret, static_cast<uint128_t>(digits[i]), &ret)) {
+            return std::nullopt;
+        }
+    }
+
+    return ret;
+}
+
+/*  garner algorithm, result x from [0, M) is taken in symmetric range (-M/2, M/2]:
+    x itself or -(M - x), where M - x - 1 has digits p_i - 1 - x_i */
+template<typename T>
+T reconstruct_det(const std::vector<std::uint64_t>& residues, const std::vector<std::uint64_t>& primes) {
+    std::size_t count = primes.size();
+    std::vector<std::uint64_t> digits(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        std::uint64_t p = primes[i];
+        std::uint64_t value = 0u;
+        std::uint64_t radix = 1u;
+        for(std::size_t j = 0; j < i; ++j) {
+            value = (value + digits[j] * radix) % p;
+            radix = radix * (primes[j] % p) % p;
+        }
+
+        digits[i] = (residues[i] + p - value) % p * pow_mod(radix, p - 2u, p) % p;
+    }
+
+    std::vector<std::uint64_t> complement(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        complement[i] = primes[i] - 1u - digits[i];
+    }
+
+    std::optional<uint128_t> positive = mixed_radix_value(digits, primes);
+    std::optional<uint128_t> negative = mixed_radix_value(complement, primes);
+    if(negative && (*negative < std::numeric_limits<uint128_t>::max())) {
+        ++*negative;
+    } else {
+        negative.reset();
+    }
+
+    bool is_negative = negative && (!positive || (*negative < *positive));
+    if(is_negative && std::is_signed_v<T> && (*negative <= static_cast<uint128_t>(std::numeric_limits<T>::max()) + 1u)) {
+        return static_cast<T>(-static_cast<int128_t>(*negative - 1u) - 1);
+    }
+
+    if(!is_negative && positive && (*positive <= static_cast<uint128_t>(std::numeric_limits<T>::max()))) {
+        return static_cast<T>(*positive);
+    }
+
+    throw std::runtime_error("exact_det: determinant doesn't fit in result type");
+}
+
+} /* namespace detail */
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+std::optional<T> bareiss_det(const T* a, std::size_t n, std::size_t lda) {
+    static_assert(std::is_integral_v<T>, "bareiss_det: only integral types are supported");
+    using detail::int128_t;
+
+    if(n == 0u) {
+        return T{1};
+    }
+
+    std::vector<int128_t> m(n * n);
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t j = 0; j < n; ++j) {
+            m[i * n + j] = static_cast<int128_t>(a[i * lda + j]);
+        }
+    }
+
+    bool negative = false;
+    int128_t previous = 1;
+    for(std::size_t k = 0; k + 1 < n; ++k) {
+        std::size_t pivot = k;
+        for(; (pivot < n) && (m[pivot * n + k] == 0); ++pivot) {}
+        if(pivot == n) {
+            return T{};
+        }
+
+        if(pivot != k) {
+            std::swap_ranges(m.begin() + pivot * n + k, m.begin() + (pivot + 1) * n, m.begin() + k * n + k);
+            negative = !negative;
+        }
+
+        const int128_t* row_k = m.data() + k * n;
+        for(std::size_t i = k + 1; i < n; ++i) {
+            int128_t* row_i = m.data() + i * n;
+            for(std::size_t j = k + 1; j < n; ++j) {
+                int128_t lhs, rhs;
+                if(__builtin_mul_overflow(row_i[j], row_k[k], &lhs) ||
+                   __builtin_mul_overflow(row_i[k], row_k[j], &rhs) ||
+                   __builtin_sub_overflow(lhs, rhs, &lhs)) {
+                    return std::nullopt;
+                }
+
+                row_i[j] = lhs / previous;
+            }
+        }
+
+        previous = row_k[k];
+    }
+
+    int128_t ret = m[n * n - 1];
+    if(negative) {
+        ret = -ret;
+    }
+
+    if((ret < static_cast<int128_t>(std::numeric_limits<T>::min())) || (ret > static_cast<int128_t>(std::numeric_limits<T>::max()))) {
+        throw std::runtime_error("exact_det: determinant doesn't fit in result type");
+    }
+
+    return static_cast<T>(ret);
+}
+
+template<typename T>
+T modular_det(const T* a, std::size_t n, std::size_t lda, std::size_t threads_count /* = std::thread::hardware_concurrency() */) {
+    static_assert(std::is_integral_v<T>, "modular_det: only integral types are supported");
+
+    /* log2 of hadamard bound: |det| <= product of row norms */
+    long double bound_bits = 0.0L;
+    for(std::size_t i = 0; i < n; ++i) {
+        long double norm = 0.0L;
+        for(std::size_t j = 0; j < n; ++j) {
+            long double x = static_cast<long double>(a[i * lda + j]);
+            norm += x * x;
+        }
+
+        if(norm == 0.0L) {
+            return T{};
+        }
+
+        bound_bits += std::log2(norm) / 2;
+    }
+
+    long double range_bits = std::numeric_limits<T>::digits + 1 + 2 * std::log2(static_cast<long double>(detail::max_det_prime));
+    std::vector<std::uint64_t> primes = detail::get_det_primes(std::min(bound_bits + 1, range_bits));
+
+    std::vector<std::uint64_t> residues(primes.size());
+    std::atomic<std::size_t> next{0u};
+    auto work = [&]() {
+        for(std::size_t i = next++; i < primes.size(); i = next++) {
+            residues[i] = detail::det_mod(a, n, lda, primes[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(std::size_t i = 1, max = std::min(threads_count, primes.size()); i < max; ++i) {
+        threads.emplace_back(work);
+    }
+    work();
+    for(auto&& thread : threads) {
+        thread.join();
+    }
+
+    return detail::reconstruct_det<T>(residues, primes);
+}
+
+template<typename T>
+T exact_det(const T* a, std::size_t n, std::size_t lda, std::size_t threads_count /* = std::thread::hardware_concurrency() */) {
+    if(n <= detail::bareiss_max_size) {
+        std::optional<T> ret = bareiss_det(a, n, lda);
+        if(ret) {
+            return *ret;
+        }
+    }
+
+    return modular_det(a, n, lda, threads_count);
+}
+
+} /* namespace matrix */
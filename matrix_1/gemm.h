@@ -0,0 +1,333 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace matrix {
+
+/*
+    ***general matrix multiplication: C += A * B***
+
+    function contract:
+
+        1) A: m * k, B: k * n, C: m * n, all row major
+        2) lda, ldb, ldc - distance between rows (in elements)
+
+    arithmetic types go through blocked algorithm (goto/blis scheme):
+    B is packed by kc * nc blocks, A by mc * kc blocks, both into aligned buffers,
+    then micro-kernel computes mr * nr tile of C in registers.
+    float and double have AVX2/AVX-512 kernels (build with -march=native), others - scalar one
+*/
+template<typename T>
+void gemm(std::size_t m, std::size_t n, std::size_t k,
+          const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c, std::size_t ldc);
+
+namespace detail {
+
+constexpr std::size_t gemm_alignment = 64u;
+
+struct aligned_deleter_t {
+    void operator()(void* p) const {::operator delete(p, std::align_val_t{gemm_alignment});}
+};
+
+template<typename T>
+using aligned_ptr_t = std::unique_ptr<T[], aligned_deleter_t>;
+
+/* memory for trivial types only, elements are not constructed */
+template<typename T>
+aligned_ptr_t<T> make_aligned_buffer(std::size_t size) {
+    static_assert(std::is_trivial_v<T>, "make_aligned_buffer: only trivial types are supported");
+    return aligned_ptr_t<T>(static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{gemm_alignment})));
+}
+
+/*  micro-kernel: tile[mr][nr] = sum over p < kc of pa[p][mr] (x) pb[p][nr]
+    pa, pb - packed panels, pb is aligned on gemm_alignment */
+template<typename T>
+struct gemm_kernel_t {
+    static constexpr std::size_t mr = 4u;
+    static constexpr std::size_t nr = 4u;
+
+    static void run(std::size_t kc, const T* pa, const T* pb, T* tile) {
+        T acc[mr * nr] = {};
+        for(std::size_t p = 0; p < kc; ++p, pa += mr, pb += nr) {
+            for(std::size_t i = 0; i < mr; ++i) {
+                for(std::size_t j = 0; j < nr; ++j) {
+                    acc[i * nr + j] += pa[i] * pb[j];
+                }
+            }
+        }
+
+        std::copy(acc, acc + mr * nr, tile);
+    }
+};
+
+/* x87 stack has only 8 registers, so long double tile is one row of 4 accumulators */
+template<>
+struct gemm_kernel_t<long double> {
+    static constexpr std::size_t mr = 1u;
+    static constexpr std::size_t nr = 4u;
+
+    static void run(std::size_t kc, const long double* pa, const long double* pb, long double* tile) {
+        long double acc0 = 0.0L, acc1 = 0.0L, acc2 = 0.0L, acc3 = 0.0L;
+        for(std::size_t p = 0; p < kc; ++p, ++pa, pb += nr) {
+            long double a = *pa;
+            acc0 += a * pb[0];
+            acc1 += a * pb[1];
+            acc2 += a * pb[2];
+            acc3 += a * pb[3];
+        }
+
+        tile[0] = acc0; tile[1] = acc1; tile[2] = acc2; tile[3] = acc3;
+    }
+};
+
+#if defined(__AVX512F__)
+
+template<>
+struct gemm_kernel_t<double> {
+    static constexpr std::size_t mr = 6u;
+    static constexpr std::size_t nr = 16u;
+
+    static void run(std::size_t kc, const double* pa, const double* pb, double* tile) {
+        __m512d acc[mr][2];
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            acc[i][0] = acc[i][1] = _mm512_setzero_pd();
+        }
+
+        for(std::size_t p = 0; p < kc; ++p, pa += mr, pb += nr) {
+            __m512d b0 = _mm512_load_pd(pb);
+            __m512d b1 = _mm512_load_pd(pb + 8);
+            #pragma GCC unroll 6
+            for(std::size_t i = 0; i < mr; ++i) {
+                __m512d ai = _mm512_set1_pd(pa[i]);
+                acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+            }
+        }
+
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            _mm512_storeu_pd(tile + i * nr, acc[i][0]);
+            _mm512_storeu_pd(tile + i * nr + 8, acc[i][1]);
+        }
+    }
+};
+
+template<>
+struct gemm_kernel_t<float> {
+    static constexpr std::size_t mr = 6u;
+    static constexpr std::size_t nr = 32u;
+
+    static void run(std::size_t kc, const float* pa, const float* pb, float* tile) {
+        __m512 acc[mr][2];
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            acc[i][0] = acc[i][1] = _mm512_setzero_ps();
+        }
+
+        for(std::size_t p = 0; p < kc; ++p, pa += mr, pb += nr) {
+            __m512 b0 = _mm512_load_ps(pb);
+            __m512 b1 = _mm512_load_ps(pb + 16);
+            #pragma GCC unroll 6
+            for(std::size_t i = 0; i < mr; ++i) {
+                __m512 ai = _mm512_set1_ps(pa[i]);
+                acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+            }
+        }
+
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            _mm512_storeu_ps(tile + i * nr, acc[i][0]);
+            _mm512_storeu_ps(tile + i * nr + 16, acc[i][1]);
+        }
+    }
+};
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+template<>
+struct gemm_kernel_t<double> {
+    static constexpr std::size_t mr = 6u;
+    static constexpr std::size_t nr = 8u;
+
+    static void run(std::size_t kc, const double* pa, const double* pb, double* tile) {
+        __m256d acc[mr][2];
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            acc[i][0] = acc[i][1] = _mm256_setzero_pd();
+        }
+
+        for(std::size_t p = 0; p < kc; ++p, pa += mr, pb += nr) {
+            __m256d b0 = _mm256_load_pd(pb);
+            __m256d b1 = _mm256_load_pd(pb + 4);
+            #pragma GCC unroll 6
+            for(std::size_t i = 0; i < mr; ++i) {
+                __m256d ai = _mm256_broadcast_sd(pa + i);
+                acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+            }
+        }
+
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            _mm256_storeu_pd(tile + i * nr, acc[i][0]);
+            _mm256_storeu_pd(tile + i * nr + 4, acc[i][1]);
+        }
+    }
+};
+
+template<>
+struct gemm_kernel_t<float> {
+    static constexpr std::size_t mr = 6u;
+    static constexpr std::size_t nr = 16u;
+
+    static void run(std::size_t kc, const float* pa, const float* pb, float* tile) {
+        __m256 acc[mr][2];
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            acc[i][0] = acc[i][1] = _mm256_setzero_ps();
+        }
+
+        for(std::size_t p = 0; p < kc; ++p, pa += mr, pb += nr) {
+            __m256 b0 = _mm256_load_ps(pb);
+            __m256 b1 = _mm256_load_ps(pb + 8);
+            #pragma GCC unroll 6
+            for(std::size_t i = 0; i < mr; ++i) {
+                __m256 ai = _mm256_broadcast_ss(pa + i);
+                acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+            }
+        }
+
+        #pragma GCC unroll 6
+        for(std::size_t i = 0; i < mr; ++i) {
+            _mm256_storeu_ps(tile + i * nr, acc[i][0]);
+            _mm256_storeu_ps(tile + i * nr + 8, acc[i][1]);
+        }
+    }
+};
+
+#endif
+
+/* cache blocking: mc * kc block of A lives in L2, kc * nr panel of B with mr * kc panel of A - in L1 */
+template<typename T>
+struct gemm_blocking_t {
+    static constexpr std::size_t kc = 192u;
+    static constexpr std::size_t mc = gemm_kernel_t<T>::mr * 16u;
+    static constexpr std::size_t nc = gemm_kernel_t<T>::nr * 128u;
+};
+
+/* rows [0, m) of A block are stored as panels of mr rows, element (i, p) of panel - at pa[p * mr + i] */
+template<typename T>
+void pack_a(std::size_t m, std::size_t kc, const T* a, std::size_t lda, T* pa) {
+    constexpr std::size_t mr = gemm_kernel_t<T>::mr;
+    for(std::size_t i0 = 0; i0 < m; i0 += mr) {
+        std::size_t rows = std::min(mr, m - i0);
+        for(std::size_t p = 0; p < kc; ++p, pa += mr) {
+            for(std::size_t i = 0; i < rows; ++i) {
+                pa[i] = a[(i0 + i) * lda + p];
+            }
+            std::fill(pa + rows, pa + mr, T{});
+        }
+    }
+}
+
+/* cols [0, n) of B block are stored as panels of nr cols, element (p, j) of panel - at pb[p * nr + j] */
+template<typename T>
+void pack_b(std::size_t n, std::size_t kc, const T* b, std::size_t ldb, T* pb) {
+    constexpr std::size_t nr = gemm_kernel_t<T>::nr;
+    for(std::size_t j0 = 0; j0 < n; j0 += nr) {
+        std::size_t cols = std::min(nr, n - j0);
+        for(std::size_t p = 0; p < kc; ++p, pb += nr) {
+            const T* row = b + p * ldb + j0;
+            std::copy(row, row + cols, pb);
+            std::fill(pb + cols, pb + nr, T{});
+        }
+    }
+}
+
+/* C[m][n] += packed A block * packed B block */
+template<typename T>
+void gemm_macro_kernel(std::size_t m, std::size_t n, std::size_t kc, const T* pa, const T* pb, T* c, std::size_t ldc) {
+    constexpr std::size_t mr = gemm_kernel_t<T>::mr;
+    constexpr std::size_t nr = gemm_kernel_t<T>::nr;
+    alignas(gemm_alignment) T tile[mr * nr];
+
+    for(std::size_t j0 = 0; j0 < n; j0 += nr) {
+        std::size_t cols = std::min(nr, n - j0);
+        for(std::size_t i0 = 0; i0 < m; i0 += mr) {
+            std::size_t rows = std::min(mr, m - i0);
+            gemm_kernel_t<T>::run(kc, pa + i0 * kc, pb + j0 * kc, tile);
+
+            for(std::size_t i = 0; i < rows; ++i) {
+                T* c_row = c + (i0 + i) * ldc + j0;
+                for(std::size_t j = 0; j < cols; ++j) {
+                    c_row[j] += tile[i * nr + j];
+                }
+            }
+        }
+    }
+}
+
+inline std::size_t round_up(std::size_t value, std::size_t step) {
+    return (value + step - 1) / step * step;
+}
+
+} /* namespace detail */
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+void gemm(std::size_t m, std::size_t n, std::size_t k,
+          const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c, std::size_t ldc) {
+    if(!m || !n || !k) {
+        return;
+    }
+
+    /* packing needs raw memory, so not arithmetic types are multiplied naively */
+    if constexpr (!std::is_arithmetic_v<T>) {
+        for(std::size_t i = 0; i < m; ++i) {
+            for(std::size_t p = 0; p < k; ++p) {
+                for(std::size_t j = 0; j < n; ++j) {
+                    c[i * ldc + j] += a[i * lda + p] * b[p * ldb + j];
+                }
+            }
+        }
+    } else {
+        using blocking_t = detail::gemm_blocking_t<T>;
+        constexpr std::size_t mr = detail::gemm_kernel_t<T>::mr;
+        constexpr std::size_t nr = detail::gemm_kernel_t<T>::nr;
+
+        /* buffers are not bigger than matrices, small products don't allocate full blocks */
+        std::size_t kc_max = std::min(blocking_t::kc, k);
+        auto pa = detail::make_aligned_buffer<T>(detail::round_up(std::min(blocking_t::mc, m), mr) * kc_max);
+        auto pb = detail::make_aligned_buffer<T>(detail::round_up(std::min(blocking_t::nc, n), nr) * kc_max);
+
+        for(std::size_t j0 = 0; j0 < n; j0 += blocking_t::nc) {
+            std::size_t nc = std::min(blocking_t::nc, n - j0);
+            for(std::size_t p0 = 0; p0 < k; p0 += blocking_t::kc) {
+                std::size_t kc = std::min(blocking_t::kc, k - p0);
+                detail::pack_b(nc, kc, b + p0 * ldb + j0, ldb, pb.get());
+
+                for(std::size_t i0 = 0; i0 < m; i0 += blocking_t::mc) {
+                    std::size_t mc = std::min(blocking_t::mc, m - i0);
+                    detail::pack_a(mc, kc, a + i0 * lda + p0, lda, pa.get());
+                    detail::gemm_macro_kernel(mc, nc, kc, pa.get(), pb.get(), c + i0 * ldc + j0, ldc);
+                }
+            }
+        }
+    }
+}
+
+} /* namespace matrix */
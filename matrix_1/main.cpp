@@ -1,10 +1,18 @@
 #include <iostream>
 #include "matrix.h"
+#include "matrix_io.h"
 #include <vector>
 
-int main() {
+/* determinant of matrix from stdin (size, then elements) or from binary file given as argument */
+int main(int argc, char** argv) {
+    if(argc > 1) {
+        matrix::matrix_t<long double> matrix = matrix::read_binary<long double>(argv[1]);
+        std::cout << matrix.det() << std::endl;
+        return 0;
+    }
+
     std::size_t size; std::cin >> size;
     matrix::matrix_t<long double> matrix(size, size);
-    std::cin >> matrix;
+    matrix::read_text(std::cin, matrix);
     std::cout << matrix.det() << std::endl;
-}
\ No newline at end of file
+}
@@ -7,6 +7,10 @@
 #include <iostream>
 #include <optional>
 #include <iomanip>
+#include <type_traits>
+
+#include "gemm.h"
+#include "exact_det.h"
 
 #ifdef DEBUG_
 #include <fstream>
@@ -349,6 +353,8 @@ matrix::matrix_t<T>& matrix::matrix_t<T>::transpose() & {
             data_[j + i * maxj] = tmp_matrix[j][i];
         }
     }
+
+    return *this;
 }
 
 template<typename T>
@@ -428,6 +434,11 @@ T matrix::matrix_t<T>::det() const {
         return T{};
     }
 
+    /* integer matrices have exact determinant, no rounding of long double result */
+    if constexpr (std::is_integral_v<T>) {
+        return exact_det(data_, get_row_number(), get_col_number());
+    }
+
     long double ret{1};
 
 #ifdef DEBUG_
@@ -534,18 +545,11 @@ matrix::matrix_t<T> matrix::multiplication(const matrix_t<T>& lhs, const matrix_
 
     std::size_t ret_m = lhs.get_row_number();
     std::size_t ret_n = rhs.get_col_number();
+    std::size_t ret_k = lhs.get_col_number();
 
     matrix_t<T> ret{ret_m, ret_n};
-    for(std::size_t i = 0, maxi = ret_m; i < maxi; ++i) {
-        for(std::size_t j = 0, maxj = ret_n; j < maxj; ++j) {
-            T elem{};
-            for(std::size_t k = 0, maxk = lhs.get_col_number(); k < maxk; ++k) {
-                elem += (lhs[i][k] * rhs[k][j]);
-            }
-
-            ret[i][j] = elem;
-        }
-
+    if(ret.get_elem_number() && ret_k) {
+        gemm(ret_m, ret_n, ret_k, &lhs[0][0], ret_k, &rhs[0][0], ret_n, &ret[0][0], ret_n);
     }
 
     return ret;
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "matrix.h"
+
+/* binary file has the same format as in matrix_2 and matrix_3 (matrix_io.hpp) */
+namespace matrix {
+    enum class dtype_t : std::uint32_t {int32 = 1, int64 = 2, float32 = 3, float64 = 4, float80 = 5};
+    enum class layout_t : std::uint32_t {row_major = 0, col_major = 1};
+
+    /* 64 bytes header, then elements without padding */
+    struct matrix_header_t {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        dtype_t dtype;
+        layout_t layout;
+        std::uint32_t element_size;
+        std::uint32_t reserved;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t data_offset;
+    };
+
+    constexpr char matrix_magic[8] = "MATRIXB";
+    constexpr std::uint32_t matrix_file_version = 1u;
+    constexpr std::uint32_t matrix_byte_order = 0x01020304u;
+    constexpr std::size_t matrix_data_offset = 64u;
+
+    template<typename T>
+    void write_binary(const std::string& path, const matrix_t<T>& m, layout_t layout = layout_t::row_major);
+
+    /* file is mapped, elements of any dtype are converted to T, throws on invalid file */
+    template<typename T>
+    matrix_t<T> read_binary(const std::string& path);
+
+    /* whitespace separated elements, parsed by from_chars without formatted extraction of istream */
+    template<typename T>
+    std::istream& read_text(std::istream& in, matrix_t<T>& m);
+}
+
+
+/* -------------------------------------------------
+                     REALIZATION
+ --------------------------------------------------*/
+
+namespace matrix {
+namespace detail {
+    template<typename T>
+    constexpr dtype_t dtype_of() {
+        if constexpr(std::is_same_v<T, std::int32_t>) {
+            return dtype_t::int32;
+        } else if constexpr(std::is_same_v<T, std::int64_t>) {
+            return dtype_t::int64;
+        } else if constexpr(std::is_same_v<T, float>) {
+            return dtype_t::float32;
+        } else if constexpr(std::is_same_v<T, double>) {
+            return dtype_t::float64;
+        } else {
+            static_assert(std::is_same_v<T, long double>, "dtype_of: type can't be stored in binary matrix file");
+            return dtype_t::float80;
+        }
+    }
+
+    inline std::size_t element_size(dtype_t dtype) {
+        switch(dtype) {
+            case dtype_t::int32:   return sizeof(std::int32_t);
+            case dtype_t::int64:   return sizeof(std::int64_t);
+            case dtype_t::float32: return sizeof(float);
+            case dtype_t::float64: return sizeof(double);
+            case dtype_t::float80: return sizeof(long double);
+        }
+
+        return 0u;
+    }
+
+    template<typename T, typename U>
+    void convert(const void* src, const matrix_header_t& header, matrix_t<T>& m) {
+        const U* data = static_cast<const U*>(src);
+        bool row_major = (header.layout == layout_t::row_major);
+        for(std::size_t i = 0; i < header.rows; ++i) {
+            for(std::size_t j = 0; j < header.cols; ++j) {
+                m[i][j] = static_cast<T>(row_major ? data[i * header.cols + j] : data[j * header.rows + i]);
+            }
+        }
+    }
+
+    inline bool is_space(int c) {
+        return (c == ' ') || (c == '\n') || (c == '\t') || (c == '\r') || (c == '\v') || (c == '\f');
+    }
+}
+}
+
+template<typename T>
+void matrix::write_binary(const std::string& path, const matrix_t<T>& m, layout_t layout /* = layout_t::row_major */) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out) {
+        throw std::runtime_error("write_binary: can't open " + path);
+    }
+
+    std::size_t rows = m.get_row_number(), cols = m.get_col_number();
+    char header_bytes[matrix_data_offset] = {};
+    matrix_header_t header{};
+    std::memcpy(header.magic, matrix_magic, sizeof(matrix_magic));
+    header.version = matrix_file_version;
+    header.byte_order = matrix_byte_order;
+    header.dtype = detail::dtype_of<T>();
+    header.layout = layout;
+    header.element_size = sizeof(T);
+    header.rows = rows;
+    header.cols = cols;
+    header.data_offset = matrix_data_offset;
+    std::memcpy(header_bytes, &header, sizeof(header));
+    out.write(header_bytes, matrix_data_offset);
+
+    /* elements are written by blocks of 4 MiB */
+    std::vector<T> buffer(std::max<std::size_t>((4u << 20u) / sizeof(T), 1u));
+    std::size_t filled = 0u;
+    std::size_t outer = (layout == layout_t::row_major) ? rows : cols;
+    std::size_t inner = (layout == layout_t::row_major) ? cols : rows;
+    for(std::size_t i = 0; i < outer; ++i) {
+        for(std::size_t j = 0; j < inner; ++j) {
+            if(filled == buffer.size()) {
+                out.write(reinterpret_cast<const char*>(buffer.data()), filled * sizeof(T));
+                filled = 0u;
+            }
+
+            buffer[filled++] = (layout == layout_t::row_major) ? m[i][j] : m[j][i];
+        }
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()), filled * sizeof(T));
+
+    out.flush();
+    if(!out) {
+        throw std::runtime_error("write_binary: can't write " + path);
+    }
+}
+
+template<typename T>
+matrix::matrix_t<T> matrix::read_binary(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::runtime_error("read_binary: can't open " + path);
+    }
+
+    struct stat st;
+    std::size_t size = (::fstat(fd, &st) == 0) ? static_cast<std::size_t>(st.st_size) : 0u;
+    void* mapping = (size >= matrix_data_offset) ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if(mapping == MAP_FAILED) {
+        throw std::runtime_error("read_binary: can't map " + path);
+    }
+
+    matrix_header_t header;
+    std::memcpy(&header, mapping, sizeof(header));
+    std::uint64_t elements = header.rows * header.cols;
+    bool valid = !std::memcmp(header.magic, matrix_magic, sizeof(matrix_magic)) && (header.version == matrix_file_version) &&
+                 (header.byte_order == matrix_byte_order) && detail::element_size(header.dtype) &&
+                 (header.element_size == detail::element_size(header.dtype)) &&
+                 ((header.layout == layout_t::row_major) || (header.layout == layout_t::col_major)) &&
+                 (!header.cols || (elements / header.cols == header.rows)) && (header.data_offset >= matrix_data_offset) &&
+                 (header.data_offset <= size) && ((size - header.data_offset) / header.element_size >= elements);
+    if(!valid) {
+        ::munmap(mapping, size);
+        throw std::runtime_error("read_binary: invalid matrix file " + path);
+    }
+
+    matrix_t<T> ret(header.rows, header.cols);
+    const void* src = static_cast<const char*>(mapping) + header.data_offset;
+    switch(header.dtype) {
+        case dtype_t::int32:   detail::convert<T, std::int32_t>(src, header, ret); break;
+        case dtype_t::int64:   detail::convert<T, std::int64_t>(src, header, ret); break;
+        case dtype_t::float32: detail::convert<T, float>(src, header, ret); break;
+        case dtype_t::float64: detail::convert<T, double>(src, header, ret); break;
+        case dtype_t::float80: detail::convert<T, long double>(src, header, ret); break;
+    }
+
+    ::munmap(mapping, size);
+    return ret;
+}
+
+template<typename T>
+std::istream& matrix::read_text(std::istream& in, matrix_t<T>& m) {
+    using traits = std::streambuf::traits_type;
+    std::istream::sentry sentry(in);
+    if(!sentry) {
+        return in;
+    }
+
+    std::streambuf& buf = *in.rdbuf();
+    char token[128];
+    for(std::size_t i = 0, maxi = m.get_row_number(); i < maxi; ++i) {
+        for(std::size_t j = 0, maxj = m.get_col_number(); j < maxj; ++j) {
+            int c = buf.sgetc();
+            while((c != traits::eof()) && detail::is_space(c)) {
+                c = buf.snextc();
+            }
+
+            std::size_t length = 0u;
+            while((c != traits::eof()) && !detail::is_space(c) && (length < sizeof(token))) {
+                token[length++] = traits::to_char_type(c);
+                c = buf.snextc();
+            }
+
+            /* from_chars doesn't accept leading plus */
+            const char* first = token + ((length > 1) && (token[0] == '+'));
+            auto [last, error] = std::from_chars(first, token + length, m[i][j]);
+            if(!length || (error != std::errc{}) || (last != token + length) || ((c != traits::eof()) && !detail::is_space(c))) {
+                in.setstate((c == traits::eof()) ? (std::ios::failbit | std::ios::eofbit) : std::ios::failbit);
+                return in;
+            }
+        }
+    }
+
+    return in;
+}
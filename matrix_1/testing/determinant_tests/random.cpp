@@ -188,8 +188,61 @@ void test_random_2_runner() {
     }
 }
 
+/* cases have integer elements, so determinant of integer matrix must be exact */
+void test_exact_det(char* name, long long ans) {
+    std::ifstream in(name, std::ios::in);
+    if(!in.good()) {
+        std::cerr << "Can't open test file: " << name << std::endl;
+        return;
+    }
+
+    std::size_t matrix_size; in >> matrix_size;
+    matrix::matrix_t<double> m(matrix_size, matrix_size); in >> m;
+    matrix::matrix_t<long long> integer_m = m;
+
+    for(std::size_t i = 0; i < 10; ++i) {
+        if(std::abs(integer_m.det()) != ans) {
+            std::cerr << "test_exact_det failed for matrix: " << std::endl;
+            std::cerr << integer_m;
+            return;
+        }
+
+        swap_rows_and_cols(integer_m);
+    }
+
+    std::cout << name << " exact test success" << std::endl;
+}
+
+void test_exact_det_runner() {
+    {
+        char name[] = "testing/determinant_tests/cases/case_0.txt";
+        test_exact_det(name, 42);
+    }
+
+    {
+        char name[] = "testing/determinant_tests/cases/case_1.txt";
+        test_exact_det(name, 126);
+    }
+
+    {
+        char name[] = "testing/determinant_tests/cases/case_2.txt";
+        test_exact_det(name, 42);
+    }
+
+    {
+        char name[] = "testing/determinant_tests/cases/case_3.txt";
+        test_exact_det(name, 1);
+    }
+
+    {
+        char name[] = "testing/determinant_tests/cases/case_4.txt";
+        test_exact_det(name, 42);
+    }
+}
+
 int main() {
     test_random_1(7); /* odd size */
     test_random_1(8); /* even size */
     test_random_2_runner();
+    test_exact_det_runner();
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include "../../matrix.h"
+#include <random>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+/*
+    stress benchmark of determinant: families of matrices with known determinant are
+    generated by threads, then determinants are computed by threads. For every family,
+    operation and size one csv row is printed:
+
+        family,op,n,threads,matrices,seconds,matrices_per_second,mean_us,p90_us,err_median,err_p90,err_max
+
+    error is relative |det - expected| / |expected|, time of generation isn't measured.
+
+    families:
+        random      - H1 * D * H2, H - dense householder reflections (det(H) == -1), D - random diagonal,
+                      expected det is product of D
+        triangular  - P * L * U, expected det is sign(P) * diag(U)
+        ill         - P * L * D * U, D from 1e6 to 1e-6 (cond ~1e12), expected det is sign(P)
+        integer     - P * L * U with integer elements, det is computed in long double (det)
+                      and exactly (exact_det)
+
+    usage: ./stress.out [threads] [matrices] [max_n] [output.csv]
+    matrices is number of matrices of size 16, it is scaled as 1 / n for other sizes
+*/
+
+namespace {
+    struct stress_case_t {
+        matrix::matrix_t<double> a;
+        matrix::matrix_t<long long> exact;
+        long double expected;
+    };
+
+    struct options_t {
+        std::size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+        std::size_t matrices = 256;
+        std::size_t max_n = 256;
+    };
+
+    /* unit lower triangular, off diagonal elements are scaled by 1 / n to keep it well conditioned */
+    matrix::matrix_t<double> generate_unit_lower(std::size_t size, std::mt19937& gen) {
+        std::uniform_real_distribution<> dis(-1, 1);
+        matrix::matrix_t<double> ret(size, size, 0.0);
+        for(std::size_t i = 0; i < size; ++i) {
+            for(std::size_t j = 0; j < i; ++j) {
+                ret[i][j] = dis(gen) / size;
+            }
+            ret[i][i] = 1;
+        }
+
+        return ret;
+    }
+
+    /* random rows permutation, returns its sign */
+    template<typename T>
+    int permute_rows(matrix::matrix_t<T>& m, std::mt19937& gen) {
+        int sign = 1;
+        for(std::size_t i = m.get_row_number(); i > 1; --i) {
+            std::size_t j = std::uniform_int_distribution<std::size_t>(0, i - 1)(gen);
+            if(j != i - 1) {
+                m.swap_rows(i - 1, j);
+                sign = -sign;
+            }
+        }
+
+        return sign;
+    }
+
+    /* I - 2 * v * v^T / (v^T * v), all elements are nonzero in general */
+    matrix::matrix_t<double> generate_reflection(std::size_t size, std::mt19937& gen) {
+        std::uniform_real_distribution<> dis(-1, 1);
+        std::vector<double> v(size);
+        double norm = 0;
+        for(auto& x : v) {
+            x = dis(gen);
+            norm += x * x;
+        }
+
+        matrix::matrix_t<double> ret(size, size, 0.0);
+        for(std::size_t i = 0; i < size; ++i) {
+            for(std::size_t j = 0; j < size; ++j) {
+                ret[i][j] = ((i == j) ? 1.0 : 0.0) - 2 * v[i] * v[j] / norm;
+            }
+        }
+
+        return ret;
+    }
+
+    stress_case_t generate_random(std::size_t size, std::mt19937& gen) {
+        std::uniform_real_distribution<> dis(0.5, 2);
+        matrix::matrix_t<double> d(size, size, 0.0);
+        long double expected = 1;
+        for(std::size_t i = 0; i < size; ++i) {
+            d[i][i] = (gen() % 2) ? dis(gen) : -dis(gen);
+            expected *= d[i][i];
+        }
+
+        matrix::matrix_t<double> left = matrix::multiplication(generate_reflection(size, gen), d);
+        return stress_case_t{matrix::multiplication(left, generate_reflection(size, gen)), {}, expected};
+    }
+
+    stress_case_t generate_triangular(std::size_t size, std::mt19937& gen, bool ill_conditioned) {
+        std::uniform_real_distribution<> dis(0.5, 2);
+        matrix::matrix_t<double> u = generate_unit_lower(size, gen);
+        u.transpose();
+
+        long double expected = 1;
+        for(std::size_t i = 0; i < size; ++i) {
+            double d = (size > 1) ? std::pow(10.0, 6.0 - 12.0 * i / (size - 1)) : 1.0;
+            if(!ill_conditioned) {
+                d = (gen() % 2) ? dis(gen) : -dis(gen);
+                expected *= d;
+            }
+
+            for(std::size_t j = i; j < size; ++j) {
+                u[i][j] *= d;
+            }
+        }
+
+        stress_case_t ret{matrix::multiplication(generate_unit_lower(size, gen), u), {}, 0};
+        ret.expected = expected * permute_rows(ret.a, gen);
+        return ret;
+    }
+
+    /* L and U have elements from {-1, 0, 1}, diagonal of U has at most 40 elements +-2 */
+    stress_case_t generate_integer(std::size_t size, std::mt19937& gen) {
+        std::uniform_int_distribution<> dis(-1, 1);
+        matrix::matrix_t<long long> l(size, size, 0), u(size, size, 0);
+
+        long double expected = 1;
+        std::size_t twos = 0;
+        for(std::size_t i = 0; i < size; ++i) {
+            for(std::size_t j = 0; j < i; ++j) {
+                l[i][j] = dis(gen);
+                u[j][i] = dis(gen);
+            }
+            l[i][i] = 1;
+            u[i][i] = ((twos < 40) && (gen() % 4 == 0)) ? (++twos, 2) : 1;
+            u[i][i] *= (gen() % 2) ? 1 : -1;
+            expected *= u[i][i];
+        }
+
+        stress_case_t ret{{}, matrix::multiplication(l, u), 0};
+        ret.expected = expected * permute_rows(ret.exact, gen);
+        ret.a = ret.exact;
+        return ret;
+    }
+
+    stress_case_t generate(const std::string& family, std::size_t size, std::mt19937& gen) {
+        if(family == "random") {
+            return generate_random(size, gen);
+        }
+
+        if(family == "integer") {
+            return generate_integer(size, gen);
+        }
+
+        return generate_triangular(size, gen, family == "ill");
+    }
+
+    /* cases [i * count / threads, (i + 1) * count / threads) are processed by thread i */
+    template<typename F>
+    void run_threads(std::size_t threads, std::size_t count, F func) {
+        std::vector<std::thread> workers;
+        for(std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([=] {
+                for(std::size_t j = i * count / threads, end = (i + 1) * count / threads; j < end; ++j) {
+                    func(i, j);
+                }
+            });
+        }
+
+        for(auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    double percentile(std::vector<double> values, double p) {
+        if(values.empty()) {
+            return 0;
+        }
+
+        std::size_t idx = std::min(static_cast<std::size_t>(p * values.size()), values.size() - 1);
+        std::nth_element(values.begin(), values.begin() + idx, values.end());
+        return values[idx];
+    }
+
+    void run_family(const std::string& family, const options_t& options, std::ostream& out) {
+        for(std::size_t n = 4; n <= options.max_n; n *= 2) {
+            std::size_t count = std::max(options.matrices * 16 / n, options.threads);
+
+            std::vector<stress_case_t> cases(count);
+            run_threads(options.threads, count, [&](std::size_t, std::size_t idx) {
+                std::mt19937 gen(static_cast<unsigned>(n * 1000003u + idx));
+                cases[idx] = generate(family, n, gen);
+            });
+
+            std::vector<std::string> ops{"det"};
+            if(family == "integer") {
+                ops.push_back("exact_det");
+            }
+
+            for(const auto& op : ops) {
+                std::vector<double> errors(count), times(count);
+                auto start = std::chrono::steady_clock::now();
+                run_threads(options.threads, count, [&](std::size_t, std::size_t idx) {
+                    const stress_case_t& c = cases[idx];
+                    auto begin = std::chrono::steady_clock::now();
+                    long double det = (op == "det") ? c.a.det() : matrix::exact_det(&c.exact[0][0], n, n, 1);
+                    times[idx] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+                    long double diff = std::abs(det - c.expected);
+                    errors[idx] = static_cast<double>((c.expected != 0) ? diff / std::abs(c.expected) : diff);
+                });
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                double mean = 0;
+                for(double t : times) {
+                    mean += t / count;
+                }
+
+                out << family << ',' << op << ',' << n << ',' << options.threads << ',' << count << ','
+                    << seconds << ',' << count / seconds << ',' << mean << ',' << percentile(times, 0.9) << ','
+                    << percentile(errors, 0.5) << ',' << percentile(errors, 0.9) << ','
+                    << *std::max_element(errors.begin(), errors.end()) << std::endl;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    options_t options;
+    try {
+        if(argc > 1) {
+            options.threads = std::max<std::size_t>(std::stoul(argv[1]), 1u);
+        }
+        if(argc > 2) {
+            options.matrices = std::stoul(argv[2]);
+        }
+        if(argc > 3) {
+            options.max_n = std::stoul(argv[3]);
+        }
+    } catch(const std::exception&) {
+        std::cerr << "usage: " << argv[0] << " [threads] [matrices] [max_n] [output.csv]" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if(argc > 4) {
+        file.open(argv[4], std::ios::out | std::ios::trunc);
+        if(!file.good()) {
+            std::cerr << "Can't open output file: " << argv[4] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = (argc > 4) ? file : std::cout;
+
+    out << "family,op,n,threads,matrices,seconds,matrices_per_second,mean_us,p90_us,err_median,err_p90,err_max" << std::endl;
+    for(const std::string family : {"random", "triangular", "ill", "integer"}) {
+        run_family(family, options, out);
+    }
+
+    return 0;
+}
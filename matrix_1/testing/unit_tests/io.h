@@ -0,0 +1,45 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include "../../matrix_io.h"
+
+TEST(MatrixUnitTest, IOBinary) {
+    std::vector<double> v{1.5, -2.0, 3.25, 4.0, 5.0, -6.125};
+    matrix::matrix_t<double> m = {2, 3, v.begin(), v.end()};
+    std::string path = testing::TempDir() + "matrix_1_io.bin";
+
+    for(auto layout : {matrix::layout_t::row_major, matrix::layout_t::col_major}) {
+        matrix::write_binary(path, m, layout);
+        ASSERT_TRUE(matrix::read_binary<double>(path) == m);
+
+        matrix::matrix_t<long double> converted = matrix::read_binary<long double>(path);
+        ASSERT_EQ(converted.get_row_number(), 2);
+        ASSERT_EQ(converted[1][2], -6.125L);
+    }
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a matrix file, but long enough for header of matrix file";
+    ASSERT_THROW(matrix::read_binary<double>(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(MatrixUnitTest, IOText) {
+    std::istringstream in("3\n 1 -2.5 +3\n4e1 5 6\n 7 8 9 tail");
+    std::size_t size; in >> size;
+    matrix::matrix_t<double> m(size, size);
+    ASSERT_TRUE(matrix::read_text(in, m));
+    ASSERT_EQ(m[0][1], -2.5);
+    ASSERT_EQ(m[0][2], 3.0);
+    ASSERT_EQ(m[1][0], 40.0);
+    ASSERT_EQ(m[2][2], 9.0);
+
+    std::string tail; in >> tail;
+    ASSERT_EQ(tail, "tail");
+
+    std::istringstream invalid("1 2 three 4");
+    matrix::matrix_t<double> small(2, 2);
+    ASSERT_FALSE(matrix::read_text(invalid, small));
+}
@@ -5,6 +5,7 @@
 #include "operators.h"
 #include "useful_methods.h"
 #include "useful_funcs.h"
+#include "io.h"
 
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
@@ -149,4 +149,52 @@ TEST(MatrixUnitTest, MethodsDeterminant) {
 
         ASSERT_NEAR(m.det(), 2150, 1e-5);
     }
-}
\ No newline at end of file
+}
+TEST(MatrixUnitTest, MethodsExactDeterminant) {
+    {
+        std::vector<long long> v{1, 4, -1, 5, 6, -3, 2, 1, 10, -5, 4, -7, 3, 5, -10, 6};
+        matrix::matrix_t<long long> m(4, 4, v.begin(), v.end());
+
+        ASSERT_EQ(m.det(), 2150);
+        ASSERT_EQ(matrix::modular_det(&m[0][0], 4, 4), 2150);
+    }
+
+    {
+        std::vector<int> v{1, 2, 3, 4, 5, 6, 7, 8, 9};
+        matrix::matrix_t<int> m(3, 3, v.begin(), v.end());
+
+        ASSERT_EQ(m.det(), 0);
+        ASSERT_EQ(matrix::modular_det(&m[0][0], 3, 3), 0);
+    }
+
+    /* upper triangular with det = -2^61, mixed by unimodular row operations */
+    for(std::size_t size : {30u, 100u}) {
+        matrix::matrix_t<long long> m(size, size);
+        for(std::size_t i = 0; i < size; ++i) {
+            m[i][i] = (i < 61u) ? 2 : 1;
+            for(std::size_t j = i + 1; j < size; ++j) {
+                m[i][j] = static_cast<long long>((i * 7 + j * 3) % 11) - 5;
+            }
+        }
+        m[size - 1][size - 1] = -m[size - 1][size - 1];
+        long long expected = (size < 61u) ? -(1ll << size) : -(1ll << 61);
+
+        for(std::size_t i = 1; i < size; ++i) {
+            for(std::size_t j = 0; j < size; ++j) {
+                m[i][j] += m[i - 1][j] * static_cast<long long>(i % 3);
+            }
+        }
+        m.swap_rows(0, size - 1);
+
+        ASSERT_EQ(m.det(), -expected);
+        ASSERT_EQ(matrix::modular_det(&m[0][0], size, size, 3u), -expected);
+    }
+
+    {
+        std::vector<long long> v{1ll << 40, 0, 0, 1ll << 40};
+        matrix::matrix_t<long long> m(2, 2, v.begin(), v.end());
+
+        ASSERT_THROW(m.det(), std::runtime_error);
+        ASSERT_THROW(matrix::modular_det(&m[0][0], 2, 2), std::runtime_error);
+    }
+}
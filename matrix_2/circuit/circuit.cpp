@@ -1,32 +1,28 @@
 #include "circuit.hpp"
 
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
 namespace circuit {
 
 /*---------------------------------------------------------------------------------
-                                CIRCUIT 
+                                CIRCUIT
 -----------------------------------------------------------------------------------*/
 
 
-circuit_t::circuit_t(const matrix::matrix_t<double>& resistance_matrix, const matrix::matrix_t<double>& eds_matrix, const matrix::matrix_t<int>& edges_matrix) {
-    
-    incidence_matrix_.resize(edges_matrix.get_rows_number(), edges_matrix.get_cols_number());
-    for(std::size_t i = 0, maxi = incidence_matrix_.get_rows_number(); i < maxi; ++i) {
-        for(std::size_t j = 0, maxj = incidence_matrix_.get_cols_number(); j < maxj; ++j) {
-            if(edges_matrix[i][j]) {
-                incidence_matrix_[i][j] = 1u;
-            }
-        }
-    }
+circuit_t::circuit_t(const matrix::matrix_t<double>& resistance_matrix, const matrix::matrix_t<double>& eds_matrix, const matrix::matrix_t<int>& edges_matrix) :
+        vertices_count_(edges_matrix.get_rows_number()) {
 
-    for(std::size_t i = 0, maxi = incidence_matrix_.get_cols_number(); i < maxi; ++i) {
+    for(std::size_t i = 0, maxi = edges_matrix.get_cols_number(); i < maxi; ++i) {
         std::size_t v1 = 0u, v2 = 0u;
 
-        bool flag = false;
-        for(std::size_t j = 0, maxj = incidence_matrix_.get_rows_number(); j < maxj; ++j) {
+        for(std::size_t j = 0, maxj = edges_matrix.get_rows_number(); j < maxj; ++j) {
             if(edges_matrix[j][i] == 1) {
-                v1 = j;    
+                v1 = j;
             }
-            
+
             else if (edges_matrix[j][i] == 2) {
                 v2 = j;
             }
@@ -43,156 +39,488 @@ circuit_t::circuit_t(const matrix::matrix_t<double>& resistance_matrix, const ma
         double eds = eds_matrix[v1][i];
 
         edges_.push_back({v1, v2, resistance, eds});
-        edges_.back().set_id(i);
     }
 }
 
-matrix::matrix_t<double> circuit_t::get_currents() const {
-    matrix::matrix_t<double> ret(incidence_matrix_.get_rows_number(), incidence_matrix_.get_cols_number());
-    for(std::size_t i = 0, maxi = ret.get_rows_number(); i < maxi; ++i) {
-        for(std::size_t j = 0, maxj = ret.get_cols_number(); j < maxj; ++j) {
-            ret[i][j] = (incidence_matrix_[i][j]) ? edges_[j].get_current() : 0.0;
+circuit_t::circuit_t(std::size_t vertices_count, const std::vector<branch_t>& branches) : vertices_count_(vertices_count) {
+    edges_.reserve(branches.size());
+    for(auto&& branch : branches) {
+        if((branch.v1 >= vertices_count) || (branch.v2 >= vertices_count)) {
+            throw std::runtime_error("circuit_t: branch vertex is out of circuit");
         }
+
+        edges_.push_back({branch.v1, branch.v2, branch.resistance, branch.eds});
+    }
+}
+
+matrix::matrix_t<double> circuit_t::get_currents() const {
+    matrix::matrix_t<double> ret(vertices_count_, edges_.size());
+    for(std::size_t j = 0, maxj = edges_.size(); j < maxj; ++j) {
+        ret[edges_[j].get_v1()][j] = edges_[j].get_current();
+        ret[edges_[j].get_v2()][j] = edges_[j].get_current();
     }
 
     return ret;
 }
 
-bool circuit_t::calculate_currents() {
-    std::vector<std::vector<edge_t>> independent_cycles = find_cycles();   
-    std::size_t independent_cycles_count = independent_cycles.size();
-#ifdef DEBUG
-    std::cout << "----------------------Independent cycles----------------------" << std::endl;
-    for(std::size_t i = 0; i < independent_cycles_count; ++i) {
-        std::cout << "[" << i << "]: ";
-        for(std::size_t j = 0, maxj = independent_cycles[i].size(); j < maxj; ++j) {
-            std::cout << independent_cycles[i][j].get_v1() << " -- " << independent_cycles[i][j].get_v2() << " ";
-        }
-        std::cout << std::endl;
-    }
-#endif 
-
-    matrix::matrix_t<double> system(incidence_matrix_.get_rows_number() + independent_cycles_count - 1, edges_.size());
-    matrix::matrix_t<double> right(system.get_rows_number(), 1);
-    
-    /*second rule*/
-    for(std::size_t i = 0, maxi = independent_cycles_count; i < maxi; ++i) {
-        edge_t prev_edge = independent_cycles[i].back();
-        double eds = 0.0;
-        float sign = 1.0;
-        for(std::size_t j = 0, maxj = independent_cycles[i].size(); j < maxj; ++j) {
-            edge_t curr_edge = independent_cycles[i][j];
-
-            std::size_t incidence_vertex = curr_edge.have_incident_vertex(prev_edge).value();
-
-            if((prev_edge.get_v1() == incidence_vertex) && (curr_edge.get_v1() == incidence_vertex)) {
-                sign *= -1.0;
-            } else if((prev_edge.get_v2() == incidence_vertex) && (curr_edge.get_v2() == incidence_vertex)) {
-                sign *= -1.0;
+std::vector<double> circuit_t::get_branch_currents() const {
+    std::vector<double> ret;
+    ret.reserve(edges_.size());
+    for(auto&& edge : edges_) {
+        ret.push_back(edge.get_current());
+    }
+
+    return ret;
+}
+
+bool circuit_t::calculate_currents(method_t method /* = method_t::nodal */) {
+    method_ = method;
+    nodal_.reset();
+
+    std::vector<double> currents;
+    bool solved = (method == method_t::nodal) && solve_nodal(currents);
+    if(!solved && !solve_tableau(currents)) {
+        return false;
+    }
+
+    set_currents(currents);
+    return true;
+}
+
+bool circuit_t::set_resistance(std::size_t branch, double resistance) {
+    if(branch >= edges_.size()) {
+        throw std::runtime_error("circuit_t::set_resistance: branch is out of circuit");
+    }
+
+    return update_branch(branch, resistance, edges_[branch].get_eds());
+}
+
+bool circuit_t::set_eds(std::size_t branch, double eds) {
+    if(branch >= edges_.size()) {
+        throw std::runtime_error("circuit_t::set_eds: branch is out of circuit");
+    }
+
+    return update_branch(branch, edges_[branch].get_resistance(), eds);
+}
+
+/*  G = G0 + U * D * U^T, by sherman-morrison-woodbury:
+
+        G^-1 * b = y - W * (I + D * U^T * W)^-1 * D * U^T * y,      y = G0^-1 * b,  W = G0^-1 * U
+
+    new update costs one cholesky solve for its column of W, and currents need one more solve
+    and k * k system, so it's O(nonzeros of L + k * n + k^3) instead of new factorization */
+bool circuit_t::update_branch(std::size_t branch, double resistance, double eds) {
+    edge_t& edge = edges_[branch];
+    double old_resistance = edge.get_resistance(), old_eds = edge.get_eds();
+    edge.set_resistance(resistance);
+    edge.set_eds(eds);
+
+    /* zero resistances define groups of vertices and tree, they can't be updated */
+    bool incremental = nodal_ && (old_resistance > 0.0) && (resistance > 0.0);
+    if(incremental && (old_resistance != resistance) && (nodal_->update_ends.size() >= max_updates)) {
+        incremental = false;
+    }
+
+    if(!incremental) {
+        return calculate_currents(method_);
+    }
+
+    nodal_state_t& state = *nodal_;
+    const std::size_t npos = matrix::sparse_cholesky_t<double>::npos;
+    std::size_t g1 = state.group[edge.get_v1()], g2 = state.group[edge.get_v2()];
+    if(g1 != g2) {
+        std::size_t p1 = state.potential[g1], p2 = state.potential[g2];
+        double drop = state.offset[edge.get_v1()] - state.offset[edge.get_v2()];
+        double delta_source = (eds + drop) / resistance - (old_eds + drop) / old_resistance;
+        if(p1 != npos) {
+            state.right[p1] -= delta_source;
+        }
+
+        if(p2 != npos) {
+            state.right[p2] += delta_source;
+        }
+
+        if(old_resistance != resistance) {
+            std::vector<double> u(state.right.size(), 0.0);
+            if(p1 != npos) {
+                u[p1] = 1.0;
+            }
+
+            if(p2 != npos) {
+                u[p2] = -1.0;
             }
 
-            system[i][curr_edge.get_id()] = curr_edge.get_resistance() * sign;
-            eds += curr_edge.get_eds() * sign;
-            prev_edge = curr_edge;
+            state.update_ends.push_back({p1, p2});
+            state.update_conductances.push_back(1.0 / resistance - 1.0 / old_resistance);
+            state.update_solutions.push_back(state.cholesky.solve(u));
         }
-        right[i][0] = eds;
     }
 
+    std::vector<double> currents;
+    nodal_currents(nodal_potentials(), currents);
+    set_currents(currents);
+    return true;
+}
+
+/*  unknowns are potentials of vertices, currents are expressed by them:
+
+        I_e = (phi_v1 - phi_v2 + eds_e) / R_e
+        sum(I_out) - sum(I_in) = 0              (first rule for every not grounded vertex)
+
+    conductance matrix is laplacian of circuit graph, it's positive definite after grounding, so it's
+    solved by sparse cholesky. Zero resistance branch fixes phi_v2 = phi_v1 + eds, its vertices share
+    one unknown, and its current is found from first rule on spanning tree of such branches */
+bool circuit_t::solve_nodal(std::vector<double>& currents) {
+    if(!factorize_nodal()) {
+        return false;
+    }
+
+    nodal_currents(nodal_potentials(), currents);
+    return true;
+}
+
+bool circuit_t::factorize_nodal() {
+    std::size_t edges_count = edges_.size();
+    const std::size_t npos = matrix::sparse_cholesky_t<double>::npos;
+
+    /* offset[v] - potential of v relative to representative of its group */
+    std::vector<std::size_t> group(vertices_count_);
+    std::iota(group.begin(), group.end(), 0u);
+    std::vector<double> offset(vertices_count_, 0.0); /* it's zero for representative */
+    std::vector<std::size_t> path;
+    auto find = [&](std::size_t v) {
+        path.clear();
+        for(; group[v] != v; v = group[v]) {
+            path.push_back(v);
+        }
 
-    /*first rule*/
-    for (std::size_t i = 1u, maxi = incidence_matrix_.get_rows_number(); i < maxi; ++i) {
-        for(std::size_t j = 0u, maxj = incidence_matrix_.get_cols_number(); j < maxj; ++j) {
-            if (incidence_matrix_[i][j]) {
-                if(edges_[j].get_v1() != edges_[j].get_v2()) {
-                    system[independent_cycles_count + i - 1][j] = ((edges_[j].get_v2() == i) ? 1.0 : -1.0);
-                } 
+        for(auto it = path.rbegin(); it != path.rend(); ++it) {
+            if(group[*it] != v) {
+                offset[*it] += offset[group[*it]];
             }
+            group[*it] = v;
+        }
+        return v;
+    };
+
+    std::vector<bool> tree(edges_count, false);
+    for(std::size_t e = 0; e < edges_count; ++e) {
+        const edge_t& edge = edges_[e];
+        if(edge.get_resistance() < 0.0) {
+            return false;
+        }
+
+        if(edge.get_resistance() > 0.0) {
+            continue;
+        }
+
+        std::size_t r1 = find(edge.get_v1()), r2 = find(edge.get_v2());
+        double o1 = offset[edge.get_v1()], o2 = offset[edge.get_v2()];
+        if(r1 == r2) {
+            /* cycle of ideal sources must be consistent, otherwise there is no solution */
+            if(std::abs(o1 + edge.get_eds() - o2) > matrix::tolerance) {
+                return false;
+            }
+            continue;
+        }
+
+        group[r2] = r1;
+        offset[r2] = o1 + edge.get_eds() - o2;
+        tree[e] = true;
+    }
+
+    for(std::size_t v = 0; v < vertices_count_; ++v) {
+        find(v);
+    }
+
+    std::vector<std::size_t> potential = potential_indices(0u, group);
+    std::size_t system_size = 0u;
+    for(std::size_t v = 0; v < vertices_count_; ++v) {
+        if((group[v] == v) && (potential[v] != npos)) {
+            ++system_size;
+        }
+    }
+
+    std::vector<matrix::triplet_t<double>> triplets;
+    triplets.reserve(4 * edges_count);
+    std::vector<double> right(system_size, 0.0);
+    for(auto&& edge : edges_) {
+        std::size_t g1 = group[edge.get_v1()], g2 = group[edge.get_v2()];
+        if((edge.get_resistance() == 0.0) || (g1 == g2)) {
+            continue;
+        }
+
+        double conductance = 1.0 / edge.get_resistance();
+        double source = (edge.get_eds() + offset[edge.get_v1()] - offset[edge.get_v2()]) * conductance;
+        std::size_t p1 = potential[g1], p2 = potential[g2];
+        if(p1 != npos) {
+            triplets.push_back({p1, p1, conductance});
+            right[p1] -= source;
+        }
+
+        if(p2 != npos) {
+            triplets.push_back({p2, p2, conductance});
+            right[p2] += source;
+        }
+
+        if((p1 != npos) && (p2 != npos)) {
+            triplets.push_back({p1, p2, -conductance});
+            triplets.push_back({p2, p1, -conductance});
         }
     }
+
+    matrix::csc_matrix_t<double> system(system_size, system_size, triplets);
 #ifdef DEBUG
-    std::cout << "----------------------System----------------------" << std::endl;
-    std::cout << "Left: " << std::endl;
-    std::cout << system << std::endl;
-    std::cout << "Right: " << std::endl;
-    std::cout << right << std::endl;
+    std::cout << "----------------------Nodal system----------------------" << std::endl;
+    std::cout << "Unknowns: " << system_size << ", nonzeros: " << system.get_nonzeros_number() << std::endl;
 #endif
-    auto ret = matrix::solve_linear_system(system, right);
-    if(ret.first.get_elements_number() == 0) {
+
+    matrix::sparse_cholesky_t<double> cholesky(system);
+    if(!cholesky.positive_definite()) {
         return false;
     }
 
-    for(std::size_t i = 0, maxi = ret.first.get_rows_number(); i < maxi; ++i) {
-        edges_[i].set_current(ret.first[i][0]);
+    /* branches of zero resistance tree by vertices */
+    std::vector<std::size_t> tree_ptr(vertices_count_ + 1, 0u);
+    for(std::size_t e = 0; e < edges_count; ++e) {
+        if(tree[e]) {
+            ++tree_ptr[edges_[e].get_v1() + 1];
+            ++tree_ptr[edges_[e].get_v2() + 1];
+        }
     }
 
-    return true;
-}
-
-std::vector<std::vector<circuit_t::edge_t>> circuit_t::find_cycles() const {
-    std::vector<std::vector<edge_t>> ret;
-    for(const auto& edge : edges_) {
-        auto cycle = dfs_cycle_handler(edge);
-        if(!cycle.empty()) {
-            ret.push_back(cycle);
+    std::partial_sum(tree_ptr.begin(), tree_ptr.end(), tree_ptr.begin());
+    std::vector<std::size_t> tree_edges(tree_ptr[vertices_count_]);
+    {
+        std::vector<std::size_t> position(tree_ptr.begin(), tree_ptr.end() - 1);
+        for(std::size_t e = 0; e < edges_count; ++e) {
+            if(tree[e]) {
+                tree_edges[position[edges_[e].get_v1()]++] = e;
+                tree_edges[position[edges_[e].get_v2()]++] = e;
+            }
         }
     }
 
-    return ret;
+    nodal_.emplace(nodal_state_t{std::move(group), std::move(offset), std::move(potential), std::move(tree_ptr),
+                                 std::move(tree_edges), std::move(tree), std::move(cholesky), std::move(right), {}, {}, {}});
+    return true;
 }
 
-std::vector<circuit_t::edge_t> circuit_t::dfs_cycle_handler(const edge_t& edge) const {
-    std::vector<edge_t> ret{edge};
-    dfs_cycle(edge.get_v1(), edge.get_v2(), ret);
-    return ret;
-}    
+std::vector<double> circuit_t::nodal_potentials() const {
+    const nodal_state_t& state = *nodal_;
+    const std::size_t npos = matrix::sparse_cholesky_t<double>::npos;
+    std::vector<double> solution = state.cholesky.solve(state.right);
+    std::size_t updates_count = state.update_ends.size();
+    if(updates_count == 0u) {
+        return solution;
+    }
 
+    /* U^T * x */
+    auto project = [&state, npos](std::size_t j, const std::vector<double>& x) {
+        auto [p1, p2] = state.update_ends[j];
+        return ((p1 == npos) ? 0.0 : x[p1]) - ((p2 == npos) ? 0.0 : x[p2]);
+    };
+
+    matrix::matrix_t<double> capacitance(updates_count, updates_count), right(updates_count, 1);
+    for(std::size_t i = 0; i < updates_count; ++i) {
+        double conductance = state.update_conductances[i];
+        right[i][0] = conductance * project(i, solution);
+        for(std::size_t j = 0; j < updates_count; ++j) {
+            capacitance[i][j] = ((i == j) ? 1.0 : 0.0) + conductance * project(i, state.update_solutions[j]);
+        }
+    }
 
-void circuit_t::dfs_cycle(std::size_t start_v, std::size_t current_v, std::vector<edge_t>& current_pass) const
-{
-    if((start_v == current_v) && (!current_pass.empty())) {
-        return;
+    matrix::matrix_t<double> correction = matrix::solve_linear_system(capacitance, right).first;
+    for(std::size_t j = 0; j < updates_count; ++j) {
+        const std::vector<double>& column = state.update_solutions[j];
+        for(std::size_t i = 0, maxi = solution.size(); i < maxi; ++i) {
+            solution[i] -= column[i] * correction[j][0];
+        }
     }
 
-    edge_t prev_edge = current_pass.back();
+    return solution;
+}
 
-    for(std::size_t i = 0, max = incidence_matrix_.get_cols_number(); i < max; ++i) {
-        /* if pass to i edge exist */
-        if(incidence_matrix_[current_v][i]) {
+void circuit_t::nodal_currents(const std::vector<double>& solution, std::vector<double>& currents) const {
+    const nodal_state_t& state = *nodal_;
+    std::size_t edges_count = edges_.size();
+    const std::size_t npos = matrix::sparse_cholesky_t<double>::npos;
+
+    auto phi = [&](std::size_t v) {
+        std::size_t p = state.potential[state.group[v]];
+        return ((p == npos) ? 0.0 : solution[p]) + state.offset[v];
+    };
+
+    /* balance[v] = sum(I_in) - sum(I_out) of branches with known current */
+    currents.assign(edges_count, 0.0);
+    std::vector<double> balance(vertices_count_, 0.0);
+    for(std::size_t e = 0; e < edges_count; ++e) {
+        const edge_t& edge = edges_[e];
+        if(!state.tree[e] && (edge.get_resistance() > 0.0)) {
+            currents[e] = (phi(edge.get_v1()) - phi(edge.get_v2()) + edge.get_eds()) / edge.get_resistance();
+            balance[edge.get_v1()] -= currents[e];
+            balance[edge.get_v2()] += currents[e];
+        }
+    }
 
-            /* check if we come from this edge */
-            if(prev_edge.get_id() == edges_[i].get_id()) {
-                continue;
-            }
+    /* currents of tree branches: from leaves to representative */
+    const auto& tree_ptr = state.tree_ptr;
+    const auto& tree_edges = state.tree_edges;
+    std::vector<std::size_t> parent_edge(vertices_count_, npos), order;
+    for(std::size_t root = 0; root < vertices_count_; ++root) {
+        if((state.group[root] != root) || (tree_ptr[root] == tree_ptr[root + 1])) {
+            continue;
+        }
 
-            /* check if we were here */
-            bool flag = false;
-            for(const auto& edge : current_pass) {
-                if(i == edge.get_id()) {
-                    flag = true;
-                    break;
+        order.assign(1u, root);
+        for(std::size_t k = 0; k < order.size(); ++k) {
+            std::size_t v = order[k];
+            for(std::size_t p = tree_ptr[v]; p < tree_ptr[v + 1]; ++p) {
+                std::size_t e = tree_edges[p];
+                std::size_t u = (edges_[e].get_v1() == v) ? edges_[e].get_v2() : edges_[e].get_v1();
+                if((e != parent_edge[v]) && (u != root) && (parent_edge[u] == npos)) {
+                    parent_edge[u] = e;
+                    order.push_back(u);
                 }
             }
-            if(flag) {
-                continue;
+        }
+
+        for(std::size_t k = order.size(); k-- > 1;) {
+            std::size_t v = order[k];
+            std::size_t e = parent_edge[v];
+            if(edges_[e].get_v1() == v) {
+                currents[e] = balance[v];
+                balance[edges_[e].get_v2()] += currents[e];
+            } else {
+                currents[e] = -balance[v];
+                balance[edges_[e].get_v1()] -= currents[e];
             }
+        }
+    }
+}
 
-            std::vector<edge_t> copy_pass = current_pass;
-            copy_pass.push_back(edges_[i]);
+/*  unknowns are currents of branches and potentials of not grounded vertices:
+
+        R_e * I_e - phi_v1 + phi_v2 = eds_e     (second rule for every branch)
+        sum(I_in) - sum(I_out) = 0              (first rule for every not grounded vertex)
+
+    matrix is symmetric [[R, A^T], [A, 0]] with 3 nonzeros per branch, but indefinite, so it's solved by sparse LU */
+bool circuit_t::solve_tableau(std::vector<double>& currents) const {
+    std::size_t edges_count = edges_.size();
+    std::vector<std::size_t> identity(vertices_count_);
+    std::iota(identity.begin(), identity.end(), 0u);
+    std::vector<std::size_t> potential = potential_indices(edges_count, identity);
+    std::size_t system_size = edges_count;
+    for(std::size_t index : potential) {
+        if(index != matrix::sparse_lu_t<double>::npos) {
+            ++system_size;
+        }
+    }
 
-            std::size_t next_v = (edges_[i].get_v1() == current_v) ? edges_[i].get_v2() : edges_[i].get_v1();
-            dfs_cycle(start_v, next_v, copy_pass);
+    std::vector<matrix::triplet_t<double>> triplets;
+    triplets.reserve(5 * edges_count);
+    std::vector<double> right(system_size, 0.0);
+    for(std::size_t e = 0; e < edges_count; ++e) {
+        const edge_t& edge = edges_[e];
+        right[e] = edge.get_eds();
+        if(edge.get_resistance() != 0.0) {
+            triplets.push_back({e, e, edge.get_resistance()});
+        }
 
-            if(!copy_pass.empty()) {
-                current_pass = copy_pass;
-                return;
-            }
+        /* potentials of self loop cancel each other */
+        if(edge.get_v1() == edge.get_v2()) {
+            continue;
+        }
+
+        std::size_t p1 = potential[edge.get_v1()], p2 = potential[edge.get_v2()];
+        if(p1 != matrix::sparse_lu_t<double>::npos) {
+            triplets.push_back({e, p1, -1.0});
+            triplets.push_back({p1, e, -1.0});
         }
 
+        if(p2 != matrix::sparse_lu_t<double>::npos) {
+            triplets.push_back({e, p2, 1.0});
+            triplets.push_back({p2, e, 1.0});
+        }
     }
 
-    /* didn't find independent cycle */
-    current_pass = std::vector<edge_t>();
-    return;
+    matrix::csc_matrix_t<double> system(system_size, system_size, triplets);
+#ifdef DEBUG
+    std::cout << "----------------------Tableau system----------------------" << std::endl;
+    std::cout << "Unknowns: " << system_size << ", nonzeros: " << system.get_nonzeros_number() << std::endl;
+#endif
+
+    std::vector<double> solution;
+    matrix::sparse_lu_t<double> lu(system);
+    if(!lu.singular()) {
+        solution = lu.solve(right);
+    } else if(!solve_dense(system, right, solution)) {
+        return false;
+    }
+
+    currents.assign(solution.begin(), solution.begin() + edges_count);
+    return true;
+}
+
+/* currents below rounding error of the biggest one are zero */
+void circuit_t::set_currents(const std::vector<double>& currents) {
+    double max_current = 0.0;
+    for(double current : currents) {
+        max_current = std::max(max_current, std::abs(current));
+    }
+    double roundoff = rounding_factor * std::numeric_limits<double>::epsilon() * max_current;
+
+    for(std::size_t e = 0, maxe = edges_.size(); e < maxe; ++e) {
+        edges_[e].set_current((std::abs(currents[e]) > roundoff) ? currents[e] : 0.0);
+    }
+}
+
+std::vector<std::size_t> circuit_t::potential_indices(std::size_t first_index, const std::vector<std::size_t>& group) const {
+    std::vector<std::size_t> parent(group);
+    auto find = [&parent](std::size_t v) {
+        while(parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+
+    for(auto&& edge : edges_) {
+        parent[find(edge.get_v1())] = find(edge.get_v2());
+    }
+
+    std::vector<std::size_t> ret(vertices_count_, matrix::sparse_lu_t<double>::npos);
+    for(std::size_t v = 0; v < vertices_count_; ++v) {
+        if((group[v] == v) && (find(v) != v)) {
+            ret[v] = first_index++;
+        }
+    }
+
+    return ret;
+}
+
+/* singular system still can be joint (e.g. cycle of zero resistances without eds), gauss finds partial solution */
+bool circuit_t::solve_dense(const matrix::csc_matrix_t<double>& system, const std::vector<double>& right, std::vector<double>& solution) const {
+    if(system.get_rows_number() > dense_fallback_limit) {
+        return false;
+    }
+
+    matrix::matrix_t<double> right_col(right.size(), 1);
+    for(std::size_t i = 0, maxi = right.size(); i < maxi; ++i) {
+        right_col[i][0] = right[i];
+    }
+
+    auto ret = matrix::solve_linear_system(system.to_dense(), right_col);
+    if(ret.first.get_elements_number() == 0) {
+        return false;
+    }
+
+    solution.resize(right.size());
+    for(std::size_t i = 0, maxi = right.size(); i < maxi; ++i) {
+        solution[i] = ret.first[i][0];
+    }
+
+    return true;
 }
 
-} /* namespace circuit */
\ No newline at end of file
+} /* namespace circuit */
@@ -2,20 +2,52 @@
 
 #include <iostream>
 #include <vector>
+#include <utility>
 #include <optional>
 #include "../matrix/matrix.hpp"
+#include "../matrix/sparse_lu.hpp"
+#include "../matrix/sparse_cholesky.hpp"
 
 namespace circuit {
 
+/* branch v1 -- v2, positive current flows from v1 to v2, eds rises potential in the same direction */
+struct branch_t {
+    std::size_t v1;
+    std::size_t v2;
+    double resistance;
+    double eds;
+};
+
 /*---------------------------------------------------------------------------------
-                                CIRCUIT 
+                                CIRCUIT
 -----------------------------------------------------------------------------------*/
 
+/*  nodal: potentials of vertices with symmetric positive definite conductance matrix, zero resistance
+            branches join their vertices, fails on negative resistances and conflicting ideal sources
+    tableau: currents and potentials together, any circuit, about 3 times more unknowns */
+enum class method_t {
+    nodal,
+    tableau
+};
+
 class circuit_t final {
 public:
     circuit_t(const matrix::matrix_t<double>& resistance_matrix, const matrix::matrix_t<double>& eds_matrix, const matrix::matrix_t<int>& edges_matrix);
-    bool calculate_currents();
+    circuit_t(std::size_t vertices_count, const std::vector<branch_t>& branches);
+
+    /* nodal method falls back to tableau, if it can't be applied */
+    bool calculate_currents(method_t method = method_t::nodal);
+
+    /*  change of one branch after calculate_currents: nodal factorization is kept, new resistance is
+        rank one update of it (sherman-morrison-woodbury), new eds changes only right side, so currents are
+        updated by a few triangular solves. Full solve is done, if zero resistance branches change or
+        there is no nodal factorization */
+    bool set_resistance(std::size_t branch, double resistance);
+    bool set_eds(std::size_t branch, double eds);
+
+    /* vertices * branches matrix, current of branch is written in rows of its vertices */
     matrix::matrix_t<double> get_currents() const;
+    std::vector<double> get_branch_currents() const;
 
 private:
 
@@ -25,19 +57,10 @@ private:
         edge_t(std::size_t v1, std::size_t v2, double resistance, double eds, double current = 0.0) :
             v1_(v1), v2_(v2), resistance_(resistance), eds_(eds), current_(current) {}
 
-        void set_id(std::size_t id) {id_ = id;} 
         void set_current(double current) {current_ = current;}
+        void set_resistance(double resistance) {resistance_ = resistance;}
+        void set_eds(double eds) {eds_ = eds;}
 
-        std::optional<std::size_t> have_incident_vertex(const edge_t& rhs) {
-            if      (get_v1() == rhs.get_v1()) { return get_v1(); }
-            else if (get_v1() == rhs.get_v2()) { return get_v2(); }
-            else if (get_v2() == rhs.get_v1()) { return get_v2(); }
-            else if (get_v2() == rhs.get_v2()) { return get_v2(); }  
-
-            return std::optional<std::size_t>();
-        }
-
-        std::size_t get_id() const {return id_;}
         std::size_t get_v1() const {return v1_;}
         std::size_t get_v2() const {return v2_;}
         double get_current() const {return current_;}
@@ -45,7 +68,6 @@ private:
         double get_eds() const {return eds_;}
 
     private:
-        std::size_t id_;
         std::size_t v1_, v2_;
         double resistance_;
         double eds_;
@@ -53,13 +75,51 @@ private:
     };
 
 private:
-    std::vector<std::vector<edge_t>> find_cycles() const;       
-    std::vector<edge_t> dfs_cycle_handler(const edge_t& edge) const;     
-    void dfs_cycle(std::size_t start_v, std::size_t current_v, std::vector<edge_t>& current_pass) const;
+    /* systems up to this size are solved by dense gauss, if sparse LU meets singular matrix */
+    static constexpr std::size_t dense_fallback_limit = 2000u;
+
+    /* relative error of currents in units of machine epsilon, smaller currents are printed as zero */
+    static constexpr double rounding_factor = 256.0;
+
+    /* G0 is factorized conductance matrix, G = G0 + U * D * U^T, column j of U is e_p1 - e_p2 of updated branch */
+    struct nodal_state_t {
+        std::vector<std::size_t> group;         /* representative of vertices joined by zero resistances */
+        std::vector<double> offset;             /* potential relative to representative */
+        std::vector<std::size_t> potential;     /* unknown of representative, npos if grounded */
+        std::vector<std::size_t> tree_ptr;      /* zero resistance spanning tree, branches of vertex v */
+        std::vector<std::size_t> tree_edges;    /* are tree_edges[tree_ptr[v] .. tree_ptr[v + 1]) */
+        std::vector<bool> tree;
+        matrix::sparse_cholesky_t<double> cholesky;
+        std::vector<double> right;
+
+        std::vector<std::pair<std::size_t, std::size_t>> update_ends;
+        std::vector<double> update_conductances;
+        std::vector<std::vector<double>> update_solutions; /* G0^-1 * U */
+    };
+
+    /* updates after which G is factorized again */
+    static constexpr std::size_t max_updates = 32u;
+
+    bool solve_nodal(std::vector<double>& currents);
+    bool factorize_nodal();
+    std::vector<double> nodal_potentials() const;
+    void nodal_currents(const std::vector<double>& solution, std::vector<double>& currents) const;
+    bool update_branch(std::size_t branch, double resistance, double eds);
+
+    bool solve_tableau(std::vector<double>& currents) const;
+    void set_currents(const std::vector<double>& currents);
+
+    /*  index of potential of vertex group in system, group[v] - representative of vertex v,
+        one group of every connected component is grounded (npos) */
+    std::vector<std::size_t> potential_indices(std::size_t first_index, const std::vector<std::size_t>& group) const;
+    bool solve_dense(const matrix::csc_matrix_t<double>& system, const std::vector<double>& right, std::vector<double>& solution) const;
 
 private:
     std::vector<edge_t> edges_;
-    matrix::matrix_t<int> incidence_matrix_;    
+    std::size_t vertices_count_;
+
+    method_t method_ = method_t::nodal;
+    std::optional<nodal_state_t> nodal_;
 };
 
-} /* namespace circuit */ 
\ No newline at end of file
+} /* namespace circuit */
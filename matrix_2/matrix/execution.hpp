@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace matrix {
+
+/* fixed number of worker threads executing tasks from common queue */
+class thread_pool_t final {
+public:
+    explicit thread_pool_t(std::size_t threads_count = std::thread::hardware_concurrency());
+    thread_pool_t(const thread_pool_t&) = delete;
+    thread_pool_t& operator=(const thread_pool_t&) = delete;
+    ~thread_pool_t();
+
+    void submit(std::function<void()> task);
+
+    /* workers and the calling thread */
+    std::size_t get_threads_number() const {return workers_.size() + 1;}
+
+    /*  call func(i) for every i from [0, count), calling thread takes part in it too,
+        so parallel_for can be called from tasks of the same pool.
+        First exception thrown by func is rethrown after all calls are finished */
+    template<typename F>
+    void parallel_for(std::size_t count, F func);
+
+private:
+    void work();
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+};
+
+/*  how matrix operations are executed: sequentially (default) or on thread pool.
+    Work is split into the same tiles regardless of threads number,
+    so results don't depend on policy */
+class execution_policy_t final {
+public:
+    execution_policy_t() = default;
+    explicit execution_policy_t(thread_pool_t& pool) : pool_(&pool) {}
+
+    std::size_t get_threads_number() const {return pool_ ? pool_->get_threads_number() : 1u;}
+
+    template<typename F>
+    void parallel_for(std::size_t count, F func) const;
+
+    /* func(row_begin, row_end, col_begin, col_end) for every tile of rows * cols area */
+    template<typename F>
+    void parallel_for_tiles(std::size_t rows, std::size_t cols, std::size_t tile_rows, std::size_t tile_cols, F func) const;
+
+private:
+    thread_pool_t* pool_ = nullptr;
+};
+
+inline const execution_policy_t sequential_policy{};
+
+/* tiles of parallel elementwise and row operations */
+const std::size_t tile_rows = 64u;
+const std::size_t tile_cols = 256u;
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+inline thread_pool_t::thread_pool_t(std::size_t threads_count /* = std::thread::hardware_concurrency() */) {
+    for(std::size_t i = 1; i < threads_count; ++i) {
+        workers_.emplace_back(&thread_pool_t::work, this);
+    }
+}
+
+inline thread_pool_t::~thread_pool_t() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+
+    condition_.notify_all();
+    for(auto&& worker : workers_) {
+        worker.join();
+    }
+}
+
+inline void thread_pool_t::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push(std::move(task));
+    }
+
+    condition_.notify_one();
+}
+
+inline void thread_pool_t::work() {
+    for(;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() {return stop_ || !tasks_.empty();});
+            if(stop_ && tasks_.empty()) {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+
+        task();
+    }
+}
+
+template<typename F>
+void thread_pool_t::parallel_for(std::size_t count, F func) {
+    /* state is shared with helpers, they can start after parallel_for has returned */
+    struct state_t {
+        std::atomic<std::size_t> next{0u};
+        std::size_t done = 0u;
+        std::exception_ptr exception;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<state_t>();
+
+    /* helpers take indexes one by one, so tasks of different cost are balanced */
+    auto run = [state, count, &func]() {
+        std::size_t done = 0u;
+        std::exception_ptr exception;
+        for(std::size_t i = state->next++; i < count; i = state->next++, ++done) {
+            try {
+                func(i);
+            } catch(...) {
+                exception = std::current_exception();
+            }
+        }
+
+        if(done) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done += done;
+            if(exception && !state->exception) {
+                state->exception = exception;
+            }
+
+            if(state->done == count) {
+                state->finished.notify_one();
+            }
+        }
+    };
+
+    for(std::size_t i = 0, helpers = std::min(workers_.size(), count ? count - 1 : 0u); i < helpers; ++i) {
+        submit(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&]() {return state->done == count;});
+    if(state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+template<typename F>
+void execution_policy_t::parallel_for(std::size_t count, F func) const {
+    if(pool_ && (count > 1u)) {
+        pool_->parallel_for(count, func);
+        return;
+    }
+
+    for(std::size_t i = 0; i < count; ++i) {
+        func(i);
+    }
+}
+
+template<typename F>
+void execution_policy_t::parallel_for_tiles(std::size_t rows, std::size_t cols, std::size_t tile_rows, std::size_t tile_cols, F func) const {
+    std::size_t tiles_rows = (rows + tile_rows - 1) / tile_rows;
+    std::size_t tiles_cols = (cols + tile_cols - 1) / tile_cols;
+
+    parallel_for(tiles_rows * tiles_cols, [&](std::size_t tile) {
+        std::size_t row_begin = (tile / tiles_cols) * tile_rows;
+        std::size_t col_begin = (tile % tiles_cols) * tile_cols;
+        func(row_begin, std::min(row_begin + tile_rows, rows), col_begin, std::min(col_begin + tile_cols, cols));
+    });
+}
+
+} /* namespace matrix */
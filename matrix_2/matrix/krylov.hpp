@@ -0,0 +1,585 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "matrix.hpp"
+#include "sparse.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+/*
+    ***iterative krylov solvers of A * x = b***
+
+    A is dense matrix_t, csr_matrix_t or csc_matrix_t, only products A * v are used, so cost of
+    iteration is one product and a few vector operations. Iterations stop, when relative residual
+    ||b - A * x|| / ||b|| is not greater than tolerance, or after max_iterations products.
+
+        conjugate_gradient - A is symmetric positive definite, preconditioner too
+        bicgstab           - any nonsingular A, can break down (converged = false)
+        gmres              - any nonsingular A, memory is restart vectors
+
+    preconditioner M ~ A is applied as z = M^-1 * r: jacobi (diagonal), ilu0 / ic0 (incomplete LU / cholesky
+    on pattern of A, no fill). Dense matrices are converted to csr for ilu0 and ic0.
+    Work vectors are allocated once per solve, not on every iteration
+*/
+
+struct krylov_options_t {
+    double tolerance = 1e-10;
+    std::size_t max_iterations = 1000u;
+    std::size_t restart = 30u; /* gmres only */
+};
+
+template<typename T>
+struct krylov_result_t {
+    std::vector<T> x;
+    bool converged = false;
+    std::size_t iterations = 0u;
+    T residual{}; /* relative residual of x */
+};
+
+template<typename T>
+class identity_preconditioner_t final {
+public:
+    void apply(const std::vector<T>& r, std::vector<T>& z) const {z = r;}
+};
+
+template<typename T>
+class jacobi_preconditioner_t final {
+public:
+    explicit jacobi_preconditioner_t(const csr_matrix_t<T>& m);
+    explicit jacobi_preconditioner_t(const matrix_t<T>& m);
+
+    void apply(const std::vector<T>& r, std::vector<T>& z) const;
+
+private:
+    std::vector<T> inverse_diagonal_;
+};
+
+/* L * U on pattern of A, L has unit diagonal, throws on zero pivot */
+template<typename T>
+class ilu0_preconditioner_t final {
+public:
+    explicit ilu0_preconditioner_t(const csr_matrix_t<T>& m);
+    explicit ilu0_preconditioner_t(const matrix_t<T>& m) : ilu0_preconditioner_t(csr_matrix_t<T>(m)) {}
+
+    void apply(const std::vector<T>& r, std::vector<T>& z) const;
+
+private:
+    csr_matrix_t<T> lu_;
+    std::vector<std::size_t> diagonal_; /* position of diagonal in every row */
+};
+
+/* L * L^T on pattern of lower triangle of symmetric A, throws on not positive pivot */
+template<typename T>
+class ic0_preconditioner_t final {
+public:
+    explicit ic0_preconditioner_t(const csr_matrix_t<T>& m);
+    explicit ic0_preconditioner_t(const matrix_t<T>& m) : ic0_preconditioner_t(csr_matrix_t<T>(m)) {}
+
+    void apply(const std::vector<T>& r, std::vector<T>& z) const;
+
+private:
+    csr_matrix_t<T> lower_; /* diagonal is last in row */
+};
+
+template<typename Matrix, typename T, typename Preconditioner = identity_preconditioner_t<T>>
+krylov_result_t<T> conjugate_gradient(const Matrix& a, const std::vector<T>& b, const Preconditioner& preconditioner = {},
+                                      const krylov_options_t& options = {}, const execution_policy_t& policy = sequential_policy);
+
+template<typename Matrix, typename T, typename Preconditioner = identity_preconditioner_t<T>>
+krylov_result_t<T> bicgstab(const Matrix& a, const std::vector<T>& b, const Preconditioner& preconditioner = {},
+                            const krylov_options_t& options = {}, const execution_policy_t& policy = sequential_policy);
+
+/* right preconditioned: residual is residual of original system */
+template<typename Matrix, typename T, typename Preconditioner = identity_preconditioner_t<T>>
+krylov_result_t<T> gmres(const Matrix& a, const std::vector<T>& b, const Preconditioner& preconditioner = {},
+                         const krylov_options_t& options = {}, const execution_policy_t& policy = sequential_policy);
+
+namespace detail {
+
+/* rows of dense matrix * vector product taken by one task */
+constexpr std::size_t gemv_chunk = 64u;
+
+/* y = A * x */
+template<typename T>
+void apply(const matrix_t<T>& a, const std::vector<T>& x, std::vector<T>& y, const execution_policy_t& policy) {
+    if(x.size() != a.get_cols_number()) {
+        throw std::runtime_error("krylov solver: invalid vector size");
+    }
+
+    std::size_t rows = a.get_rows_number(), cols = a.get_cols_number();
+    y.resize(rows);
+    policy.parallel_for((rows + gemv_chunk - 1) / gemv_chunk, [&](std::size_t chunk) {
+        for(std::size_t i = chunk * gemv_chunk, maxi = std::min(i + gemv_chunk, rows); i < maxi; ++i) {
+            const T* row = &a[i][0];
+            T sum{};
+            for(std::size_t j = 0; j < cols; ++j) {
+                sum += row[j] * x[j];
+            }
+            y[i] = sum;
+        }
+    });
+}
+
+template<typename T>
+void apply(const csr_matrix_t<T>& a, const std::vector<T>& x, std::vector<T>& y, const execution_policy_t& policy) {
+    a.multiply(x, y, policy);
+}
+
+template<typename T>
+void apply(const csc_matrix_t<T>& a, const std::vector<T>& x, std::vector<T>& y, const execution_policy_t&) {
+    a.multiply(x, y);
+}
+
+template<typename T>
+T dot(const std::vector<T>& lhs, const std::vector<T>& rhs) {
+    T ret{};
+    for(std::size_t i = 0, maxi = lhs.size(); i < maxi; ++i) {
+        ret += lhs[i] * rhs[i];
+    }
+
+    return ret;
+}
+
+template<typename T>
+T norm(const std::vector<T>& v) {
+    return std::sqrt(dot(v, v));
+}
+
+/* y += alpha * x */
+template<typename T>
+void axpy(T alpha, const std::vector<T>& x, std::vector<T>& y) {
+    for(std::size_t i = 0, maxi = y.size(); i < maxi; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+template<typename Matrix, typename T>
+void check_system(const Matrix& a, const std::vector<T>& b) {
+    if((a.get_rows_number() != a.get_cols_number()) || (a.get_rows_number() != b.size())) {
+        throw std::runtime_error("krylov solver: matrix must be square and match right side");
+    }
+}
+
+} /* namespace detail */
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+jacobi_preconditioner_t<T>::jacobi_preconditioner_t(const csr_matrix_t<T>& m) : inverse_diagonal_(m.get_rows_number(), T{}) {
+    const auto& ptr = m.get_row_ptr();
+    const auto& idx = m.get_col_idx();
+    const auto& values = m.get_values();
+    for(std::size_t i = 0, maxi = m.get_rows_number(); i < maxi; ++i) {
+        for(std::size_t p = ptr[i]; p < ptr[i + 1]; ++p) {
+            if(idx[p] == i) {
+                inverse_diagonal_[i] = values[p];
+            }
+        }
+    }
+
+    for(auto&& elem : inverse_diagonal_) {
+        if(elem == T{}) {
+            throw std::runtime_error("jacobi_preconditioner_t: zero diagonal element");
+        }
+        elem = T{1} / elem;
+    }
+}
+
+template<typename T>
+jacobi_preconditioner_t<T>::jacobi_preconditioner_t(const matrix_t<T>& m) : inverse_diagonal_(m.get_rows_number()) {
+    for(std::size_t i = 0, maxi = m.get_rows_number(); i < maxi; ++i) {
+        if(m[i][i] == T{}) {
+            throw std::runtime_error("jacobi_preconditioner_t: zero diagonal element");
+        }
+        inverse_diagonal_[i] = T{1} / m[i][i];
+    }
+}
+
+template<typename T>
+void jacobi_preconditioner_t<T>::apply(const std::vector<T>& r, std::vector<T>& z) const {
+    z.resize(r.size());
+    for(std::size_t i = 0, maxi = r.size(); i < maxi; ++i) {
+        z[i] = inverse_diagonal_[i] * r[i];
+    }
+}
+
+/* ikj gaussian elimination restricted to pattern: row i is updated by rows k < i of its pattern */
+template<typename T>
+ilu0_preconditioner_t<T>::ilu0_preconditioner_t(const csr_matrix_t<T>& m) : lu_(m), diagonal_(m.get_rows_number()) {
+    std::size_t n = m.get_rows_number();
+    const auto& ptr = lu_.get_row_ptr();
+    const auto& idx = lu_.get_col_idx();
+    std::vector<T> values = lu_.get_values();
+
+    for(std::size_t i = 0; i < n; ++i) {
+        auto first = idx.begin() + ptr[i], last = idx.begin() + ptr[i + 1];
+        auto diagonal = std::lower_bound(first, last, i);
+        if((diagonal == last) || (*diagonal != i)) {
+            throw std::runtime_error("ilu0_preconditioner_t: zero diagonal element");
+        }
+        diagonal_[i] = diagonal - idx.begin();
+    }
+
+    std::vector<std::size_t> position(n, n);
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t p = ptr[i]; p < ptr[i + 1]; ++p) {
+            position[idx[p]] = p;
+        }
+
+        for(std::size_t p = ptr[i]; p < diagonal_[i]; ++p) {
+            std::size_t k = idx[p];
+            values[p] /= values[diagonal_[k]];
+            for(std::size_t q = diagonal_[k] + 1; q < ptr[k + 1]; ++q) {
+                if(position[idx[q]] != n) {
+                    values[position[idx[q]]] -= values[p] * values[q];
+                }
+            }
+        }
+
+        if(values[diagonal_[i]] == T{}) {
+            throw std::runtime_error("ilu0_preconditioner_t: zero pivot");
+        }
+
+        for(std::size_t p = ptr[i]; p < ptr[i + 1]; ++p) {
+            position[idx[p]] = n;
+        }
+    }
+
+    std::vector<triplet_t<T>> triplets;
+    triplets.reserve(values.size());
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t p = ptr[i]; p < ptr[i + 1]; ++p) {
+            triplets.push_back({i, idx[p], values[p]});
+        }
+    }
+    lu_ = csr_matrix_t<T>(n, n, triplets);
+}
+
+template<typename T>
+void ilu0_preconditioner_t<T>::apply(const std::vector<T>& r, std::vector<T>& z) const {
+    std::size_t n = r.size();
+    const auto& ptr = lu_.get_row_ptr();
+    const auto& idx = lu_.get_col_idx();
+    const auto& values = lu_.get_values();
+
+    z = r;
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t p = ptr[i]; p < diagonal_[i]; ++p) {
+            z[i] -= values[p] * z[idx[p]];
+        }
+    }
+
+    for(std::size_t i = n; i-- > 0;) {
+        for(std::size_t p = diagonal_[i] + 1; p < ptr[i + 1]; ++p) {
+            z[i] -= values[p] * z[idx[p]];
+        }
+        z[i] /= values[diagonal_[i]];
+    }
+}
+
+/* row i of L: L(i, k) = (A(i, k) - L(i, :) * L(k, :)) / L(k, k) for k of pattern, sparse dot of sorted rows */
+template<typename T>
+ic0_preconditioner_t<T>::ic0_preconditioner_t(const csr_matrix_t<T>& m) {
+    std::size_t n = m.get_rows_number();
+    std::vector<triplet_t<T>> triplets;
+    {
+        const auto& ptr = m.get_row_ptr();
+        const auto& idx = m.get_col_idx();
+        const auto& values = m.get_values();
+        for(std::size_t i = 0; i < n; ++i) {
+            for(std::size_t p = ptr[i]; p < ptr[i + 1]; ++p) {
+                if(idx[p] <= i) {
+                    triplets.push_back({i, idx[p], values[p]});
+                }
+            }
+        }
+    }
+
+    csr_matrix_t<T> lower(n, n, triplets);
+    const auto& ptr = lower.get_row_ptr();
+    const auto& idx = lower.get_col_idx();
+    std::vector<T> values = lower.get_values();
+    for(std::size_t i = 0; i < n; ++i) {
+        if((ptr[i] == ptr[i + 1]) || (idx[ptr[i + 1] - 1] != i)) {
+            throw std::runtime_error("ic0_preconditioner_t: zero diagonal element");
+        }
+
+        for(std::size_t p = ptr[i]; p < ptr[i + 1]; ++p) {
+            std::size_t k = idx[p];
+            T sum = values[p];
+            for(std::size_t pi = ptr[i], pk = ptr[k]; (pi < p) && (pk + 1 < ptr[k + 1]);) {
+                if(idx[pi] < idx[pk]) {
+                    ++pi;
+                } else if(idx[pk] < idx[pi]) {
+                    ++pk;
+                } else {
+                    sum -= values[pi++] * values[pk++];
+                }
+            }
+
+            if(k < i) {
+                values[p] = sum / values[ptr[k + 1] - 1];
+            } else if(sum > T{}) {
+                values[p] = std::sqrt(sum);
+            } else {
+                throw std::runtime_error("ic0_preconditioner_t: matrix isn't positive definite");
+            }
+        }
+    }
+
+    triplets.clear();
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t p = ptr[i]; p < ptr[i + 1]; ++p) {
+            triplets.push_back({i, idx[p], values[p]});
+        }
+    }
+    lower_ = csr_matrix_t<T>(n, n, triplets);
+}
+
+template<typename T>
+void ic0_preconditioner_t<T>::apply(const std::vector<T>& r, std::vector<T>& z) const {
+    std::size_t n = r.size();
+    const auto& ptr = lower_.get_row_ptr();
+    const auto& idx = lower_.get_col_idx();
+    const auto& values = lower_.get_values();
+
+    /* L * y = r by rows, L^T * z = y by columns of L^T (rows of L) */
+    z = r;
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t p = ptr[i]; p + 1 < ptr[i + 1]; ++p) {
+            z[i] -= values[p] * z[idx[p]];
+        }
+        z[i] /= values[ptr[i + 1] - 1];
+    }
+
+    for(std::size_t i = n; i-- > 0;) {
+        z[i] /= values[ptr[i + 1] - 1];
+        for(std::size_t p = ptr[i]; p + 1 < ptr[i + 1]; ++p) {
+            z[idx[p]] -= values[p] * z[i];
+        }
+    }
+}
+
+template<typename Matrix, typename T, typename Preconditioner>
+krylov_result_t<T> conjugate_gradient(const Matrix& a, const std::vector<T>& b, const Preconditioner& preconditioner /* = {} */,
+                                      const krylov_options_t& options /* = {} */, const execution_policy_t& policy /* = sequential_policy */) {
+    detail::check_system(a, b);
+    krylov_result_t<T> ret;
+    ret.x.assign(b.size(), T{});
+
+    T b_norm = detail::norm(b);
+    if(b_norm == T{}) {
+        ret.converged = true;
+        return ret;
+    }
+
+    std::vector<T> r(b), z, q;
+    preconditioner.apply(r, z);
+    std::vector<T> p(z);
+    T rz = detail::dot(r, z);
+    ret.residual = T{1};
+
+    while((ret.iterations < options.max_iterations) && (ret.residual > options.tolerance)) {
+        detail::apply(a, p, q, policy);
+        T pq = detail::dot(p, q);
+        if(pq == T{}) {
+            break;
+        }
+
+        T alpha = rz / pq;
+        detail::axpy(alpha, p, ret.x);
+        detail::axpy(-alpha, q, r);
+        ++ret.iterations;
+
+        ret.residual = detail::norm(r) / b_norm;
+        preconditioner.apply(r, z);
+        T rz_next = detail::dot(r, z);
+        T beta = rz_next / rz;
+        rz = rz_next;
+        for(std::size_t i = 0, maxi = p.size(); i < maxi; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+
+    ret.converged = (ret.residual <= options.tolerance);
+    return ret;
+}
+
+template<typename Matrix, typename T, typename Preconditioner>
+krylov_result_t<T> bicgstab(const Matrix& a, const std::vector<T>& b, const Preconditioner& preconditioner /* = {} */,
+                            const krylov_options_t& options /* = {} */, const execution_policy_t& policy /* = sequential_policy */) {
+    detail::check_system(a, b);
+    krylov_result_t<T> ret;
+    std::size_t n = b.size();
+    ret.x.assign(n, T{});
+
+    T b_norm = detail::norm(b);
+    if(b_norm == T{}) {
+        ret.converged = true;
+        return ret;
+    }
+
+    std::vector<T> r(b), r_hat(b), p(n, T{}), v(n, T{}), s(n), y, z, t;
+    T rho = T{1}, alpha = T{1}, omega = T{1};
+    ret.residual = T{1};
+
+    while((ret.iterations < options.max_iterations) && (ret.residual > options.tolerance)) {
+        T rho_next = detail::dot(r_hat, r);
+        if(rho_next == T{}) {
+            break; /* breakdown */
+        }
+
+        T beta = (rho_next / rho) * (alpha / omega);
+        rho = rho_next;
+        for(std::size_t i = 0; i < n; ++i) {
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        }
+
+        preconditioner.apply(p, y);
+        detail::apply(a, y, v, policy);
+        T r_hat_v = detail::dot(r_hat, v);
+        if(r_hat_v == T{}) {
+            break;
+        }
+
+        alpha = rho / r_hat_v;
+        for(std::size_t i = 0; i < n; ++i) {
+            s[i] = r[i] - alpha * v[i];
+        }
+        detail::axpy(alpha, y, ret.x);
+        ++ret.iterations;
+
+        ret.residual = detail::norm(s) / b_norm;
+        if(ret.residual <= options.tolerance) {
+            break;
+        }
+
+        preconditioner.apply(s, z);
+        detail::apply(a, z, t, policy);
+        T tt = detail::dot(t, t);
+        if(tt == T{}) {
+            break;
+        }
+
+        omega = detail::dot(t, s) / tt;
+        detail::axpy(omega, z, ret.x);
+        for(std::size_t i = 0; i < n; ++i) {
+            r[i] = s[i] - omega * t[i];
+        }
+
+        ret.residual = detail::norm(r) / b_norm;
+        if(omega == T{}) {
+            break;
+        }
+    }
+
+    ret.converged = (ret.residual <= options.tolerance);
+    return ret;
+}
+
+/*  arnoldi basis of K(A * M^-1, r) of restart size, givens rotations keep hessenberg matrix triangular,
+    so residual norm of least squares problem is known on every step without solving it */
+template<typename Matrix, typename T, typename Preconditioner>
+krylov_result_t<T> gmres(const Matrix& a, const std::vector<T>& b, const Preconditioner& preconditioner /* = {} */,
+                         const krylov_options_t& options /* = {} */, const execution_policy_t& policy /* = sequential_policy */) {
+    detail::check_system(a, b);
+    krylov_result_t<T> ret;
+    std::size_t n = b.size();
+    std::size_t m = std::max<std::size_t>(std::min(options.restart, n), 1u);
+    ret.x.assign(n, T{});
+
+    T b_norm = detail::norm(b);
+    if(b_norm == T{}) {
+        ret.converged = true;
+        return ret;
+    }
+
+    std::vector<std::vector<T>> basis(m + 1);
+    matrix_t<T> h(m + 1, m);
+    std::vector<T> cs(m), sn(m), g(m + 1);
+    std::vector<T> r(b), w, z, update;
+    ret.residual = T{1};
+
+    while((ret.iterations < options.max_iterations) && (ret.residual > options.tolerance)) {
+        T beta = detail::norm(r);
+        basis[0] = r;
+        for(auto&& elem : basis[0]) {
+            elem /= beta;
+        }
+        std::fill(g.begin(), g.end(), T{});
+        g[0] = beta;
+
+        std::size_t k = 0;
+        for(; (k < m) && (ret.iterations < options.max_iterations); ++k) {
+            preconditioner.apply(basis[k], z);
+            detail::apply(a, z, w, policy);
+            for(std::size_t j = 0; j <= k; ++j) {
+                h[j][k] = detail::dot(w, basis[j]);
+                detail::axpy(-h[j][k], basis[j], w);
+            }
+            h[k + 1][k] = detail::norm(w);
+
+            for(std::size_t j = 0; j < k; ++j) {
+                T tmp = cs[j] * h[j][k] + sn[j] * h[j + 1][k];
+                h[j + 1][k] = -sn[j] * h[j][k] + cs[j] * h[j + 1][k];
+                h[j][k] = tmp;
+            }
+
+            T rho = std::hypot(h[k][k], h[k + 1][k]);
+            cs[k] = h[k][k] / rho;
+            sn[k] = h[k + 1][k] / rho;
+            h[k][k] = rho;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+            ++ret.iterations;
+
+            ret.residual = std::abs(g[k + 1]) / b_norm;
+            if((ret.residual <= options.tolerance) || (h[k + 1][k] == T{})) {
+                ++k;
+                break;
+            }
+
+            basis[k + 1] = w;
+            for(auto&& elem : basis[k + 1]) {
+                elem /= h[k + 1][k];
+            }
+        }
+
+        /* y = H^-1 * g, x += M^-1 * V * y */
+        std::vector<T> y(k);
+        for(std::size_t i = k; i-- > 0;) {
+            T sum = g[i];
+            for(std::size_t j = i + 1; j < k; ++j) {
+                sum -= h[i][j] * y[j];
+            }
+            y[i] = sum / h[i][i];
+        }
+
+        update.assign(n, T{});
+        for(std::size_t j = 0; j < k; ++j) {
+            detail::axpy(y[j], basis[j], update);
+        }
+        preconditioner.apply(update, z);
+        detail::axpy(T{1}, z, ret.x);
+
+        /* true residual, rotated one drifts in finite precision */
+        detail::apply(a, ret.x, r, policy);
+        for(std::size_t i = 0; i < n; ++i) {
+            r[i] = b[i] - r[i];
+        }
+        ret.residual = detail::norm(r) / b_norm;
+    }
+
+    ret.converged = (ret.residual <= options.tolerance);
+    return ret;
+}
+
+} /* namespace matrix */
@@ -1,7 +1,20 @@
 #pragma once
 
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
 namespace matrix {
 
+/* storage is aligned on cache line, so rows of padded matrices start on the same offset */
+constexpr std::size_t storage_alignment = 64u;
+
+/*  rows of size multiple of padding_period bytes map to the same cache sets,
+    with MATRIX_ROW_PADDING one more cache line is added to such rows */
+constexpr std::size_t padding_period = 1024u;
+
 template<typename T>
 class matrix_buff_t {
 
@@ -11,6 +24,8 @@ protected:
     matrix_buff_t(std::size_t rows, std::size_t cols);
     matrix_buff_t(const matrix_buff_t& rhs) = delete;
     matrix_buff_t& operator=(const matrix_buff_t&) = delete; 
+    matrix_buff_t(matrix_buff_t&& rhs) noexcept;
+    matrix_buff_t& operator=(matrix_buff_t&& rhs) noexcept;
     ~matrix_buff_t();
 
     void swap_buffers(matrix_buff_t& rhs) noexcept;
@@ -18,30 +33,33 @@ protected:
     void construct_at(std::size_t row, std::size_t col, const T& elem);
 
     /* this method need only for operator[] overload, bad idia, but i don't know any other solution */
-    T* get_ptr(std::size_t row, std::size_t col) const {return array_ + col + matrix_size_.cols_ * row;}
+    T* get_ptr(std::size_t row, std::size_t col) const {return array_ + col + leading_dimension_ * row;}
 
-    T& at(std::size_t row, std::size_t col) {return array_[col + matrix_size_.cols_ * row];}
-    const T& at(std::size_t row, std::size_t col) const {return array_[col + matrix_size_.cols_ * row];}
+    T& at(std::size_t row, std::size_t col) {return array_[col + leading_dimension_ * row];}
+    const T& at(std::size_t row, std::size_t col) const {return array_[col + leading_dimension_ * row];}
 
     std::size_t get_rows_number() const {return matrix_size_.rows_;}
     std::size_t get_cols_number() const {return matrix_size_.cols_;}
     std::size_t get_elements_number() const {return size_;}
 
+    /* distance between rows in elements, >= cols */
+    std::size_t get_leading_dimension() const {return leading_dimension_;}
+
 private:
 
+    static std::size_t padded_cols(std::size_t cols);
+
     void copy_construct(T* p, const T& val) { new (p) T(val); }
     void destroy(T* p) { p->~T(); }
 
-    template <typename FwdIter>
-    void destroy(FwdIter first, FwdIter last);
-
     T* array_;
-    std::size_t size_; /* number of constructed elements */
+    std::size_t size_; /* number of constructed elements, they are constructed row by row */
     std::size_t capacity_;
     struct matrix_size_t {
         std::size_t rows_ = 0;
         std::size_t cols_ = 0;
     } matrix_size_;
+    std::size_t leading_dimension_;
 
 }; /* matrix_buff_t */
 
@@ -49,24 +67,62 @@ private:
                         IMPLEMENTATION
 ---------------------------------------------------------------------*/
 
+template<typename T>
+std::size_t matrix_buff_t<T>::padded_cols(std::size_t cols) {
+#ifdef MATRIX_ROW_PADDING
+    std::size_t row_bytes = cols * sizeof(T);
+    if(row_bytes && (row_bytes % padding_period == 0u)) {
+        return cols + std::max<std::size_t>(storage_alignment / sizeof(T), 1u);
+    }
+#endif
+
+    return cols;
+}
+
 template<typename T>
 matrix_buff_t<T>::matrix_buff_t(std::size_t rows, std::size_t cols) :
-        array_((0 == (cols * rows)) ? nullptr : static_cast<T*>(::operator new((rows * cols) * sizeof(T)))),
+        array_(nullptr),
         size_{0u},
-        capacity_{rows * cols},
-        matrix_size_{rows, cols} {}
+        capacity_{0u},
+        matrix_size_{rows, cols},
+        leading_dimension_{padded_cols(cols)} {
+    if(rows && cols) {
+        capacity_ = rows * leading_dimension_;
+        array_ = static_cast<T*>(::operator new(capacity_ * sizeof(T), std::align_val_t{std::max(storage_alignment, alignof(T))}));
+    }
+}
+
+template<typename T>
+matrix_buff_t<T>::matrix_buff_t(matrix_buff_t&& rhs) noexcept :
+        array_(std::exchange(rhs.array_, nullptr)),
+        size_{std::exchange(rhs.size_, 0u)},
+        capacity_{std::exchange(rhs.capacity_, 0u)},
+        matrix_size_{std::exchange(rhs.matrix_size_, {})},
+        leading_dimension_{std::exchange(rhs.leading_dimension_, 0u)} {}
+
+template<typename T>
+matrix_buff_t<T>& matrix_buff_t<T>::operator=(matrix_buff_t&& rhs) noexcept {
+    matrix_buff_t tmp(std::move(rhs));
+    swap_buffers(tmp);
+    return *this;
+}
 
 template<typename T>
 matrix_buff_t<T>::~matrix_buff_t() {
     if(array_) {
-        destroy(array_, array_ + size_);
-        ::operator delete(array_);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for(std::size_t i = 0; i < size_; ++i) {
+                destroy(get_ptr(i / matrix_size_.cols_, i % matrix_size_.cols_));
+            }
+        }
+
+        ::operator delete(array_, std::align_val_t{std::max(storage_alignment, alignof(T))});
     }    
 }
 
 template<typename T>
 void matrix_buff_t<T>::construct_at(std::size_t row, std::size_t col, const T& elem) {
-    copy_construct(array_ + col + matrix_size_.cols_ * row, elem);
+    copy_construct(get_ptr(row, col), elem);
     ++size_;
 }
 
@@ -76,6 +132,7 @@ void matrix_buff_t<T>::swap_buffers(matrix_buff_t& rhs) noexcept {
     std::swap(size_, rhs.size_);
     std::swap(capacity_, rhs.capacity_);
     std::swap(matrix_size_, rhs.matrix_size_);
+    std::swap(leading_dimension_, rhs.leading_dimension_);
 }
 
 template<typename T>
@@ -84,12 +141,4 @@ void matrix_buff_t<T>::resize_buffer(std::size_t rows, std::size_t cols) {
     swap_buffers(tmp);
 }
 
-template<typename T>
-template <typename FwdIter>
-void matrix_buff_t<T>::destroy(FwdIter first, FwdIter last) {  
-    while (first != last) { 
-        destroy(&*first++);
-    }
-}
-
 } /* namespace matrix */
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "gemm.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+/*
+    ***non-owning view of matrix elements***
+
+    element (i, j) is data[i * row_stride + col_stride * j], so view can be submatrix of
+    matrix_t (row_stride - leading dimension) or transposed matrix (strides are swapped).
+    T can be const: const_matrix_view_t<T> is matrix_view_t<const T>.
+    View is valid while storage of viewed matrix isn't reallocated (resize, insert_col, assignment)
+
+    algorithms take read only arguments as const views, mutable view is passed to them by as_const()
+*/
+template<typename T>
+class matrix_view_t final {
+public:
+    class proxy_row_t {
+        public:
+            proxy_row_t(T* pointer, std::size_t stride) : row_(pointer), stride_(stride) {}
+            T& operator[](std::size_t idx) const {return row_[idx * stride_];}
+        private:
+            T* row_;
+            std::size_t stride_;
+    };
+
+    matrix_view_t() = default;
+    matrix_view_t(T* data, std::size_t rows, std::size_t cols, std::size_t row_stride, std::size_t col_stride = 1u) :
+        data_(data), rows_(rows), cols_(cols), row_stride_(row_stride), col_stride_(col_stride) {}
+
+    /* mutable view is converted to const one */
+    template<typename U, typename = std::enable_if_t<std::is_same_v<T, const U>>>
+    matrix_view_t(const matrix_view_t<U>& rhs) :
+        matrix_view_t(rhs.data(), rhs.get_rows_number(), rhs.get_cols_number(), rhs.get_row_stride(), rhs.get_col_stride()) {}
+
+    std::size_t get_rows_number() const {return rows_;}
+    std::size_t get_cols_number() const {return cols_;}
+    std::size_t get_elements_number() const {return rows_ * cols_;}
+    std::size_t get_row_stride() const {return row_stride_;}
+    std::size_t get_col_stride() const {return col_stride_;}
+
+    /* rows are contiguous, view can be passed to gemm with row stride as leading dimension */
+    bool has_unit_col_stride() const {return col_stride_ == 1u;}
+
+    T* data() const {return data_;}
+    T& operator()(std::size_t row, std::size_t col) const {return data_[row * row_stride_ + col * col_stride_];}
+    proxy_row_t operator[](std::size_t idx) const {return proxy_row_t(data_ + idx * row_stride_, col_stride_);}
+
+    /* rows [row, row + rows) and cols [col, col + cols), throws if they are out of view */
+    matrix_view_t submatrix(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const;
+    matrix_view_t row(std::size_t idx) const {return submatrix(idx, 0u, 1u, cols_);}
+    matrix_view_t col(std::size_t idx) const {return submatrix(0u, idx, rows_, 1u);}
+    matrix_view_t transposed() const {return matrix_view_t(data_, cols_, rows_, col_stride_, row_stride_);}
+
+    matrix_view_t<const T> as_const() const {return *this;}
+
+    void swap_rows(std::size_t lhs_idx, std::size_t rhs_idx) const;
+    void swap_cols(std::size_t lhs_idx, std::size_t rhs_idx) const;
+    std::size_t max_abs_col_elem(std::size_t idx, std::size_t start, std::size_t end) const;
+
+private:
+    T* data_ = nullptr;
+    std::size_t rows_ = 0u, cols_ = 0u;
+    std::size_t row_stride_ = 0u, col_stride_ = 1u;
+};
+
+template<typename T>
+using const_matrix_view_t = matrix_view_t<const T>;
+
+/* dst = src, views must have the same sizes and must not overlap */
+template<typename T>
+void copy_view(const_matrix_view_t<T> src, matrix_view_t<T> dst, const execution_policy_t& policy = sequential_policy);
+
+/*  C += A * B on views, views with unit col stride are passed to gemm as they are,
+    others are copied into contiguous buffer first (gemm packs rows only) */
+template<typename T>
+void gemm(const_matrix_view_t<T> a, const_matrix_view_t<T> b, matrix_view_t<T> c, const execution_policy_t& policy = sequential_policy);
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+matrix_view_t<T> matrix_view_t<T>::submatrix(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+    if((row > rows_) || (rows > rows_ - row) || (col > cols_) || (cols > cols_ - col)) {
+        throw std::runtime_error("matrix_view_t::submatrix: submatrix is out of view");
+    }
+
+    return matrix_view_t(data_ + row * row_stride_ + col * col_stride_, rows, cols, row_stride_, col_stride_);
+}
+
+template<typename T>
+void matrix_view_t<T>::swap_rows(std::size_t lhs_idx, std::size_t rhs_idx) const {
+    if(lhs_idx == rhs_idx) {
+        return;
+    }
+
+    T* lhs = data_ + lhs_idx * row_stride_;
+    T* rhs = data_ + rhs_idx * row_stride_;
+    for(std::size_t j = 0; j < cols_; ++j) {
+        std::swap(lhs[j * col_stride_], rhs[j * col_stride_]);
+    }
+}
+
+template<typename T>
+void matrix_view_t<T>::swap_cols(std::size_t lhs_idx, std::size_t rhs_idx) const {
+    transposed().swap_rows(lhs_idx, rhs_idx);
+}
+
+template<typename T>
+std::size_t matrix_view_t<T>::max_abs_col_elem(std::size_t idx, std::size_t start, std::size_t end) const {
+    std::size_t ret = start;
+    for(std::size_t i = start + 1; i < end; ++i) {
+        if(std::abs((*this)(i, idx)) > std::abs((*this)(ret, idx))) {
+            ret = i;
+        }
+    }
+
+    return ret;
+}
+
+template<typename T>
+void copy_view(const_matrix_view_t<T> src, matrix_view_t<T> dst, const execution_policy_t& policy /* = sequential_policy */) {
+    if((src.get_rows_number() != dst.get_rows_number()) || (src.get_cols_number() != dst.get_cols_number())) {
+        throw std::runtime_error("copy_view: views of different sizes");
+    }
+
+    policy.parallel_for_tiles(dst.get_rows_number(), dst.get_cols_number(), tile_rows, tile_cols,
+                              [&](std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+        for(std::size_t i = row_begin; i < row_end; ++i) {
+            auto from = src[i];
+            auto to = dst[i];
+            for(std::size_t j = col_begin; j < col_end; ++j) {
+                to[j] = from[j];
+            }
+        }
+    });
+}
+
+namespace detail {
+
+/* rows of view are contiguous, or view is copied into buf */
+template<typename T>
+const_matrix_view_t<T> unit_col_stride(const_matrix_view_t<T> v, std::vector<T>& buf) {
+    if(v.has_unit_col_stride()) {
+        return v;
+    }
+
+    buf.resize(v.get_elements_number());
+    matrix_view_t<T> ret(buf.data(), v.get_rows_number(), v.get_cols_number(), v.get_cols_number());
+    copy_view(v, ret);
+    return ret;
+}
+
+} /* namespace detail */
+
+template<typename T>
+void gemm(const_matrix_view_t<T> a, const_matrix_view_t<T> b, matrix_view_t<T> c, const execution_policy_t& policy /* = sequential_policy */) {
+    std::size_t m = c.get_rows_number(), n = c.get_cols_number(), k = a.get_cols_number();
+    if((a.get_rows_number() != m) || (b.get_rows_number() != k) || (b.get_cols_number() != n)) {
+        throw std::runtime_error("gemm: invalid view sizes, can't multiplicate");
+    }
+
+    if(!m || !n || !k) {
+        return;
+    }
+
+    if(!c.has_unit_col_stride()) {
+        std::vector<T> buf(m * n);
+        matrix_view_t<T> tmp(buf.data(), m, n, n);
+        copy_view(c.as_const(), tmp);
+        gemm(a, b, tmp, policy);
+        copy_view(tmp.as_const(), c);
+        return;
+    }
+
+    std::vector<T> a_buf, b_buf;
+    a = detail::unit_col_stride(a, a_buf);
+    b = detail::unit_col_stride(b, b_buf);
+    gemm(m, n, k, a.data(), a.get_row_stride(), b.data(), b.get_row_stride(), c.data(), c.get_row_stride(), policy);
+}
+
+} /* namespace matrix */
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+#include "sparse.hpp"
+#include "amd.hpp"
+
+namespace matrix {
+
+/*
+    ***sparse cholesky decomposition: P * A * P^T = L * L^T***
+
+    rows are taken in amd order, row k of L is found by sparse triangular solve with
+    first k rows of L (up-looking algorithm), its pattern is subtree of elimination tree,
+    so both symbolic and numeric passes take time proportional to nonzeros and flops
+
+    function contract:
+
+        1) matrix must be square and symmetric, only upper triangle is read
+        2) T - floating point type
+*/
+template<typename T>
+class sparse_cholesky_t final {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    explicit sparse_cholesky_t(const csc_matrix_t<T>& m);
+
+    std::size_t size() const {return n_;}
+
+    /* false if some pivot isn't positive, matrix is indefinite or singular */
+    bool positive_definite() const {return positive_definite_;}
+
+    std::size_t get_factor_nonzeros() const {return l_idx_.size();}
+
+    /* solution of A * x = b, throws if matrix isn't positive definite */
+    std::vector<T> solve(const std::vector<T>& b) const;
+
+private:
+    std::size_t ereach(std::size_t k, std::vector<std::size_t>& stack, std::vector<std::size_t>& mark) const;
+
+private:
+    std::size_t n_;
+    bool positive_definite_ = true;
+
+    std::vector<std::size_t> p_;    /* row k of L is p_[k] row of A */
+    csc_matrix_t<T> upper_;         /* upper triangle of P * A * P^T */
+    std::vector<std::size_t> parent_;
+
+    /* diagonal is stored first in column */
+    std::vector<std::size_t> l_ptr_, l_idx_;
+    std::vector<T> l_values_;
+};
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+sparse_cholesky_t<T>::sparse_cholesky_t(const csc_matrix_t<T>& m) : n_(m.get_cols_number()) {
+    if(m.get_rows_number() != m.get_cols_number()) {
+        throw std::runtime_error("sparse_cholesky_t: matrix must be square");
+    }
+
+    p_ = amd_order(m);
+    std::vector<std::size_t> pinv(n_);
+    for(std::size_t k = 0; k < n_; ++k) {
+        pinv[p_[k]] = k;
+    }
+
+    /* upper triangle in new order */
+    {
+        std::vector<triplet_t<T>> triplets;
+        triplets.reserve(m.get_nonzeros_number());
+        const auto& ptr = m.get_col_ptr();
+        const auto& idx = m.get_row_idx();
+        const auto& values = m.get_values();
+        for(std::size_t j = 0; j < n_; ++j) {
+            for(std::size_t p = ptr[j]; p < ptr[j + 1]; ++p) {
+                if(idx[p] <= j) {
+                    std::size_t i = pinv[idx[p]], k = pinv[j];
+                    triplets.push_back({std::min(i, k), std::max(i, k), values[p]});
+                }
+            }
+        }
+        upper_ = csc_matrix_t<T>(n_, n_, triplets);
+    }
+
+    /* elimination tree, ancestor is compressed path to current root */
+    parent_.assign(n_, npos);
+    {
+        std::vector<std::size_t> ancestor(n_, npos);
+        const auto& ptr = upper_.get_col_ptr();
+        const auto& idx = upper_.get_row_idx();
+        for(std::size_t k = 0; k < n_; ++k) {
+            for(std::size_t p = ptr[k]; p < ptr[k + 1]; ++p) {
+                for(std::size_t i = idx[p]; (i != npos) && (i < k);) {
+                    std::size_t next = ancestor[i];
+                    ancestor[i] = k;
+                    if(next == npos) {
+                        parent_[i] = k;
+                    }
+                    i = next;
+                }
+            }
+        }
+    }
+
+    std::vector<std::size_t> stack(n_), mark(n_, npos);
+
+    /* column counts: row k adds one element to every column of its pattern */
+    std::vector<std::size_t> fill(n_, 1u);
+    for(std::size_t k = 0; k < n_; ++k) {
+        for(std::size_t top = ereach(k, stack, mark); top < n_; ++top) {
+            ++fill[stack[top]];
+        }
+    }
+
+    l_ptr_.assign(n_ + 1, 0u);
+    for(std::size_t j = 0; j < n_; ++j) {
+        l_ptr_[j + 1] = l_ptr_[j] + fill[j];
+        fill[j] = l_ptr_[j];
+    }
+    l_idx_.resize(l_ptr_[n_]);
+    l_values_.resize(l_ptr_[n_]);
+
+    std::fill(mark.begin(), mark.end(), npos);
+    std::vector<T> x(n_, T{});
+    const auto& ptr = upper_.get_col_ptr();
+    const auto& idx = upper_.get_row_idx();
+    const auto& values = upper_.get_values();
+    for(std::size_t k = 0; k < n_; ++k) {
+        /* x = A(0 .. k, k), L(0 .. k-1, 0 .. k-1) * x' = x gives row k of L */
+        std::size_t top = ereach(k, stack, mark);
+        for(std::size_t p = ptr[k]; p < ptr[k + 1]; ++p) {
+            x[idx[p]] = values[p];
+        }
+
+        T d = x[k];
+        x[k] = T{};
+        for(; top < n_; ++top) {
+            std::size_t j = stack[top];
+            T lkj = x[j] / l_values_[l_ptr_[j]];
+            x[j] = T{};
+            for(std::size_t p = l_ptr_[j] + 1; p < fill[j]; ++p) {
+                x[l_idx_[p]] -= l_values_[p] * lkj;
+            }
+
+            d -= lkj * lkj;
+            l_idx_[fill[j]] = k;
+            l_values_[fill[j]++] = lkj;
+        }
+
+        if(!(d > T{})) {
+            positive_definite_ = false;
+            return;
+        }
+
+        l_idx_[fill[k]] = k;
+        l_values_[fill[k]++] = std::sqrt(d);
+    }
+}
+
+/* pattern of row k of L: paths from nonzeros of A(:, k) to k in elimination tree, topological order in stack[top .. n) */
+template<typename T>
+std::size_t sparse_cholesky_t<T>::ereach(std::size_t k, std::vector<std::size_t>& stack, std::vector<std::size_t>& mark) const {
+    std::size_t top = n_;
+    mark[k] = k;
+    const auto& ptr = upper_.get_col_ptr();
+    const auto& idx = upper_.get_row_idx();
+    for(std::size_t p = ptr[k]; p < ptr[k + 1]; ++p) {
+        std::size_t len = 0u;
+        for(std::size_t i = idx[p]; mark[i] != k; i = parent_[i]) {
+            stack[len++] = i;
+            mark[i] = k;
+        }
+
+        while(len > 0u) {
+            stack[--top] = stack[--len];
+        }
+    }
+
+    return top;
+}
+
+template<typename T>
+std::vector<T> sparse_cholesky_t<T>::solve(const std::vector<T>& b) const {
+    if(!positive_definite_) {
+        throw std::runtime_error("sparse_cholesky_t::solve: matrix isn't positive definite");
+    }
+
+    if(b.size() != n_) {
+        throw std::runtime_error("sparse_cholesky_t::solve: invalid right side size");
+    }
+
+    std::vector<T> y(n_);
+    for(std::size_t k = 0; k < n_; ++k) {
+        y[k] = b[p_[k]];
+    }
+
+    /* L * z = y */
+    for(std::size_t j = 0; j < n_; ++j) {
+        y[j] /= l_values_[l_ptr_[j]];
+        for(std::size_t p = l_ptr_[j] + 1; p < l_ptr_[j + 1]; ++p) {
+            y[l_idx_[p]] -= l_values_[p] * y[j];
+        }
+    }
+
+    /* L^T * y = z */
+    for(std::size_t j = n_; j-- > 0;) {
+        for(std::size_t p = l_ptr_[j] + 1; p < l_ptr_[j + 1]; ++p) {
+            y[j] -= l_values_[p] * y[l_idx_[p]];
+        }
+        y[j] /= l_values_[l_ptr_[j]];
+    }
+
+    std::vector<T> x(n_);
+    for(std::size_t k = 0; k < n_; ++k) {
+        x[p_[k]] = y[k];
+    }
+
+    return x;
+}
+
+} /* namespace matrix */
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../../circuit/circuit.hpp"
+
+/*  nodal and tableau solvers on side * side grid of resistors, every 10th branch has eds,
+    then changes of single branches: incremental update against full solve
+    usage: ./circuit_benchmark.out [side ...]
+
+    check: sum of currents in every vertex (first rule) must be zero, updated currents must match full solve */
+
+std::vector<circuit::branch_t> grid_circuit(std::size_t side, std::mt19937& gen) {
+    std::uniform_real_distribution<double> resistance(1.0, 10.0);
+    std::uniform_real_distribution<double> eds(-12.0, 12.0);
+    std::vector<circuit::branch_t> ret;
+    ret.reserve(2 * side * side);
+
+    auto add = [&](std::size_t v1, std::size_t v2) {
+        ret.push_back({v1, v2, resistance(gen), (ret.size() % 10 == 0) ? eds(gen) : 0.0});
+    };
+
+    for(std::size_t i = 0; i < side; ++i) {
+        for(std::size_t j = 0; j < side; ++j) {
+            std::size_t v = i * side + j;
+            if(j + 1 < side) {
+                add(v, v + 1);
+            }
+
+            if(i + 1 < side) {
+                add(v, v + side);
+            }
+        }
+    }
+
+    return ret;
+}
+
+double max_imbalance(std::size_t vertices_count, const std::vector<circuit::branch_t>& branches, const std::vector<double>& currents) {
+    std::vector<double> balance(vertices_count, 0.0);
+    for(std::size_t e = 0; e < branches.size(); ++e) {
+        balance[branches[e].v1] -= currents[e];
+        balance[branches[e].v2] += currents[e];
+    }
+
+    double ret = 0.0;
+    for(double b : balance) {
+        ret = std::max(ret, std::abs(b));
+    }
+
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> sides;
+    for(int i = 1; i < argc; ++i) {
+        sides.push_back(std::stoull(argv[i]));
+    }
+
+    if(sides.empty()) {
+        sides = {224u, 708u}; /* 10^5 and 10^6 branches */
+    }
+
+    std::mt19937 gen(42);
+    for(std::size_t side : sides) {
+        std::vector<circuit::branch_t> branches = grid_circuit(side, gen);
+
+        for(auto method : {circuit::method_t::nodal, circuit::method_t::tableau}) {
+            auto start = std::chrono::high_resolution_clock::now();
+            circuit::circuit_t circuit(side * side, branches);
+            bool success = circuit.calculate_currents(method);
+            auto finish = std::chrono::high_resolution_clock::now();
+
+            double imbalance = success ? max_imbalance(side * side, branches, circuit.get_branch_currents()) : 0.0;
+            std::cout << std::setw(8) << branches.size() << " branches, " << std::setw(7) << ((method == circuit::method_t::nodal) ? "nodal" : "tableau")
+                      << ": " << std::fixed << std::setprecision(3) << std::chrono::duration<double>(finish - start).count() << " s, max imbalance "
+                      << std::scientific << std::setprecision(2) << imbalance << ((success && (imbalance < 1e-9)) ? " SUCCESS" : " FAILED")
+                      << std::defaultfloat << std::endl;
+        }
+
+        const std::size_t updates_count = 20u;
+        std::uniform_int_distribution<std::size_t> branch(0u, branches.size() - 1);
+        std::uniform_real_distribution<double> resistance(1.0, 10.0), eds(-12.0, 12.0);
+        circuit::circuit_t circuit(side * side, branches);
+        circuit.calculate_currents();
+
+        auto start = std::chrono::high_resolution_clock::now();
+        bool success = true;
+        for(std::size_t k = 0; k < updates_count; ++k) {
+            std::size_t e = branch(gen);
+            if(k % 2 == 0) {
+                branches[e].resistance = resistance(gen);
+                success = circuit.set_resistance(e, branches[e].resistance) && success;
+            } else {
+                branches[e].eds = eds(gen);
+                success = circuit.set_eds(e, branches[e].eds) && success;
+            }
+        }
+        auto finish = std::chrono::high_resolution_clock::now();
+
+        circuit::circuit_t full(side * side, branches);
+        success = full.calculate_currents() && success;
+        std::vector<double> updated = circuit.get_branch_currents(), expected = full.get_branch_currents();
+        double difference = 0.0;
+        for(std::size_t e = 0; e < branches.size(); ++e) {
+            difference = std::max(difference, std::abs(updated[e] - expected[e]));
+        }
+
+        std::cout << std::setw(8) << branches.size() << " branches, " << updates_count << " updates: " << std::fixed << std::setprecision(3)
+                  << std::chrono::duration<double>(finish - start).count() / updates_count << " s per update, max difference "
+                  << std::scientific << std::setprecision(2) << difference << ((success && (difference < 1e-9)) ? " SUCCESS" : " FAILED")
+                  << std::defaultfloat << std::endl;
+    }
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "../../circuit/circuit.hpp"
+
+/*  loading of netlist: dense matrices resized on every edge (previous driver_t::push) against edge list,
+    edges of random circuit come one by one as from parser
+    usage: ./load_benchmark.out [edges ...]
+
+    dense loading is quadratic, it's measured only for first sizes */
+
+const std::size_t dense_limit = 1000u;
+
+std::vector<circuit::branch_t> random_edges(std::size_t edges_count, std::mt19937& gen) {
+    std::uniform_int_distribution<std::size_t> vertex(1u, edges_count / 2 + 1);
+    std::uniform_real_distribution<double> resistance(1.0, 10.0);
+    std::vector<circuit::branch_t> ret(edges_count);
+    for(auto&& edge : ret) {
+        edge = {vertex(gen), vertex(gen), resistance(gen), 0.0};
+    }
+
+    return ret;
+}
+
+double load_dense(const std::vector<circuit::branch_t>& edges) {
+    auto start = std::chrono::high_resolution_clock::now();
+    matrix::matrix_t<double> eds_matrix, resistance_matrix;
+    matrix::matrix_t<int> edges_matrix;
+    for(auto&& edge : edges) {
+        std::size_t new_cols = eds_matrix.get_cols_number() + 1;
+        std::size_t new_rows = std::max(eds_matrix.get_rows_number(), std::max(edge.v1, edge.v2) + 1);
+        eds_matrix.resize(new_rows, new_cols);
+        resistance_matrix.resize(new_rows, new_cols);
+        edges_matrix.resize(new_rows, new_cols);
+
+        eds_matrix[edge.v1][new_cols - 1] = eds_matrix[edge.v2][new_cols - 1] = edge.eds;
+        resistance_matrix[edge.v1][new_cols - 1] = resistance_matrix[edge.v2][new_cols - 1] = edge.resistance;
+        edges_matrix[edge.v1][new_cols - 1] = 1;
+        edges_matrix[edge.v2][new_cols - 1] = 2;
+    }
+
+    circuit::circuit_t circuit(resistance_matrix, eds_matrix, edges_matrix);
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+double load_list(const std::vector<circuit::branch_t>& edges) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<circuit::branch_t> branches;
+    std::size_t vertices_count = 0u;
+    for(auto&& edge : edges) {
+        branches.push_back(edge);
+        vertices_count = std::max(vertices_count, std::max(edge.v1, edge.v2) + 1);
+    }
+
+    circuit::circuit_t circuit(vertices_count, branches);
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> sizes;
+    for(int i = 1; i < argc; ++i) {
+        sizes.push_back(std::stoull(argv[i]));
+    }
+
+    if(sizes.empty()) {
+        sizes = {250u, 500u, 1000u, 1000000u};
+    }
+
+    std::mt19937 gen(42);
+    for(std::size_t edges_count : sizes) {
+        std::vector<circuit::branch_t> edges = random_edges(edges_count, gen);
+        std::cout << std::setw(8) << edges_count << " edges: list " << std::fixed << std::setprecision(3) << load_list(edges) << " s";
+        if(edges_count <= dense_limit) {
+            std::cout << ", dense " << load_dense(edges) << " s";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+}
@@ -2,6 +2,18 @@
 #include "unit_tests/determinant/determinant.hpp"
 #include "unit_tests/gauss.hpp"
 #include "unit_tests/resize.hpp"
+#include "unit_tests/gemm.hpp"
+#include "unit_tests/parallel.hpp"
+#include "unit_tests/lu.hpp"
+#include "unit_tests/expression.hpp"
+#include "unit_tests/storage.hpp"
+#include "unit_tests/sparse.hpp"
+#include "unit_tests/krylov.hpp"
+#include "unit_tests/matrix_io.hpp"
+#include "unit_tests/matrix_view.hpp"
+#include "unit_tests/refinement.hpp"
+#include "unit_tests/spectral.hpp"
+#include "unit_tests/circuit.hpp"
 
 /* ------------------------------------------------------------------------------------------------------------------------------- 
                                             GAUSS ALGS
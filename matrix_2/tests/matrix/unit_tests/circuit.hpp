@@ -0,0 +1,196 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "../../../circuit/circuit.hpp"
+
+namespace {
+
+std::vector<double> solve_circuit(std::size_t vertices_count, const std::vector<circuit::branch_t>& branches, circuit::method_t method) {
+    circuit::circuit_t c(vertices_count, branches);
+    EXPECT_TRUE(c.calculate_currents(method));
+    return c.get_branch_currents();
+}
+
+double max_current_difference(const std::vector<double>& lhs, const std::vector<double>& rhs) {
+    double ret = 0.0;
+    for(std::size_t i = 0; i < lhs.size(); ++i) {
+        ret = std::max(ret, std::abs(lhs[i] - rhs[i]));
+    }
+
+    return ret;
+}
+
+/*  connected circuit with resistive branches, zero resistance forest and zero resistance self loops,
+    currents are unique (current of self loop without eds is zero) */
+std::vector<circuit::branch_t> random_circuit(std::size_t vertices_count, std::size_t branches_count, std::mt19937& gen) {
+    std::uniform_int_distribution<std::size_t> vertex(0, vertices_count - 1);
+    std::uniform_real_distribution<double> resistance(0.5, 10.0), eds(-5.0, 5.0);
+
+    std::vector<circuit::branch_t> ret;
+    for(std::size_t v = 1; v < vertices_count; ++v) {
+        ret.push_back({std::uniform_int_distribution<std::size_t>(0, v - 1)(gen), v, resistance(gen), eds(gen)});
+    }
+
+    std::vector<std::size_t> parent(vertices_count);
+    std::iota(parent.begin(), parent.end(), 0u);
+    auto find = [&parent](std::size_t v) {
+        while(parent[v] != v) {v = parent[v];}
+        return v;
+    };
+
+    for(std::size_t i = 0; i < branches_count; ++i) {
+        std::size_t v1 = vertex(gen), v2 = vertex(gen);
+        switch(gen() % 3) {
+        case 0:
+            ret.push_back({v1, v2, resistance(gen), eds(gen)});
+            break;
+        case 1:
+            if(find(v1) != find(v2)) {
+                parent[find(v1)] = find(v2);
+                ret.push_back({v1, v2, 0.0, eds(gen)});
+            }
+            break;
+        default:
+            ret.push_back({v1, v1, 0.0, 0.0});
+        }
+    }
+
+    return ret;
+}
+
+/* tests/circuit/cases and answers, answers are printed with 6 significant digits */
+struct circuit_case_t {
+    std::size_t vertices_count;
+    std::vector<circuit::branch_t> branches;
+    std::vector<double> currents; /* empty if currents can't be calculated */
+};
+
+std::vector<circuit_case_t> circuit_cases() {
+    return {
+        /* 1 */
+        {5,
+         {{1, 2, 4.0, 0.0}, {1, 3, 10.0, 0.0}, {1, 4, 2.0, -12.0}, {2, 3, 60.0, 0.0}, {2, 4, 22.0, 0.0},
+          {3, 4, 5.0, 0.0}},
+         {0.442958, 0.631499, -1.07446, 0.0757193, 0.367239, 0.707219}},
+        /* 2 */
+        {6,
+         {{1, 2, 10.0, 0.0}, {2, 3, 5.0, -5.0}, {2, 4, 1.3, 0.0}, {3, 5, 4.6, 19.0}, {3, 5, 6.7, 0.0}},
+         {0, 0, 0, 1.68142, -1.68142}},
+        /* 3 */
+        {3,
+         {{1, 1, 8.0, 8.0}, {2, 2, 10.0, -5.0}},
+         {1, -0.5}},
+        /* 4 */
+        {21,
+         {{1, 2, 1.0, 0.0}, {1, 6, 0.0, 0.0}, {2, 3, 2.0, 0.0}, {2, 7, 2.0, 0.0}, {3, 4, 2.0, 0.0},
+          {3, 8, 2.0, 0.0}, {4, 5, 1.0, 0.0}, {4, 9, 2.0, 0.0}, {5, 10, 0.0, 0.0}, {6, 7, 1.0, 0.0},
+          {6, 11, 0.0, 0.0}, {7, 8, 2.0, 0.0}, {7, 12, 2.0, 0.0}, {8, 9, 2.0, 0.0}, {8, 13, 2.0, 0.0},
+          {9, 10, 1.0, 0.0}, {9, 14, 2.0, 0.0}, {10, 15, 0.0, 0.0}, {11, 12, 1.0, 0.0}, {12, 13, 2.0, 0.0},
+          {13, 14, 2.0, 0.0}, {14, 15, 1.0, 0.0}, {11, 16, 0.0, 0.0}, {15, 20, 0.0, 0.0}, {20, 16, 0.0, 120.0}},
+         {20, -20, 20, 0, 20, 0, 20, 0, 20, 20, -40, 20, 0, 20, 0, 20, 0, 40, 20, 20, 20, 20, -60, 60, 60}},
+        /* 5 */
+        {11,
+         {{1, 2, 2.0, 5.0}, {2, 3, 2.0, 0.0}, {3, 4, 2.0, 0.0}, {4, 5, 2.0, 0.0}, {5, 6, 2.0, 0.0},
+          {6, 7, 2.0, 0.0}, {7, 8, 2.0, 0.0}, {8, 9, 2.0, 0.0}, {9, 10, 2.0, 0.0}, {10, 1, 2.0, 0.0}},
+         {0.25, 0.25, 0.25, 0.25, 0.25, 0.25, 0.25, 0.25, 0.25, 0.25}},
+        /* 6 */
+        {3,
+         {{1, 2, 0.0, 0.0}, {1, 2, 0.0, 5.0}, {1, 2, 10.0, 10.0}},
+         {}}
+    };
+}
+
+} /* namespace */
+
+TEST(Circuit, TableauZeroResistanceLoop) {
+    /* self loop makes tableau system singular, it is solved by dense gauss */
+    std::vector<circuit::branch_t> branches = {{0, 1, 1.0, 0.0}, {1, 0, 1.0, 2.0}, {1, 1, 0.0, 0.0}};
+    std::vector<double> expected = {1.0, 1.0, 0.0};
+
+    ASSERT_LT(max_current_difference(solve_circuit(2, branches, circuit::method_t::nodal), expected), 1e-12);
+    ASSERT_LT(max_current_difference(solve_circuit(2, branches, circuit::method_t::tableau), expected), 1e-12);
+}
+
+TEST(Circuit, TableauEqualsNodal) {
+    /* singular tableau systems are solved by dense gauss, it flushes elements below matrix::tolerance,
+       so currents agree only up to a few tolerances */
+    std::mt19937 gen(37);
+    for(std::size_t i = 0; i < 200; ++i) {
+        std::size_t vertices_count = 2 + gen() % 30;
+        std::vector<circuit::branch_t> branches = random_circuit(vertices_count, 2 * vertices_count, gen);
+
+        std::vector<double> nodal = solve_circuit(vertices_count, branches, circuit::method_t::nodal);
+        std::vector<double> tableau = solve_circuit(vertices_count, branches, circuit::method_t::tableau);
+        ASSERT_LT(max_current_difference(nodal, tableau), 100 * matrix::tolerance) << "circuit " << i;
+    }
+}
+
+TEST(Circuit, Cases) {
+    std::vector<circuit_case_t> cases = circuit_cases();
+    for(std::size_t i = 0; i < cases.size(); ++i) {
+        for(circuit::method_t method : {circuit::method_t::nodal, circuit::method_t::tableau}) {
+            circuit::circuit_t c(cases[i].vertices_count, cases[i].branches);
+            bool solved = c.calculate_currents(method);
+            ASSERT_EQ(solved, !cases[i].currents.empty()) << "case " << i + 1;
+            if(solved) {
+                ASSERT_LT(max_current_difference(c.get_branch_currents(), cases[i].currents), 1e-5) << "case " << i + 1;
+            }
+        }
+    }
+}
+
+TEST(Circuit, BranchUpdates) {
+    /*  first 40 updates change only resistances, it's more than circuit_t::max_updates, so G is factorized
+        again on the way, then eds and zero resistance branches are changed too */
+    std::mt19937 gen(40);
+    std::uniform_real_distribution<double> resistance(0.5, 10.0), eds(-5.0, 5.0);
+    for(std::size_t i = 0; i < 10; ++i) {
+        std::size_t vertices_count = 2 + gen() % 30;
+        std::vector<circuit::branch_t> branches = random_circuit(vertices_count, 2 * vertices_count, gen);
+        circuit::circuit_t c(vertices_count, branches);
+        ASSERT_TRUE(c.calculate_currents());
+
+        std::vector<std::size_t> resistive, zero;
+        for(std::size_t e = 0; e < branches.size(); ++e) {
+            if(branches[e].resistance > 0.0) {
+                resistive.push_back(e);
+            } else if(branches[e].v1 != branches[e].v2) {
+                zero.push_back(e); /* eds of zero resistance self loop has no solution, they aren't changed */
+            }
+        }
+
+        for(std::size_t update = 0; update < 80; ++update) {
+            std::size_t kind = (update < 40) ? 0 : gen() % 3;
+            if((kind == 2) && zero.empty()) {
+                kind = 1;
+            }
+
+            if(kind == 0) {
+                std::size_t e = resistive[gen() % resistive.size()];
+                branches[e].resistance = resistance(gen);
+                ASSERT_TRUE(c.set_resistance(e, branches[e].resistance));
+            } else if(kind == 1) {
+                std::size_t e = resistive[gen() % resistive.size()];
+                branches[e].eds = eds(gen);
+                ASSERT_TRUE(c.set_eds(e, branches[e].eds));
+            } else {
+                /* zero resistance forest changes, it's full solve */
+                std::size_t e = zero[gen() % zero.size()];
+                branches[e].resistance = (branches[e].resistance == 0.0) ? resistance(gen) : 0.0;
+                ASSERT_TRUE(c.set_resistance(e, branches[e].resistance));
+                if(gen() % 2) {
+                    branches[e].eds = eds(gen);
+                    ASSERT_TRUE(c.set_eds(e, branches[e].eds));
+                }
+            }
+
+            std::vector<double> expected = solve_circuit(vertices_count, branches, circuit::method_t::nodal);
+            ASSERT_LT(max_current_difference(c.get_branch_currents(), expected), 1e-9) << "circuit " << i << ", update " << update;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <random>
+
+#include "../../../matrix/matrix.hpp"
+
+/* fixtures shared by unit tests, all of them are compiled into one binary */
+namespace {
+
+/* elements are uniform in [low, high) */
+template<typename T = double>
+matrix::matrix_t<T> random_matrix(std::size_t rows, std::size_t cols, std::mt19937& gen, double low = -10.0, double high = 10.0) {
+    std::uniform_real_distribution<double> dis(low, high);
+    matrix::matrix_t<T> ret(rows, cols);
+    for(std::size_t i = 0; i < rows; ++i) {
+        for(std::size_t j = 0; j < cols; ++j) {
+            ret[i][j] = dis(gen);
+        }
+    }
+
+    return ret;
+}
+
+/* bitwise comparison, operator== has tolerance */
+bool identical(const matrix::matrix_t<double>& lhs, const matrix::matrix_t<double>& rhs) {
+    if((lhs.get_rows_number() != rhs.get_rows_number()) || (lhs.get_cols_number() != rhs.get_cols_number())) {
+        return false;
+    }
+
+    for(std::size_t i = 0; i < lhs.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < lhs.get_cols_number(); ++j) {
+            if(lhs[i][j] != rhs[i][j]) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} /* namespace */
@@ -138,4 +138,21 @@ TEST(Matrix, LinarSystemSolve4)  {
                                                          { 0           , 0           , 1            } };
     auto ret = matrix::solve_linear_system(system_right, system_left);
     ASSERT_TRUE((ret.first == partly_solution) && (ret.second == fundamental_matrix)) << " joint, !homogeneous system m * n ";                                                                 
-}
\ No newline at end of file
+}
+
+TEST(Matrix, LinarSystemSolve5) {
+    /* first unknown isn't used, pivot columns are swapped during solve */
+    matrix::matrix_t <long double> system_right = {{0.0, 1.0},
+                                                   {0.0, 2.0}};
+
+    matrix::matrix_t<long double> system_left = {{3.0},
+                                                 {6.0}};
+
+    matrix::matrix_t<long double> partly_solution = {{0},
+                                                     {3}};
+    matrix::matrix_t<long double> fundamental_matrix = {{1},
+                                                        {0}};
+
+    auto ret = matrix::solve_linear_system(system_right, system_left);
+    ASSERT_TRUE((ret.first == partly_solution) && (ret.second == fundamental_matrix)) << " joint system with free first unknown ";
+}
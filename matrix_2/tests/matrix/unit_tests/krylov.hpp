@@ -0,0 +1,179 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <stdexcept>
+
+#include "../../../matrix/krylov.hpp"
+#include "../../../matrix/sparse_cholesky.hpp"
+
+namespace {
+
+/* 5 point stencil on side * side grid, convection makes it nonsymmetric */
+matrix::csr_matrix_t<double> grid_operator(std::size_t side, double convection) {
+    std::vector<matrix::triplet_t<double>> triplets;
+    for(std::size_t i = 0; i < side; ++i) {
+        for(std::size_t j = 0; j < side; ++j) {
+            std::size_t v = i * side + j;
+            triplets.push_back({v, v, 4.0});
+            if(j + 1 < side) {
+                triplets.push_back({v, v + 1, -1.0 + convection});
+                triplets.push_back({v + 1, v, -1.0 - convection});
+            }
+
+            if(i + 1 < side) {
+                triplets.push_back({v, v + side, -1.0});
+                triplets.push_back({v + side, v, -1.0});
+            }
+        }
+    }
+
+    return matrix::csr_matrix_t<double>(side * side, side * side, triplets);
+}
+
+std::vector<double> krylov_right_side(std::size_t size, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::vector<double> ret(size);
+    for(auto&& elem : ret) {
+        elem = dis(gen);
+    }
+
+    return ret;
+}
+
+template<typename Matrix>
+double relative_residual(const Matrix& a, const std::vector<double>& x, const std::vector<double>& b) {
+    std::vector<double> r;
+    matrix::detail::apply(a, x, r, matrix::sequential_policy);
+    for(std::size_t i = 0; i < r.size(); ++i) {
+        r[i] -= b[i];
+    }
+
+    return matrix::detail::norm(r) / matrix::detail::norm(b);
+}
+
+} /* namespace */
+
+TEST(Krylov, ConjugateGradient) {
+    std::mt19937 gen(5);
+    matrix::csr_matrix_t<double> a = grid_operator(40, 0.0);
+    std::vector<double> b = krylov_right_side(a.get_rows_number(), gen);
+    std::vector<double> exact = matrix::sparse_cholesky_t<double>(matrix::csc_matrix_t<double>(a)).solve(b);
+
+    auto plain = matrix::conjugate_gradient(a, b);
+    auto jacobi = matrix::conjugate_gradient(a, b, matrix::jacobi_preconditioner_t<double>(a));
+    auto ic0 = matrix::conjugate_gradient(a, b, matrix::ic0_preconditioner_t<double>(a));
+
+    for(auto* result : {&plain, &jacobi, &ic0}) {
+        ASSERT_TRUE(result->converged);
+        ASSERT_LT(relative_residual(a, result->x, b), 1e-9);
+        for(std::size_t i = 0; i < exact.size(); ++i) {
+            ASSERT_NEAR(result->x[i], exact[i], 1e-8);
+        }
+    }
+    ASSERT_LT(ic0.iterations, plain.iterations);
+
+    matrix::thread_pool_t pool(4);
+    auto parallel = matrix::conjugate_gradient(a, b, matrix::identity_preconditioner_t<double>(), {}, matrix::execution_policy_t(pool));
+    ASSERT_EQ(parallel.x, plain.x);
+}
+
+TEST(Krylov, Nonsymmetric) {
+    std::mt19937 gen(6);
+    matrix::csr_matrix_t<double> a = grid_operator(40, 0.3);
+    std::vector<double> b = krylov_right_side(a.get_rows_number(), gen);
+    matrix::jacobi_preconditioner_t<double> jacobi(a);
+    matrix::ilu0_preconditioner_t<double> ilu0(a);
+
+    auto bicgstab = matrix::bicgstab(a, b);
+    auto bicgstab_ilu0 = matrix::bicgstab(a, b, ilu0);
+    auto gmres = matrix::gmres(a, b, jacobi, {1e-10, 5000u, 30u});
+    auto gmres_ilu0 = matrix::gmres(a, b, ilu0);
+
+    for(auto* result : {&bicgstab, &bicgstab_ilu0, &gmres, &gmres_ilu0}) {
+        ASSERT_TRUE(result->converged);
+        ASSERT_LT(relative_residual(a, result->x, b), 1e-9);
+    }
+    ASSERT_LT(bicgstab_ilu0.iterations, bicgstab.iterations);
+    ASSERT_LT(gmres_ilu0.iterations, gmres.iterations);
+
+    /* ilu0 of tridiagonal matrix is exact LU */
+    std::vector<matrix::triplet_t<double>> triplets;
+    for(std::size_t i = 0; i < 100; ++i) {
+        triplets.push_back({i, i, 3.0});
+        if(i) {
+            triplets.push_back({i, i - 1, -1.0});
+            triplets.push_back({i - 1, i, -2.0});
+        }
+    }
+    matrix::csr_matrix_t<double> tridiagonal(100, 100, triplets);
+    std::vector<double> tridiagonal_b = krylov_right_side(100, gen);
+    auto exact = matrix::gmres(tridiagonal, tridiagonal_b, matrix::ilu0_preconditioner_t<double>(tridiagonal));
+    ASSERT_TRUE(exact.converged);
+    ASSERT_EQ(exact.iterations, 1u);
+}
+
+TEST(Krylov, Dense) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const std::size_t size = 60;
+
+    matrix::matrix_t<double> a(size, size), spd(size, size);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            a[i][j] = dis(gen) + ((i == j) ? 2.0 * size : 0.0);
+        }
+    }
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            spd[i][j] = a[i][j] + a[j][i];
+        }
+    }
+
+    std::vector<double> b = krylov_right_side(size, gen);
+    matrix::matrix_t<double> column(size, 1);
+    for(std::size_t i = 0; i < size; ++i) {
+        column[i][0] = b[i];
+    }
+    matrix::matrix_t<double> expected = matrix::solve_linear_system(a, column).first;
+
+    auto bicgstab = matrix::bicgstab(a, b, matrix::jacobi_preconditioner_t<double>(a));
+    auto gmres = matrix::gmres(a, b, matrix::ilu0_preconditioner_t<double>(a));
+    for(auto* result : {&bicgstab, &gmres}) {
+        ASSERT_TRUE(result->converged);
+        for(std::size_t i = 0; i < size; ++i) {
+            ASSERT_NEAR(result->x[i], expected[i][0], 1e-9);
+        }
+    }
+
+    auto cg = matrix::conjugate_gradient(spd, b, matrix::ic0_preconditioner_t<double>(spd));
+    ASSERT_TRUE(cg.converged);
+    ASSERT_LT(relative_residual(spd, cg.x, b), 1e-9);
+
+    ASSERT_THROW(matrix::gmres(a, std::vector<double>(size + 1)), std::runtime_error);
+    ASSERT_THROW(matrix::jacobi_preconditioner_t<double>(matrix::matrix_t<double>(2, 2)), std::runtime_error);
+}
+
+TEST(Krylov, Termination) {
+    std::mt19937 gen(8);
+    matrix::csr_matrix_t<double> a = grid_operator(30, 0.0);
+    std::vector<double> b = krylov_right_side(a.get_rows_number(), gen);
+
+    auto limited = matrix::conjugate_gradient(a, b, matrix::identity_preconditioner_t<double>(), {1e-10, 3u});
+    ASSERT_FALSE(limited.converged);
+    ASSERT_EQ(limited.iterations, 3u);
+
+    auto loose = matrix::gmres(a, b, matrix::identity_preconditioner_t<double>(), {1e-3, 1000u, 20u});
+    auto tight = matrix::gmres(a, b, matrix::identity_preconditioner_t<double>(), {1e-10, 1000u, 20u});
+    ASSERT_TRUE(loose.converged && tight.converged);
+    ASSERT_LT(loose.iterations, tight.iterations);
+    ASSERT_LE(loose.residual, 1e-3);
+
+    auto zero = matrix::bicgstab(a, std::vector<double>(a.get_rows_number(), 0.0));
+    ASSERT_TRUE(zero.converged);
+    ASSERT_EQ(zero.iterations, 0u);
+
+    matrix::csr_matrix_t<double> indefinite(2, 2, {{0, 0, 1.0}, {0, 1, 2.0}, {1, 0, 2.0}, {1, 1, 1.0}});
+    ASSERT_THROW(matrix::ic0_preconditioner_t<double>{indefinite}, std::runtime_error);
+}
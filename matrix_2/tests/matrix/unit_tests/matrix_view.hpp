@@ -0,0 +1,105 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "../../../matrix/matrix.hpp"
+#include "common.hpp"
+
+TEST(MatrixView, Slicing) {
+    matrix::matrix_t<int> m{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+
+    matrix::matrix_view_t<int> block = m.submatrix(1, 1, 2, 3);
+    ASSERT_EQ(block.get_rows_number(), 2u);
+    ASSERT_EQ(block[0][0], 6);
+    ASSERT_EQ(block(1, 2), 12);
+
+    block[1][0] = 0;
+    ASSERT_EQ(m[2][1], 0);
+
+    matrix::matrix_view_t<int> transposed = block.transposed();
+    ASSERT_EQ(transposed.get_rows_number(), 3u);
+    ASSERT_EQ(transposed[2][0], 8);
+    ASSERT_EQ(transposed.row(1)(0, 1), 11);
+    ASSERT_EQ(block.col(2)(1, 0), 12);
+
+    transposed.swap_rows(0, 2);
+    ASSERT_EQ(m[1][1], 8);
+    ASSERT_EQ(m[1][3], 6);
+
+    matrix::const_matrix_view_t<int> read_only = block;
+    ASSERT_EQ(matrix::matrix_t<int>(read_only), (matrix::matrix_t<int>{{8, 7, 6}, {12, 11, 0}}));
+    ASSERT_EQ(matrix::transposition(read_only), (matrix::matrix_t<int>{{8, 12}, {7, 11}, {6, 0}}));
+
+    matrix::matrix_t<int> copy(2, 3);
+    matrix::copy_view(read_only, copy.view());
+    ASSERT_EQ(copy, matrix::matrix_t<int>(read_only));
+
+    ASSERT_THROW(block.submatrix(1, 0, 2, 1), std::runtime_error);
+    ASSERT_THROW(m.submatrix(0, 4, 1, 1), std::runtime_error);
+    ASSERT_THROW(matrix::copy_view(read_only, m.view()), std::runtime_error);
+}
+
+TEST(MatrixView, Multiplication) {
+    std::mt19937 gen(51);
+    matrix::matrix_t<double> a = random_matrix(70, 90, gen, -1.0, 1.0);
+    matrix::matrix_t<double> b = random_matrix(80, 60, gen, -1.0, 1.0);
+
+    /* submatrix with leading dimension of parent and transposed (strided) view */
+    auto lhs = a.submatrix(5, 10, 50, 40).as_const();
+    auto rhs = b.submatrix(20, 3, 50, 40).transposed();
+    matrix::matrix_t<double> expected = matrix::multiplication(matrix::matrix_t<double>(lhs), matrix::matrix_t<double>(rhs.as_const()));
+    ASSERT_EQ(matrix::multiplication(lhs, rhs.as_const()), expected);
+
+    /* product is added to block of bigger matrix, the rest isn't changed */
+    matrix::matrix_t<double> c(60, 60, 1.0);
+    matrix::gemm(lhs, rhs.as_const(), c.submatrix(5, 5, 50, 50));
+    ASSERT_DOUBLE_EQ(c[0][0], 1.0);
+    ASSERT_DOUBLE_EQ(c[59][59], 1.0);
+    ASSERT_NEAR(c[5][5], expected[0][0] + 1.0, 1e-12);
+    ASSERT_NEAR(c[54][54], expected[49][49] + 1.0, 1e-12);
+
+    /* strided result */
+    matrix::matrix_t<double> ct(50, 50);
+    matrix::gemm(lhs, rhs.as_const(), ct.view().transposed());
+    ASSERT_EQ(matrix::transposition(ct), expected);
+
+    ASSERT_THROW(matrix::multiplication(lhs, lhs), std::runtime_error);
+}
+
+TEST(MatrixView, Algorithms) {
+    std::mt19937 gen(52);
+    const std::size_t size = 150;
+
+    /* system is block of bigger matrix, right side is its last column */
+    matrix::matrix_t<double> big = random_matrix(size + 10, size + 11, gen, -1.0, 1.0);
+    auto left = big.submatrix(3, 2, size, size);
+    auto right = big.submatrix(3, size + 10, size, 1);
+
+    matrix::matrix_t<double> left_copy(left.as_const()), right_copy(right.as_const());
+    auto expected = matrix::solve_linear_system(left_copy, right_copy);
+    auto actual = matrix::solve_linear_system(left.as_const(), right.as_const());
+    ASSERT_EQ(actual.first, expected.first);
+
+    matrix::lu_decomposition_t<double> lu(left.as_const());
+    ASSERT_NEAR(lu.det(), left_copy.det(), 1e-9 * std::abs(left_copy.det()));
+    ASSERT_EQ(lu.solve(right.as_const()), expected.first);
+
+    /* gauss on part of augmented matrix in place */
+    matrix::matrix_t<double> augmented = random_matrix(40, 50, gen, -1.0, 1.0);
+    matrix::matrix_t<double> part(augmented.submatrix(0, 0, 40, 30));
+    matrix::gauss_straight(augmented.submatrix(0, 0, 40, 30));
+    matrix::gauss_reverse(augmented.submatrix(0, 0, 40, 30));
+    matrix::gauss_straight(part);
+    matrix::gauss_reverse(part);
+    ASSERT_EQ(matrix::matrix_t<double>(augmented.submatrix(0, 0, 40, 30).as_const()), part);
+
+    /* underdetermined system through views */
+    matrix::matrix_t<double> wide{{1, 2, 3}, {2, 4, 7}};
+    matrix::matrix_t<double> b{{1}, {3}};
+    auto solution = matrix::solve_linear_system(std::as_const(wide).view(), std::as_const(b).view());
+    ASSERT_EQ(solution.first.get_rows_number(), 3u);
+    ASSERT_EQ(solution.second.get_cols_number(), 1u);
+}
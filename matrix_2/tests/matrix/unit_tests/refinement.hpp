@@ -0,0 +1,76 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <stdexcept>
+
+#include "../../../matrix/refinement.hpp"
+#include "common.hpp"
+
+TEST(Refinement, Double) {
+    std::mt19937 gen(61);
+    const std::size_t size = 200;
+    auto a = random_matrix<double>(size, size, gen, -1.0, 1.0);
+    auto b = random_matrix<double>(size, 3, gen, -1.0, 1.0);
+
+    auto result = matrix::solve_refined(a, b);
+    ASSERT_FALSE(result.fallback);
+    ASSERT_GT(result.iterations, 0u);
+    ASSERT_LE(result.backward_error, std::numeric_limits<double>::epsilon() * std::sqrt(size));
+
+    matrix::matrix_t<double> expected = matrix::lu_decomposition_t<double>(a).solve(b);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < 3; ++j) {
+            ASSERT_NEAR(result.x[i][j], expected[i][j], 1e-10 * (std::abs(expected[i][j]) + 1.0));
+        }
+    }
+
+    matrix::thread_pool_t pool(4);
+    auto parallel = matrix::solve_refined(a, b, {}, matrix::execution_policy_t(pool));
+    ASSERT_EQ(parallel.x, result.x);
+    ASSERT_EQ(parallel.iterations, result.iterations);
+}
+
+TEST(Refinement, LongDouble) {
+    std::mt19937 gen(62);
+    const std::size_t size = 100;
+    auto a = random_matrix<long double>(size, size, gen, -1.0, 1.0);
+    auto b = random_matrix<long double>(size, 1, gen, -1.0, 1.0);
+
+    auto result = matrix::solve_refined(a, b);
+    ASSERT_FALSE(result.fallback);
+    ASSERT_LE(result.backward_error, std::numeric_limits<long double>::epsilon() * std::sqrt(size));
+
+    /* factorization in double needs less iterations */
+    auto from_double = matrix::solve_refined<long double, double>(a, b);
+    ASSERT_FALSE(from_double.fallback);
+    ASSERT_LT(from_double.iterations, result.iterations);
+}
+
+TEST(Refinement, Fallback) {
+    /* Hilbert matrix: cond ~ 1e13, refinement from float can't converge */
+    const std::size_t size = 10;
+    matrix::matrix_t<double> hilbert(size, size), b(size, 1);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            hilbert[i][j] = 1.0 / (i + j + 1);
+            b[i][0] += hilbert[i][j];
+        }
+    }
+
+    auto result = matrix::solve_refined(hilbert, b);
+    ASSERT_TRUE(result.fallback);
+    ASSERT_LE(result.backward_error, 1e-15);
+
+    /* elements are out of float range */
+    matrix::matrix_t<double> huge{{1e300, 1.0}, {1.0, 1e300}};
+    matrix::matrix_t<double> rhs{{1e300}, {1e300}};
+    auto scaled = matrix::solve_refined(huge, rhs);
+    ASSERT_TRUE(scaled.fallback);
+    ASSERT_NEAR(scaled.x[0][0], 1.0, 1e-12);
+
+    matrix::matrix_t<double> singular{{1.0, 2.0}, {2.0, 4.0}};
+    ASSERT_THROW(matrix::solve_refined(singular, rhs), std::runtime_error);
+    ASSERT_THROW(matrix::solve_refined(matrix::matrix_t<double>(2, 3), rhs), std::runtime_error);
+}
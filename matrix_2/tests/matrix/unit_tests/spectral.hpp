@@ -0,0 +1,137 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "../../../matrix/spectral.hpp"
+#include "common.hpp"
+
+namespace {
+
+/* max |U * diag(values) * V^T - A| */
+double reconstruction_error(const matrix::matrix_t<double>& a, const matrix::matrix_t<double>& u,
+                            const std::vector<double>& values, const matrix::matrix_t<double>& v) {
+    double ret = 0.0;
+    for(std::size_t i = 0; i < a.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < a.get_cols_number(); ++j) {
+            double sum = 0.0;
+            for(std::size_t k = 0; k < values.size(); ++k) {
+                sum += u[i][k] * values[k] * v[j][k];
+            }
+            ret = std::max(ret, std::abs(sum - a[i][j]));
+        }
+    }
+
+    return ret;
+}
+
+/* max |M^T * M - I| */
+double orthogonality_error(const matrix::matrix_t<double>& m) {
+    double ret = 0.0;
+    for(std::size_t i = 0; i < m.get_cols_number(); ++i) {
+        for(std::size_t j = 0; j < m.get_cols_number(); ++j) {
+            double sum = 0.0;
+            for(std::size_t k = 0; k < m.get_rows_number(); ++k) {
+                sum += m[k][i] * m[k][j];
+            }
+            ret = std::max(ret, std::abs(sum - ((i == j) ? 1.0 : 0.0)));
+        }
+    }
+
+    return ret;
+}
+
+} /* namespace */
+
+TEST(SymmetricEigen, Reconstruction) {
+    std::mt19937 gen(71);
+    for(std::size_t size : {1u, 2u, 3u, 35u, 150u}) {
+        auto a = random_matrix(size, size, gen, -1.0, 1.0);
+        for(std::size_t i = 0; i < size; ++i) {
+            for(std::size_t j = 0; j < i; ++j) {
+                a[j][i] = a[i][j];
+            }
+        }
+
+        auto result = matrix::symmetric_eigen(a);
+        ASSERT_EQ(result.values.size(), size);
+        ASSERT_TRUE(std::is_sorted(result.values.begin(), result.values.end()));
+        ASSERT_LT(reconstruction_error(a, result.vectors, result.values, result.vectors), 1e-12 * size);
+        ASSERT_LT(orthogonality_error(result.vectors), 1e-12 * size);
+
+        matrix::thread_pool_t pool(4);
+        auto parallel = matrix::symmetric_eigen(a, matrix::execution_policy_t(pool));
+        ASSERT_EQ(parallel.values, result.values);
+        ASSERT_EQ(parallel.vectors, result.vectors);
+    }
+}
+
+TEST(SymmetricEigen, KnownValues) {
+    matrix::matrix_t<double> a = {{2, 1, 0}, {1, 2, 0}, {0, 0, 5}};
+    auto result = matrix::symmetric_eigen(a);
+    ASSERT_NEAR(result.values[0], 1.0, 1e-14);
+    ASSERT_NEAR(result.values[1], 3.0, 1e-14);
+    ASSERT_NEAR(result.values[2], 5.0, 1e-14);
+    ASSERT_NEAR(std::abs(result.vectors[2][2]), 1.0, 1e-14);
+
+    /* only lower triangle is used */
+    matrix::matrix_t<double> lower = {{2, 7, 7}, {1, 2, 7}, {0, 0, 5}};
+    ASSERT_EQ(matrix::symmetric_eigen(lower).values, result.values);
+
+    /* repeated eigenvalues */
+    matrix::matrix_t<double> scalar(40, 40);
+    for(std::size_t i = 0; i < 40; ++i) {
+        scalar[i][i] = 3.0;
+    }
+    for(double value : matrix::symmetric_eigen(scalar).values) {
+        ASSERT_DOUBLE_EQ(value, 3.0);
+    }
+
+    ASSERT_THROW(matrix::symmetric_eigen(matrix::matrix_t<double>(2, 3)), std::runtime_error);
+}
+
+TEST(Svd, Reconstruction) {
+    std::mt19937 gen(72);
+    for(auto [rows, cols] : std::vector<std::pair<std::size_t, std::size_t>>{{1, 1}, {7, 1}, {120, 80}, {60, 91}, {64, 64}, {600, 150}}) {
+        auto a = random_matrix(rows, cols, gen, -1.0, 1.0);
+        auto result = matrix::svd(a);
+
+        std::size_t k = std::min(rows, cols);
+        ASSERT_EQ(result.values.size(), k);
+        ASSERT_EQ(result.u.get_rows_number(), rows);
+        ASSERT_EQ(result.u.get_cols_number(), k);
+        ASSERT_EQ(result.v.get_rows_number(), cols);
+        ASSERT_EQ(result.v.get_cols_number(), k);
+        ASSERT_TRUE(std::is_sorted(result.values.rbegin(), result.values.rend()));
+        ASSERT_LT(reconstruction_error(a, result.u, result.values, result.v), 1e-12 * k);
+        ASSERT_LT(orthogonality_error(result.u), 1e-12 * k);
+        ASSERT_LT(orthogonality_error(result.v), 1e-12 * k);
+
+        matrix::thread_pool_t pool(4);
+        auto parallel = matrix::svd(a, matrix::execution_policy_t(pool));
+        ASSERT_EQ(parallel.values, result.values);
+        ASSERT_EQ(parallel.u, result.u);
+        ASSERT_EQ(parallel.v, result.v);
+    }
+}
+
+TEST(Svd, RankDeficient) {
+    /* x * y^T has one singular value ||x|| * ||y|| */
+    std::vector<double> x = {1, 2, 2}, y = {3, 0, 4, 0};
+    matrix::matrix_t<double> a(3, 4);
+    for(std::size_t i = 0; i < 3; ++i) {
+        for(std::size_t j = 0; j < 4; ++j) {
+            a[i][j] = x[i] * y[j];
+        }
+    }
+
+    auto result = matrix::svd(a);
+    ASSERT_NEAR(result.values[0], 15.0, 1e-13);
+    ASSERT_NEAR(result.values[1], 0.0, 1e-13);
+    ASSERT_NEAR(result.values[2], 0.0, 1e-13);
+    ASSERT_LT(reconstruction_error(a, result.u, result.values, result.v), 1e-13);
+    ASSERT_LT(orthogonality_error(result.u), 1e-13);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <utility>
+
+#include "../../../matrix/matrix.hpp"
+
+/* matrix storage is the only user of aligned operator new, so its allocations are counted here */
+namespace {
+
+bool count_allocations = false;
+std::map<std::size_t, std::size_t> allocations; /* size in bytes -> count */
+
+}
+
+/*  the pair isn't inlined into callers, otherwise gcc sees free of pointer returned
+    by operator new and warns with -Wmismatched-new-delete */
+[[gnu::noinline]] void* operator new(std::size_t size, std::align_val_t alignment) {
+    if(count_allocations) {
+        ++allocations[size];
+    }
+
+    std::size_t align = static_cast<std::size_t>(alignment);
+    void* ret = std::aligned_alloc(align, (size + align - 1) / align * align);
+    if(!ret) {
+        throw std::bad_alloc();
+    }
+
+    return ret;
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+template<typename F>
+std::map<std::size_t, std::size_t> record_allocations(F func) {
+    allocations.clear();
+    count_allocations = true;
+    func();
+    count_allocations = false;
+    return allocations;
+}
+
+}
+
+TEST(Storage, Alignment) {
+    for(std::size_t cols : {1u, 3u, 100u, 128u, 256u, 1024u}) {
+        matrix::matrix_t<double> m(5, cols, 1.0);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&m[0][0]) % matrix::storage_alignment, 0u);
+        ASSERT_GE(m.get_leading_dimension(), cols);
+
+        for(std::size_t i = 0; i < m.get_rows_number(); ++i) {
+            ASSERT_EQ(&m[i][0], &m[0][0] + i * m.get_leading_dimension());
+            for(std::size_t j = 0; j < cols; ++j) {
+                ASSERT_EQ(m[i][j], 1.0);
+            }
+        }
+    }
+
+#ifdef MATRIX_ROW_PADDING
+    EXPECT_EQ(matrix::matrix_t<double>(4, 128).get_leading_dimension(), 136u);
+    EXPECT_EQ(matrix::matrix_t<double>(4, 100).get_leading_dimension(), 100u);
+#endif
+}
+
+TEST(Storage, Move) {
+    matrix::matrix_t<double> m(100, 100, 2.0);
+    const double* data = &m[0][0];
+
+    auto moved = record_allocations([&]() {
+        matrix::matrix_t<double> to(std::move(m));
+        EXPECT_EQ(&to[0][0], data);
+        EXPECT_EQ(m.get_elements_number(), 0u);
+
+        m = std::move(to);
+        EXPECT_EQ(&m[0][0], data);
+    });
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(m[99][99], 2.0);
+}
+
+TEST(Storage, ReturnsDontCopy) {
+    /* rank 2 system with 4 unknowns: partial solution 4 * 1, fundamental matrix 4 * 2 */
+    matrix::matrix_t<double> left{{1, 2, 0, 1}, {0, 1, 1, 0}, {1, 3, 1, 1}};
+    matrix::matrix_t<double> right{{1}, {2}, {3}};
+
+    std::pair<matrix::matrix_t<double>, matrix::matrix_t<double>> solution;
+    auto counted = record_allocations([&]() {solution = matrix::solve_linear_system(left, right);});
+
+    ASSERT_EQ(solution.first.get_rows_number(), 4u);
+    ASSERT_EQ(solution.second.get_cols_number(), 2u);
+    EXPECT_EQ(counted[4 * sizeof(double)], 1u);
+    EXPECT_EQ(counted[8 * sizeof(double)], 1u);
+
+    matrix::matrix_t<double> m(10, 10, 1.0);
+    auto resized = record_allocations([&]() {m.resize(20, 30);});
+    EXPECT_EQ(resized.size(), 1u);
+    EXPECT_EQ(resized[20 * 30 * sizeof(double)], 1u);
+}
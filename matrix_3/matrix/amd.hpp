@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "sparse.hpp"
+
+namespace matrix {
+
+/*
+    ***approximate minimum degree ordering***
+
+    elimination order of symmetric pattern A + A^T (diagonal is ignored), which keeps fill of
+    cholesky / LU factors small. Quotient graph: eliminated pivot becomes element, which
+    replaces clique of its neighbours; degree of variable is bounded by
+    |own variables| + |Lp| + sum of |Le \ Lp| over other elements (amestoy, davis, duff)
+
+    function contract:
+
+        1) m: n * n
+        2) return value: order[k] - k-th eliminated row / column
+*/
+template<typename T>
+std::vector<std::size_t> amd_order(const csc_matrix_t<T>& m);
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+std::vector<std::size_t> amd_order(const csc_matrix_t<T>& m) {
+    if(m.get_rows_number() != m.get_cols_number()) {
+        throw std::runtime_error("amd_order: matrix must be square");
+    }
+
+    const std::size_t n = m.get_cols_number();
+    const std::size_t none = std::numeric_limits<std::size_t>::max();
+    enum class state_t : char {variable, element, absorbed};
+
+    /* pattern of A + A^T without diagonal */
+    std::vector<std::vector<std::size_t>> variables(n);
+    {
+        const auto& ptr = m.get_col_ptr();
+        const auto& idx = m.get_row_idx();
+        for(std::size_t j = 0; j < n; ++j) {
+            for(std::size_t p = ptr[j]; p < ptr[j + 1]; ++p) {
+                if(idx[p] != j) {
+                    variables[j].push_back(idx[p]);
+                    variables[idx[p]].push_back(j);
+                }
+            }
+        }
+
+        for(auto&& adjacent : variables) {
+            std::sort(adjacent.begin(), adjacent.end());
+            adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> elements(n);      /* elements adjacent to variable */
+    std::vector<std::vector<std::size_t>> element_vars(n);  /* Le: variables of element */
+    std::vector<state_t> state(n, state_t::variable);
+    std::vector<std::size_t> degree(n);
+
+    /* degree lists */
+    std::vector<std::size_t> head(n + 1, none), next(n, none), prev(n, none);
+    auto insert = [&](std::size_t i) {
+        std::size_t d = degree[i];
+        next[i] = head[d];
+        prev[i] = none;
+        if(head[d] != none) {
+            prev[head[d]] = i;
+        }
+        head[d] = i;
+    };
+    auto remove = [&](std::size_t i) {
+        if(prev[i] != none) {
+            next[prev[i]] = next[i];
+        } else {
+            head[degree[i]] = next[i];
+        }
+
+        if(next[i] != none) {
+            prev[next[i]] = prev[i];
+        }
+    };
+
+    std::size_t min_degree = n;
+    for(std::size_t i = 0; i < n; ++i) {
+        degree[i] = variables[i].size();
+        insert(i);
+        min_degree = std::min(min_degree, degree[i]);
+    }
+
+    std::vector<std::size_t> mark(n, 0u), w_mark(n, 0u), w(n, 0u);
+    std::size_t stamp = 0u, w_stamp = 0u;
+
+    std::vector<std::size_t> order;
+    order.reserve(n);
+    std::vector<std::size_t> lp;
+
+    for(std::size_t k = 0; k < n; ++k) {
+        for(; head[min_degree] == none; ++min_degree) {}
+        std::size_t p = head[min_degree];
+        remove(p);
+        order.push_back(p);
+        state[p] = state_t::element;
+
+        /* Lp = variables adjacent to p and variables of its elements, they are absorbed by p */
+        ++stamp;
+        mark[p] = stamp;
+        lp.clear();
+        for(std::size_t e : elements[p]) {
+            if(state[e] != state_t::element) {
+                continue;
+            }
+
+            for(std::size_t i : element_vars[e]) {
+                if((state[i] == state_t::variable) && (mark[i] != stamp)) {
+                    mark[i] = stamp;
+                    lp.push_back(i);
+                }
+            }
+
+            state[e] = state_t::absorbed;
+            std::vector<std::size_t>().swap(element_vars[e]);
+        }
+
+        for(std::size_t i : variables[p]) {
+            if((state[i] == state_t::variable) && (mark[i] != stamp)) {
+                mark[i] = stamp;
+                lp.push_back(i);
+            }
+        }
+        std::vector<std::size_t>().swap(variables[p]);
+        std::vector<std::size_t>().swap(elements[p]);
+
+        /* edges inside Lp are represented by element p now */
+        for(std::size_t i : lp) {
+            remove(i);
+
+            auto& i_elements = elements[i];
+            i_elements.erase(std::remove_if(i_elements.begin(), i_elements.end(),
+                                            [&](std::size_t e) {return state[e] != state_t::element;}), i_elements.end());
+            i_elements.push_back(p);
+
+            auto& i_variables = variables[i];
+            i_variables.erase(std::remove_if(i_variables.begin(), i_variables.end(),
+                                             [&](std::size_t j) {return (state[j] != state_t::variable) || (mark[j] == stamp);}), i_variables.end());
+        }
+
+        /* w[e] = |Le \ Lp| for elements adjacent to Lp */
+        ++w_stamp;
+        for(std::size_t i : lp) {
+            for(std::size_t e : elements[i]) {
+                if(e == p) {
+                    continue;
+                }
+
+                if(w_mark[e] != w_stamp) {
+                    w_mark[e] = w_stamp;
+                    w[e] = element_vars[e].size();
+                }
+                --w[e];
+            }
+        }
+
+        std::size_t remaining = n - k - 1;
+        for(std::size_t i : lp) {
+            std::size_t d = variables[i].size() + lp.size() - 1;
+            for(std::size_t e : elements[i]) {
+                if(e == p) {
+                    continue;
+                }
+
+                /* aggressive absorption: element inside Lp is not needed any more */
+                if(w[e] == 0u) {
+                    state[e] = state_t::absorbed;
+                    std::vector<std::size_t>().swap(element_vars[e]);
+                    continue;
+                }
+
+                if(state[e] == state_t::element) {
+                    d += w[e];
+                }
+            }
+
+            degree[i] = std::min(d, remaining);
+            insert(i);
+            min_degree = std::min(min_degree, degree[i]);
+        }
+
+        element_vars[p] = lp;
+    }
+
+    return order;
+}
+
+} /* namespace matrix */
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+
+#include "matrix.hpp"
+#include "gemm.hpp"
+#include "execution.hpp"
+#include "matrix_chain.hpp"
+
+namespace matrix {
+
+/*  aligned buffers for temporary products, released buffer is given to the next request it fits
+    (the smallest of them), so repeated evaluations of the same chain don't allocate.
+    Thread safe: products of independent subchains take buffers concurrently */
+template<typename T>
+class buffer_pool_t final {
+public:
+    struct buffer_t {
+        T* data = nullptr;
+        std::size_t capacity = 0u;
+    };
+
+    buffer_t acquire(std::size_t size);
+    void release(buffer_t buffer);
+
+    /* memory owned by pool */
+    std::size_t get_bytes() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<detail::aligned_ptr_t<T>> storage_;
+    std::vector<buffer_t> free_;
+    std::size_t bytes_ = 0u;
+};
+
+struct chain_stats_t {
+    std::size_t flops = 0u;         /* 2 * m * n * k for every product */
+    std::size_t peak_bytes = 0u;    /* maximum of temporary products alive at the same time */
+    double seconds = 0.0;
+};
+
+/*
+    ***evaluation of matrix chain in given order***
+
+    order is list of splits (see Imatrix_chain_t), it's turned into tree of products,
+    children of node are independent, so they are computed concurrently on policy,
+    every product is gemm on the same policy. Temporaries are taken from buffer pool of evaluator.
+
+    function contract:
+
+        1) operands[i] : p_i * p_i+1
+        2) order - permutation of splits 0 .. n-2 valid for chain
+*/
+template<typename T>
+class chain_evaluator_t final {
+public:
+    explicit chain_evaluator_t(const execution_policy_t& policy = sequential_policy) : policy_(policy) {}
+
+    matrix_t<T> evaluate(const std::vector<const matrix_t<T>*>& operands, const std::vector<std::size_t>& order);
+
+    /* optimal order of Imatrix_chain_t */
+    matrix_t<T> evaluate(const std::vector<const matrix_t<T>*>& operands);
+
+    /* naive order ((A_0 * A_1) * A_2) ... */
+    matrix_t<T> evaluate_left_to_right(const std::vector<const matrix_t<T>*>& operands);
+
+    /* of last evaluation */
+    const chain_stats_t& get_stats() const {return stats_;}
+
+private:
+    struct node_t {
+        std::size_t left, right;    /* children, leaves are operands 0 .. n-1 */
+        std::size_t rows, cols, inner;
+        const T* data = nullptr;
+        std::size_t ld = 0u;
+        typename buffer_pool_t<T>::buffer_t buffer;
+    };
+
+    void compute(std::size_t node, T* result, std::size_t ldr);
+
+private:
+    execution_policy_t policy_;
+    buffer_pool_t<T> pool_;
+
+    std::vector<node_t> nodes_;
+    std::size_t leaves_ = 0u;
+
+    std::mutex stats_mutex_;
+    std::size_t live_bytes_ = 0u;
+    chain_stats_t stats_;
+};
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+typename buffer_pool_t<T>::buffer_t buffer_pool_t<T>::acquire(std::size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto best = free_.end();
+    for(auto it = free_.begin(); it != free_.end(); ++it) {
+        if((it->capacity >= size) && ((best == free_.end()) || (it->capacity < best->capacity))) {
+            best = it;
+        }
+    }
+
+    if(best != free_.end()) {
+        buffer_t ret = *best;
+        *best = free_.back();
+        free_.pop_back();
+        return ret;
+    }
+
+    storage_.push_back(detail::make_aligned_buffer<T>(size));
+    bytes_ += size * sizeof(T);
+    return {storage_.back().get(), size};
+}
+
+template<typename T>
+void buffer_pool_t<T>::release(buffer_t buffer) {
+    if(buffer.data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(buffer);
+    }
+}
+
+template<typename T>
+std::size_t buffer_pool_t<T>::get_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+template<typename T>
+matrix_t<T> chain_evaluator_t<T>::evaluate(const std::vector<const matrix_t<T>*>& operands, const std::vector<std::size_t>& order) {
+    leaves_ = operands.size();
+    if(!leaves_) {
+        throw std::runtime_error("chain_evaluator_t::evaluate: empty chain");
+    }
+
+    if(order.size() + 1 != leaves_) {
+        throw std::runtime_error("chain_evaluator_t::evaluate: invalid order");
+    }
+
+    nodes_.clear();
+    nodes_.reserve(2 * leaves_ - 1);
+    for(std::size_t i = 0; i < leaves_; ++i) {
+        const matrix_t<T>& m = *operands[i];
+        if(i && (operands[i - 1]->get_cols_number() != m.get_rows_number())) {
+            throw std::runtime_error("chain_evaluator_t::evaluate: invalid matrix sizes, can't multiplicate");
+        }
+
+        nodes_.push_back({i, i, m.get_rows_number(), m.get_cols_number(), 0u,
+                          m.get_elements_number() ? &m[0][0] : nullptr, m.get_leading_dimension(), {}});
+    }
+
+    /* begin[e] - first matrix of product ending with e, end[b] - last matrix of product starting with b, node[b] - its node */
+    std::vector<std::size_t> begin(leaves_), end(leaves_), node(leaves_);
+    std::iota(begin.begin(), begin.end(), 0u);
+    std::iota(end.begin(), end.end(), 0u);
+    std::iota(node.begin(), node.end(), 0u);
+    for(std::size_t k : order) {
+        if((k + 1 >= leaves_) || (end[begin[k]] != k) || (begin[end[k + 1]] != k + 1)) {
+            throw std::runtime_error("chain_evaluator_t::evaluate: invalid order");
+        }
+
+        std::size_t b = begin[k], e = end[k + 1];
+        const node_t& left = nodes_[node[b]];
+        const node_t& right = nodes_[node[k + 1]];
+        nodes_.push_back({node[b], node[k + 1], left.rows, right.cols, left.cols, nullptr, 0u, {}});
+        node[b] = nodes_.size() - 1;
+        end[b] = e;
+        begin[e] = b;
+    }
+
+    stats_ = chain_stats_t{};
+    live_bytes_ = 0u;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    const node_t& root = nodes_.back();
+    matrix_t<T> ret(root.rows, root.cols);
+    if(leaves_ == 1u) {
+        ret = *operands.front();
+    } else if(ret.get_elements_number()) {
+        compute(nodes_.size() - 1, &ret[0][0], ret.get_leading_dimension());
+    }
+
+    auto finish = std::chrono::high_resolution_clock::now();
+    stats_.seconds = std::chrono::duration<double>(finish - start).count();
+    return ret;
+}
+
+template<typename T>
+matrix_t<T> chain_evaluator_t<T>::evaluate(const std::vector<const matrix_t<T>*>& operands) {
+    Imatrix_chain_t chain;
+    for(auto&& operand : operands) {
+        chain.push(operand->get_rows_number(), operand->get_cols_number());
+    }
+
+    return evaluate(operands, chain.get_optimal_order());
+}
+
+template<typename T>
+matrix_t<T> chain_evaluator_t<T>::evaluate_left_to_right(const std::vector<const matrix_t<T>*>& operands) {
+    std::vector<std::size_t> order(operands.empty() ? 0u : operands.size() - 1);
+    std::iota(order.begin(), order.end(), 0u);
+    return evaluate(operands, order);
+}
+
+/* children are computed into buffers of pool, then released after product */
+template<typename T>
+void chain_evaluator_t<T>::compute(std::size_t index, T* result, std::size_t ldr) {
+    node_t& node = nodes_[index];
+    std::size_t children[] = {node.left, node.right};
+    std::size_t internal = 0u;
+    for(std::size_t child : children) {
+        if(child >= leaves_) {
+            node_t& c = nodes_[child];
+            c.buffer = pool_.acquire(c.rows * c.cols);
+            c.data = c.buffer.data;
+            c.ld = c.cols;
+            children[internal++] = child;
+
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            live_bytes_ += c.rows * c.cols * sizeof(T);
+            stats_.peak_bytes = std::max(stats_.peak_bytes, live_bytes_);
+        }
+    }
+
+    policy_.parallel_for(internal, [&](std::size_t i) {
+        node_t& c = nodes_[children[i]];
+        compute(children[i], c.buffer.data, c.ld);
+    });
+
+    const node_t& left = nodes_[node.left];
+    const node_t& right = nodes_[node.right];
+    for(std::size_t i = 0; i < node.rows; ++i) {
+        std::fill(result + i * ldr, result + i * ldr + node.cols, T{});
+    }
+
+    /* gemm adds product to result */
+    gemm(node.rows, node.cols, node.inner, left.data, left.ld, right.data, right.ld, result, ldr, policy_);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.flops += 2u * node.rows * node.cols * node.inner;
+    for(std::size_t i = 0; i < internal; ++i) {
+        node_t& c = nodes_[children[i]];
+        live_bytes_ -= c.rows * c.cols * sizeof(T);
+        pool_.release(c.buffer);
+        c.buffer = {};
+    }
+}
+
+} /* namespace matrix */
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "gemm.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+template<typename T>
+class matrix_t;
+
+/*
+    ***lazy matrix expressions***
+
+    A + B * c - D builds a tree of nodes instead of temporaries, the tree is evaluated
+    on assignment to matrix_t (or by evaluate / assign with execution policy):
+    all elementwise nodes are fused into one loop over tiles of the result.
+    Product node A * B calls gemm: directly into the result for "X = A * B" and
+    "X = E + A * B" (gemm accumulates), into its own buffer elsewhere.
+
+    Nodes keep pointers to matrices, so expression must be evaluated while they are alive,
+    don't store it in auto variable.
+
+    every node E provides:
+
+        1) value_type, get_rows_number(), get_cols_number()
+        2) operator()(i, j) - element of result
+        3) prepare(policy) - computes products before elementwise loop
+        4) aliases(data) - expression reads matrix with this data, so it can't be written in place
+*/
+template<typename E>
+struct expression_t {
+    const E& self() const {return static_cast<const E&>(*this);}
+};
+
+/* dest = expr, dest is resized if needed */
+template<typename T, typename E>
+void assign(matrix_t<T>& dest, const expression_t<E>& expr, const execution_policy_t& policy = sequential_policy);
+
+template<typename E>
+matrix_t<typename E::value_type> evaluate(const expression_t<E>& expr, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+class matrix_ref_t final : public expression_t<matrix_ref_t<T>> {
+public:
+    using value_type = T;
+
+    explicit matrix_ref_t(const matrix_t<T>& m) :
+        data_(m.get_elements_number() ? &m[0][0] : nullptr), rows_(m.get_rows_number()), cols_(m.get_cols_number()),
+        leading_dimension_(m.get_leading_dimension()) {}
+
+    std::size_t get_rows_number() const {return rows_;}
+    std::size_t get_cols_number() const {return cols_;}
+    const T* data() const {return data_;}
+    std::size_t get_leading_dimension() const {return leading_dimension_;}
+
+    T operator()(std::size_t i, std::size_t j) const {return data_[i * leading_dimension_ + j];}
+    void prepare(const execution_policy_t&) const {}
+    bool aliases(const void* data) const {return data_ && (data_ == data);}
+
+private:
+    const T* data_;
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t leading_dimension_;
+};
+
+template<typename L, typename R, typename Op>
+class binary_expression_t final : public expression_t<binary_expression_t<L, R, Op>> {
+public:
+    using value_type = typename L::value_type;
+
+    binary_expression_t(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+        if((lhs.get_rows_number() != rhs.get_rows_number()) || (lhs.get_cols_number() != rhs.get_cols_number())) {
+            throw std::runtime_error("matrix expression: sizes of operands don't match");
+        }
+    }
+
+    std::size_t get_rows_number() const {return lhs_.get_rows_number();}
+    std::size_t get_cols_number() const {return lhs_.get_cols_number();}
+    const L& lhs() const {return lhs_;}
+    const R& rhs() const {return rhs_;}
+
+    value_type operator()(std::size_t i, std::size_t j) const {return Op{}(lhs_(i, j), rhs_(i, j));}
+
+    void prepare(const execution_policy_t& policy) const {
+        lhs_.prepare(policy);
+        rhs_.prepare(policy);
+    }
+
+    bool aliases(const void* data) const {return lhs_.aliases(data) || rhs_.aliases(data);}
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+/* Op(element, scalar) */
+template<typename E, typename Op>
+class scalar_expression_t final : public expression_t<scalar_expression_t<E, Op>> {
+public:
+    using value_type = typename E::value_type;
+
+    scalar_expression_t(const E& expr, value_type scalar) : expr_(expr), scalar_(scalar) {}
+
+    std::size_t get_rows_number() const {return expr_.get_rows_number();}
+    std::size_t get_cols_number() const {return expr_.get_cols_number();}
+
+    value_type operator()(std::size_t i, std::size_t j) const {return Op{}(expr_(i, j), scalar_);}
+    void prepare(const execution_policy_t& policy) const {expr_.prepare(policy);}
+    bool aliases(const void* data) const {return expr_.aliases(data);}
+
+private:
+    E expr_;
+    value_type scalar_;
+};
+
+template<typename E>
+class negate_expression_t final : public expression_t<negate_expression_t<E>> {
+public:
+    using value_type = typename E::value_type;
+
+    explicit negate_expression_t(const E& expr) : expr_(expr) {}
+
+    std::size_t get_rows_number() const {return expr_.get_rows_number();}
+    std::size_t get_cols_number() const {return expr_.get_cols_number();}
+
+    value_type operator()(std::size_t i, std::size_t j) const {return -expr_(i, j);}
+    void prepare(const execution_policy_t& policy) const {expr_.prepare(policy);}
+    bool aliases(const void* data) const {return expr_.aliases(data);}
+
+private:
+    E expr_;
+};
+
+namespace detail {
+
+/* dest becomes rows * cols matrix of zeros */
+template<typename T>
+void reset_destination(matrix_t<T>& dest, std::size_t rows, std::size_t cols) {
+    if((dest.get_rows_number() != rows) || (dest.get_cols_number() != cols)) {
+        dest = matrix_t<T>();
+        dest.resize(rows, cols);
+        return;
+    }
+
+    for(std::size_t i = 0; i < rows; ++i) {
+        std::fill_n(&dest[i][0], cols, T{});
+    }
+}
+
+} /* namespace detail */
+
+template<typename L, typename R>
+class product_expression_t final : public expression_t<product_expression_t<L, R>> {
+public:
+    using value_type = typename L::value_type;
+
+    product_expression_t(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+        if(lhs.get_cols_number() != rhs.get_rows_number()) {
+            throw std::runtime_error("matrix expression: sizes of product operands don't match");
+        }
+    }
+
+    std::size_t get_rows_number() const {return lhs_.get_rows_number();}
+    std::size_t get_cols_number() const {return rhs_.get_cols_number();}
+
+    value_type operator()(std::size_t i, std::size_t j) const {return result_[i][j];}
+
+    /* product is needed elementwise, so it's computed into own buffer */
+    void prepare(const execution_policy_t& policy) const {
+        detail::reset_destination(result_, get_rows_number(), get_cols_number());
+        multiply_to(result_.get_elements_number() ? &result_[0][0] : nullptr, result_.get_leading_dimension(), policy);
+    }
+
+    bool aliases(const void* data) const {return lhs_.aliases(data) || rhs_.aliases(data);}
+
+    /* c += lhs * rhs, operands which are not plain matrices are evaluated first */
+    void multiply_to(value_type* c, std::size_t ldc, const execution_policy_t& policy) const {
+        std::size_t m = get_rows_number();
+        std::size_t n = get_cols_number();
+        std::size_t k = lhs_.get_cols_number();
+        if(!m || !n || !k) {
+            return;
+        }
+
+        matrix_t<value_type> lhs_storage, rhs_storage;
+        std::pair<const value_type*, std::size_t> a = operand_data(lhs_, lhs_storage, policy);
+        std::pair<const value_type*, std::size_t> b = operand_data(rhs_, rhs_storage, policy);
+        gemm(m, n, k, a.first, a.second, b.first, b.second, c, ldc, policy);
+    }
+
+private:
+    /* data and leading dimension of operand */
+    static std::pair<const value_type*, std::size_t> operand_data(const matrix_ref_t<value_type>& expr, matrix_t<value_type>&, const execution_policy_t&) {
+        return {expr.data(), expr.get_leading_dimension()};
+    }
+
+    template<typename E>
+    static std::pair<const value_type*, std::size_t> operand_data(const E& expr, matrix_t<value_type>& storage, const execution_policy_t& policy) {
+        assign(storage, expr, policy);
+        return {&storage[0][0], storage.get_leading_dimension()};
+    }
+
+private:
+    L lhs_;
+    R rhs_;
+    mutable matrix_t<value_type> result_;
+};
+
+namespace detail {
+
+template<typename T>
+struct is_expression : std::is_base_of<expression_t<T>, T> {};
+
+template<typename T>
+struct is_expression<matrix_t<T>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_expression_v = is_expression<std::decay_t<T>>::value;
+
+template<typename L, typename R>
+using enable_if_expressions_t = std::enable_if_t<is_expression_v<L> && is_expression_v<R>>;
+
+template<typename E, typename S>
+using enable_if_scalar_t = std::enable_if_t<is_expression_v<E> && std::is_arithmetic_v<S>>;
+
+/* matrices are taken by reference, nodes by value */
+template<typename T>
+matrix_ref_t<T> as_expression(const matrix_t<T>& m) {return matrix_ref_t<T>(m);}
+
+template<typename E>
+const E& as_expression(const expression_t<E>& expr) {return expr.self();}
+
+template<typename E>
+using expression_type_t = std::decay_t<decltype(as_expression(std::declval<const E&>()))>;
+
+template<typename T>
+void prepare_destination(matrix_t<T>& dest, std::size_t rows, std::size_t cols) {
+    if((dest.get_rows_number() != rows) || (dest.get_cols_number() != cols)) {
+        reset_destination(dest, rows, cols);
+    }
+}
+
+template<typename T, typename E>
+void assign_elementwise(matrix_t<T>& dest, const E& expr, const execution_policy_t& policy) {
+    /* products are computed before dest is resized, because they can read it */
+    expr.prepare(policy);
+    prepare_destination(dest, expr.get_rows_number(), expr.get_cols_number());
+
+    policy.parallel_for_tiles(dest.get_rows_number(), dest.get_cols_number(), tile_rows, tile_cols,
+                              [&](std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+        for(std::size_t i = row_begin; i < row_end; ++i) {
+            T* row = &dest[i][0];
+            for(std::size_t j = col_begin; j < col_end; ++j) {
+                row[j] = expr(i, j);
+            }
+        }
+    });
+}
+
+template<typename T, typename E>
+void assign_expression(matrix_t<T>& dest, const E& expr, const execution_policy_t& policy) {
+    assign_elementwise(dest, expr, policy);
+}
+
+template<typename T, typename L, typename R>
+void assign_expression(matrix_t<T>& dest, const product_expression_t<L, R>& expr, const execution_policy_t& policy) {
+    if(expr.aliases(dest.get_elements_number() ? &dest[0][0] : nullptr)) {
+        matrix_t<T> tmp;
+        assign_expression(tmp, expr, policy);
+        dest = std::move(tmp);
+        return;
+    }
+
+    reset_destination(dest, expr.get_rows_number(), expr.get_cols_number());
+    expr.multiply_to(dest.get_elements_number() ? &dest[0][0] : nullptr, dest.get_leading_dimension(), policy);
+}
+
+/* dest = expr + lhs * rhs: expr is written first, then gemm accumulates product */
+template<typename T, typename E, typename L, typename R>
+void assign_accumulate(matrix_t<T>& dest, const E& expr, const product_expression_t<L, R>& product, const execution_policy_t& policy) {
+    if(product.aliases(dest.get_elements_number() ? &dest[0][0] : nullptr)) {
+        assign_elementwise(dest, binary_expression_t<E, product_expression_t<L, R>, std::plus<>>(expr, product), policy);
+        return;
+    }
+
+    assign_expression(dest, expr, policy);
+    product.multiply_to(dest.get_elements_number() ? &dest[0][0] : nullptr, dest.get_leading_dimension(), policy);
+}
+
+template<typename T, typename E, typename L, typename R>
+void assign_expression(matrix_t<T>& dest, const binary_expression_t<E, product_expression_t<L, R>, std::plus<>>& expr, const execution_policy_t& policy) {
+    assign_accumulate(dest, expr.lhs(), expr.rhs(), policy);
+}
+
+template<typename T, typename L, typename R, typename E>
+void assign_expression(matrix_t<T>& dest, const binary_expression_t<product_expression_t<L, R>, E, std::plus<>>& expr, const execution_policy_t& policy) {
+    assign_accumulate(dest, expr.rhs(), expr.lhs(), policy);
+}
+
+template<typename T, typename L1, typename R1, typename L2, typename R2>
+void assign_expression(matrix_t<T>& dest, const binary_expression_t<product_expression_t<L1, R1>, product_expression_t<L2, R2>, std::plus<>>& expr,
+                       const execution_policy_t& policy) {
+    assign_accumulate(dest, expr.lhs(), expr.rhs(), policy);
+}
+
+} /* namespace detail */
+
+template<typename L, typename R, typename = detail::enable_if_expressions_t<L, R>>
+auto operator+(const L& lhs, const R& rhs) {
+    return binary_expression_t<detail::expression_type_t<L>, detail::expression_type_t<R>, std::plus<>>(
+        detail::as_expression(lhs), detail::as_expression(rhs));
+}
+
+template<typename L, typename R, typename = detail::enable_if_expressions_t<L, R>>
+auto operator-(const L& lhs, const R& rhs) {
+    return binary_expression_t<detail::expression_type_t<L>, detail::expression_type_t<R>, std::minus<>>(
+        detail::as_expression(lhs), detail::as_expression(rhs));
+}
+
+template<typename E, typename = std::enable_if_t<detail::is_expression_v<E>>>
+auto operator-(const E& expr) {
+    return negate_expression_t<detail::expression_type_t<E>>(detail::as_expression(expr));
+}
+
+/* matrix product, not elementwise */
+template<typename L, typename R, typename = detail::enable_if_expressions_t<L, R>>
+auto operator*(const L& lhs, const R& rhs) {
+    return product_expression_t<detail::expression_type_t<L>, detail::expression_type_t<R>>(
+        detail::as_expression(lhs), detail::as_expression(rhs));
+}
+
+template<typename E, typename S, typename = detail::enable_if_scalar_t<E, S>>
+auto operator*(const E& expr, S scalar) {
+    using expression_type = detail::expression_type_t<E>;
+    return scalar_expression_t<expression_type, std::multiplies<>>(
+        detail::as_expression(expr), static_cast<typename expression_type::value_type>(scalar));
+}
+
+template<typename S, typename E, typename = detail::enable_if_scalar_t<E, S>>
+auto operator*(S scalar, const E& expr) {
+    return expr * scalar;
+}
+
+template<typename E, typename S, typename = detail::enable_if_scalar_t<E, S>>
+auto operator/(const E& expr, S scalar) {
+    using expression_type = detail::expression_type_t<E>;
+    return scalar_expression_t<expression_type, std::divides<>>(
+        detail::as_expression(expr), static_cast<typename expression_type::value_type>(scalar));
+}
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T, typename E>
+void assign(matrix_t<T>& dest, const expression_t<E>& expr, const execution_policy_t& policy /* = sequential_policy */) {
+    static_assert(std::is_same_v<T, typename E::value_type>, "assign: types of matrix and expression must be the same");
+    detail::assign_expression(dest, expr.self(), policy);
+}
+
+template<typename E>
+matrix_t<typename E::value_type> evaluate(const expression_t<E>& expr, const execution_policy_t& policy /* = sequential_policy */) {
+    matrix_t<typename E::value_type> ret;
+    assign(ret, expr, policy);
+    return ret;
+}
+
+} /* namespace matrix */
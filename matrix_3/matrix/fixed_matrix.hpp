@@ -0,0 +1,585 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+#include "matrix.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+/*
+    ***matrix of compile time size***
+
+    elements are stored in object (no heap), row is T*, so m[i][j] has no proxy.
+    Operations are constexpr with constant bounds, so compiler unrolls them; determinant and
+    inverse up to 4 * 4 are closed formulas of cofactors, bigger ones - gauss with partial pivoting.
+
+    T can be simd vector, then one matrix holds lanes of several matrices (see batch functions below)
+*/
+template<typename T, std::size_t R, std::size_t C>
+class fixed_matrix_t final {
+public:
+    constexpr fixed_matrix_t() = default;
+    constexpr fixed_matrix_t(std::initializer_list<std::initializer_list<T>> init);
+    explicit fixed_matrix_t(const matrix_t<T>& m);
+
+    static constexpr fixed_matrix_t identity();
+
+    static constexpr std::size_t get_rows_number() {return R;}
+    static constexpr std::size_t get_cols_number() {return C;}
+
+    constexpr T* operator[](std::size_t idx) {return data_.data() + idx * C;}
+    constexpr const T* operator[](std::size_t idx) const {return data_.data() + idx * C;}
+
+    constexpr T* data() {return data_.data();}
+    constexpr const T* data() const {return data_.data();}
+
+    matrix_t<T> to_matrix() const;
+
+    bool operator==(const fixed_matrix_t& rhs) const;
+    bool operator!=(const fixed_matrix_t& rhs) const {return !(*this == rhs);}
+
+private:
+    std::array<T, R * C> data_{};
+};
+
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr fixed_matrix_t<T, R, C> operator*(const fixed_matrix_t<T, R, K>& lhs, const fixed_matrix_t<T, K, C>& rhs);
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, R, C> operator+(const fixed_matrix_t<T, R, C>& lhs, const fixed_matrix_t<T, R, C>& rhs);
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, R, C> operator-(const fixed_matrix_t<T, R, C>& lhs, const fixed_matrix_t<T, R, C>& rhs);
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, C, R> transposition(const fixed_matrix_t<T, R, C>& m);
+
+template<typename T, std::size_t N>
+constexpr T det(const fixed_matrix_t<T, N, N>& m);
+
+/* throws if matrix is singular */
+template<typename T, std::size_t N>
+constexpr fixed_matrix_t<T, N, N> inverse(const fixed_matrix_t<T, N, N>& m);
+
+/* X of A * X = B, gauss with partial pivoting, throws if A is singular */
+template<typename T, std::size_t N, std::size_t M>
+constexpr fixed_matrix_t<T, N, M> solve(const fixed_matrix_t<T, N, N>& a, const fixed_matrix_t<T, N, M>& b);
+
+/*
+    ***batch of small matrices***
+
+    structure of arrays: element (i, j) of all matrices is contiguous, so lanes of simd vector
+    are the same element of neighbouring matrices and closed formulas process them at once.
+    Batch is split into chunks, which are processed in parallel by policy.
+
+    det, inverse and solve are for N <= 4, they don't check determinant:
+    results for singular matrices are inf or nan, det can be checked by caller
+*/
+template<typename T, std::size_t R, std::size_t C>
+class fixed_batch_t final {
+public:
+    explicit fixed_batch_t(std::size_t count = 0u) : count_(count), data_(R * C * count) {}
+
+    std::size_t size() const {return count_;}
+
+    /* count values of element (i, j) */
+    T* element(std::size_t i, std::size_t j) {return data_.data() + (i * C + j) * count_;}
+    const T* element(std::size_t i, std::size_t j) const {return data_.data() + (i * C + j) * count_;}
+
+    fixed_matrix_t<T, R, C> get(std::size_t idx) const;
+    void set(std::size_t idx, const fixed_matrix_t<T, R, C>& m);
+
+private:
+    std::size_t count_;
+    std::vector<T> data_;
+};
+
+template<typename T, std::size_t N>
+std::vector<T> batch_det(const fixed_batch_t<T, N, N>& batch, const execution_policy_t& policy = sequential_policy);
+
+template<typename T, std::size_t N>
+fixed_batch_t<T, N, N> batch_inverse(const fixed_batch_t<T, N, N>& batch, const execution_policy_t& policy = sequential_policy);
+
+/* X of A * X = B by adjugate: X = adj(A) * B / det(A) */
+template<typename T, std::size_t N, std::size_t M>
+fixed_batch_t<T, N, M> batch_solve(const fixed_batch_t<T, N, N>& a, const fixed_batch_t<T, N, M>& b, const execution_policy_t& policy = sequential_policy);
+
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+fixed_batch_t<T, R, C> batch_multiply(const fixed_batch_t<T, R, K>& lhs, const fixed_batch_t<T, K, C>& rhs, const execution_policy_t& policy = sequential_policy);
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, R, C>::fixed_matrix_t(std::initializer_list<std::initializer_list<T>> init) {
+    if(init.size() != R) {
+        throw std::runtime_error("fixed_matrix_t: invalid number of rows");
+    }
+
+    std::size_t i = 0;
+    for(auto&& row : init) {
+        if(row.size() != C) {
+            throw std::runtime_error("fixed_matrix_t: invalid number of columns");
+        }
+
+        std::size_t j = 0;
+        for(auto&& elem : row) {
+            data_[i * C + j++] = elem;
+        }
+        ++i;
+    }
+}
+
+template<typename T, std::size_t R, std::size_t C>
+fixed_matrix_t<T, R, C>::fixed_matrix_t(const matrix_t<T>& m) {
+    if((m.get_rows_number() != R) || (m.get_cols_number() != C)) {
+        throw std::runtime_error("fixed_matrix_t: invalid matrix sizes");
+    }
+
+    for(std::size_t i = 0; i < R; ++i) {
+        for(std::size_t j = 0; j < C; ++j) {
+            data_[i * C + j] = m[i][j];
+        }
+    }
+}
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, R, C> fixed_matrix_t<T, R, C>::identity() {
+    static_assert(R == C, "fixed_matrix_t::identity: matrix must be square");
+    fixed_matrix_t ret;
+    for(std::size_t i = 0; i < R; ++i) {
+        ret[i][i] = T{1};
+    }
+
+    return ret;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+matrix_t<T> fixed_matrix_t<T, R, C>::to_matrix() const {
+    matrix_t<T> ret(R, C);
+    for(std::size_t i = 0; i < R; ++i) {
+        for(std::size_t j = 0; j < C; ++j) {
+            ret[i][j] = data_[i * C + j];
+        }
+    }
+
+    return ret;
+}
+
+/* with tolerance, as matrix_t */
+template<typename T, std::size_t R, std::size_t C>
+bool fixed_matrix_t<T, R, C>::operator==(const fixed_matrix_t& rhs) const {
+    for(std::size_t i = 0; i < R * C; ++i) {
+        if(!equal(data_[i], rhs.data_[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+namespace detail {
+
+template<typename T, std::size_t R, std::size_t K, std::size_t C, std::size_t... P>
+constexpr T fixed_dot(const fixed_matrix_t<T, R, K>& lhs, const fixed_matrix_t<T, K, C>& rhs, std::size_t i, std::size_t j, std::index_sequence<P...>) {
+    return ((lhs[i][P] * rhs[P][j]) + ...);
+}
+
+template<typename T>
+constexpr T fixed_abs(const T& value) {
+    return (value < T{}) ? -value : value;
+}
+
+/* determinant and adjugate (det * inverse) for N <= 4, they have no branches, so T can be simd vector */
+template<typename T, std::size_t N>
+constexpr T closed_det(const fixed_matrix_t<T, N, N>& a) {
+    static_assert(N <= 4u, "closed_det: only matrices up to 4 * 4");
+    if constexpr(N == 1u) {
+        return a[0][0];
+    } else if constexpr(N == 2u) {
+        return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    } else if constexpr(N == 3u) {
+        return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+             - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0])
+             + a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    } else {
+        /* 2 * 2 minors of first two rows (s) and last two rows (c) */
+        T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+        T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+        T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+        T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+        T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+        T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+        T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+        T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+        T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+        T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+        T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+        T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr fixed_matrix_t<T, N, N> adjugate(const fixed_matrix_t<T, N, N>& a) {
+    static_assert(N <= 4u, "adjugate: only matrices up to 4 * 4");
+    fixed_matrix_t<T, N, N> b;
+    if constexpr(N == 1u) {
+        b[0][0] = T{} + 1; /* every lane of vector type */
+    } else if constexpr(N == 2u) {
+        b[0][0] = a[1][1];  b[0][1] = -a[0][1];
+        b[1][0] = -a[1][0]; b[1][1] = a[0][0];
+    } else if constexpr(N == 3u) {
+        b[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+        b[0][1] = a[0][2] * a[2][1] - a[0][1] * a[2][2];
+        b[0][2] = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+        b[1][0] = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+        b[1][1] = a[0][0] * a[2][2] - a[0][2] * a[2][0];
+        b[1][2] = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+        b[2][0] = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+        b[2][1] = a[0][1] * a[2][0] - a[0][0] * a[2][1];
+        b[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    } else {
+        T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+        T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+        T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+        T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+        T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+        T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+        T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+        T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+        T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+        T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+        T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+        T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+        b[0][0] = a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3;
+        b[0][1] = -a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3;
+        b[0][2] = a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3;
+        b[0][3] = -a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3;
+        b[1][0] = -a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1;
+        b[1][1] = a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1;
+        b[1][2] = -a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1;
+        b[1][3] = a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1;
+        b[2][0] = a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0;
+        b[2][1] = -a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0;
+        b[2][2] = a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0;
+        b[2][3] = -a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0;
+        b[3][0] = -a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0;
+        b[3][1] = a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0;
+        b[3][2] = -a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0;
+        b[3][3] = a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0;
+    }
+
+    return b;
+}
+
+/* a is reduced to upper triangle, the same row operations are applied to b, returns false if a is singular */
+template<typename T, std::size_t N, std::size_t M>
+constexpr bool fixed_gauss(fixed_matrix_t<T, N, N>& a, fixed_matrix_t<T, N, M>& b, T& det) {
+    det = T{1};
+    for(std::size_t k = 0; k < N; ++k) {
+        std::size_t pivot = k;
+        for(std::size_t i = k + 1; i < N; ++i) {
+            if(fixed_abs(a[i][k]) > fixed_abs(a[pivot][k])) {
+                pivot = i;
+            }
+        }
+
+        if(a[pivot][k] == T{}) {
+            det = T{};
+            return false;
+        }
+
+        if(pivot != k) {
+            det = -det;
+            for(std::size_t j = 0; j < N; ++j) {
+                std::swap(a[k][j], a[pivot][j]);
+            }
+            for(std::size_t j = 0; j < M; ++j) {
+                std::swap(b[k][j], b[pivot][j]);
+            }
+        }
+
+        det *= a[k][k];
+        for(std::size_t i = k + 1; i < N; ++i) {
+            T factor = a[i][k] / a[k][k];
+            for(std::size_t j = k; j < N; ++j) {
+                a[i][j] -= factor * a[k][j];
+            }
+            for(std::size_t j = 0; j < M; ++j) {
+                b[i][j] -= factor * b[k][j];
+            }
+        }
+    }
+
+    return true;
+}
+
+/* simd vector of the widest enabled instruction set for float and double, scalar for other types */
+#if defined(__AVX512F__)
+constexpr std::size_t simd_bytes = 64u;
+#elif defined(__AVX__)
+constexpr std::size_t simd_bytes = 32u;
+#else
+constexpr std::size_t simd_bytes = 16u;
+#endif
+
+template<typename T>
+struct simd_traits_t {
+    using type = T;
+    static constexpr std::size_t lanes = 1u;
+};
+
+template<>
+struct simd_traits_t<float> {
+    typedef float type __attribute__((vector_size(simd_bytes)));
+    static constexpr std::size_t lanes = simd_bytes / sizeof(float);
+};
+
+template<>
+struct simd_traits_t<double> {
+    typedef double type __attribute__((vector_size(simd_bytes)));
+    static constexpr std::size_t lanes = simd_bytes / sizeof(double);
+};
+
+/* matrices of batch in one task, multiple of any lanes number */
+const std::size_t batch_chunk = 1024u;
+
+/* kernel.operator()<V>(idx) processes matrices idx .. idx + lanes of V, tail of chunk is scalar */
+template<typename T, typename F>
+void batch_for(std::size_t count, F kernel, const execution_policy_t& policy) {
+    using vector_type = typename simd_traits_t<T>::type;
+    constexpr std::size_t lanes = simd_traits_t<T>::lanes;
+
+    policy.parallel_for((count + batch_chunk - 1) / batch_chunk, [&](std::size_t task) {
+        std::size_t idx = task * batch_chunk, end = std::min(idx + batch_chunk, count);
+        for(; idx + lanes <= end; idx += lanes) {
+            kernel.template operator()<vector_type>(idx);
+        }
+
+        for(; idx < end; ++idx) {
+            kernel.template operator()<T>(idx);
+        }
+    });
+}
+
+template<typename V, typename T>
+V batch_load(const T* src) {
+    V ret;
+    std::memcpy(&ret, src, sizeof(V));
+    return ret;
+}
+
+template<typename V, typename T>
+void batch_store(T* dst, const V& value) {
+    std::memcpy(dst, &value, sizeof(V));
+}
+
+template<typename V, typename T, std::size_t R, std::size_t C>
+fixed_matrix_t<V, R, C> batch_get(const fixed_batch_t<T, R, C>& batch, std::size_t idx) {
+    fixed_matrix_t<V, R, C> ret;
+    for(std::size_t i = 0; i < R; ++i) {
+        for(std::size_t j = 0; j < C; ++j) {
+            ret[i][j] = batch_load<V>(batch.element(i, j) + idx);
+        }
+    }
+
+    return ret;
+}
+
+template<typename V, typename T, std::size_t R, std::size_t C>
+void batch_put(fixed_batch_t<T, R, C>& batch, std::size_t idx, const fixed_matrix_t<V, R, C>& m) {
+    for(std::size_t i = 0; i < R; ++i) {
+        for(std::size_t j = 0; j < C; ++j) {
+            batch_store(batch.element(i, j) + idx, m[i][j]);
+        }
+    }
+}
+
+} /* namespace detail */
+
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr fixed_matrix_t<T, R, C> operator*(const fixed_matrix_t<T, R, K>& lhs, const fixed_matrix_t<T, K, C>& rhs) {
+    fixed_matrix_t<T, R, C> ret;
+    for(std::size_t i = 0; i < R; ++i) {
+        for(std::size_t j = 0; j < C; ++j) {
+            ret[i][j] = detail::fixed_dot(lhs, rhs, i, j, std::make_index_sequence<K>{});
+        }
+    }
+
+    return ret;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, R, C> operator+(const fixed_matrix_t<T, R, C>& lhs, const fixed_matrix_t<T, R, C>& rhs) {
+    fixed_matrix_t<T, R, C> ret;
+    for(std::size_t i = 0; i < R * C; ++i) {
+        ret.data()[i] = lhs.data()[i] + rhs.data()[i];
+    }
+
+    return ret;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, R, C> operator-(const fixed_matrix_t<T, R, C>& lhs, const fixed_matrix_t<T, R, C>& rhs) {
+    fixed_matrix_t<T, R, C> ret;
+    for(std::size_t i = 0; i < R * C; ++i) {
+        ret.data()[i] = lhs.data()[i] - rhs.data()[i];
+    }
+
+    return ret;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr fixed_matrix_t<T, C, R> transposition(const fixed_matrix_t<T, R, C>& m) {
+    fixed_matrix_t<T, C, R> ret;
+    for(std::size_t i = 0; i < R; ++i) {
+        for(std::size_t j = 0; j < C; ++j) {
+            ret[j][i] = m[i][j];
+        }
+    }
+
+    return ret;
+}
+
+template<typename T, std::size_t N>
+constexpr T det(const fixed_matrix_t<T, N, N>& m) {
+    if constexpr(N <= 4u) {
+        return detail::closed_det(m);
+    } else {
+        fixed_matrix_t<T, N, N> a = m;
+        fixed_matrix_t<T, N, 0u> b;
+        T ret{};
+        detail::fixed_gauss(a, b, ret);
+        return ret;
+    }
+}
+
+template<typename T, std::size_t N>
+constexpr fixed_matrix_t<T, N, N> inverse(const fixed_matrix_t<T, N, N>& m) {
+    if constexpr(N <= 4u) {
+        T d = detail::closed_det(m);
+        if(d == T{}) {
+            throw std::runtime_error("inverse: matrix is singular");
+        }
+
+        fixed_matrix_t<T, N, N> ret = detail::adjugate(m);
+        for(std::size_t i = 0; i < N * N; ++i) {
+            ret.data()[i] /= d;
+        }
+        return ret;
+    } else {
+        return solve(m, fixed_matrix_t<T, N, N>::identity());
+    }
+}
+
+template<typename T, std::size_t N, std::size_t M>
+constexpr fixed_matrix_t<T, N, M> solve(const fixed_matrix_t<T, N, N>& a, const fixed_matrix_t<T, N, M>& b) {
+    fixed_matrix_t<T, N, N> u = a;
+    fixed_matrix_t<T, N, M> x = b;
+    T d{};
+    if(!detail::fixed_gauss(u, x, d)) {
+        throw std::runtime_error("solve: matrix is singular");
+    }
+
+    for(std::size_t k = N; k-- > 0;) {
+        for(std::size_t j = 0; j < M; ++j) {
+            T sum = x[k][j];
+            for(std::size_t p = k + 1; p < N; ++p) {
+                sum -= u[k][p] * x[p][j];
+            }
+            x[k][j] = sum / u[k][k];
+        }
+    }
+
+    return x;
+}
+
+template<typename T, std::size_t R, std::size_t C>
+fixed_matrix_t<T, R, C> fixed_batch_t<T, R, C>::get(std::size_t idx) const {
+    return detail::batch_get<T>(*this, idx);
+}
+
+template<typename T, std::size_t R, std::size_t C>
+void fixed_batch_t<T, R, C>::set(std::size_t idx, const fixed_matrix_t<T, R, C>& m) {
+    detail::batch_put(*this, idx, m);
+}
+
+template<typename T, std::size_t N>
+std::vector<T> batch_det(const fixed_batch_t<T, N, N>& batch, const execution_policy_t& policy /* = sequential_policy */) {
+    static_assert(N <= 4u, "batch_det: only matrices up to 4 * 4");
+    std::vector<T> ret(batch.size());
+    detail::batch_for<T>(batch.size(), [&]<typename V>(std::size_t idx) {
+        detail::batch_store(ret.data() + idx, detail::closed_det(detail::batch_get<V>(batch, idx)));
+    }, policy);
+
+    return ret;
+}
+
+template<typename T, std::size_t N>
+fixed_batch_t<T, N, N> batch_inverse(const fixed_batch_t<T, N, N>& batch, const execution_policy_t& policy /* = sequential_policy */) {
+    static_assert(N <= 4u, "batch_inverse: only matrices up to 4 * 4");
+    fixed_batch_t<T, N, N> ret(batch.size());
+    detail::batch_for<T>(batch.size(), [&]<typename V>(std::size_t idx) {
+        fixed_matrix_t<V, N, N> m = detail::batch_get<V>(batch, idx);
+        V scale = V{} + T{1};
+        scale /= detail::closed_det(m);
+
+        fixed_matrix_t<V, N, N> inv = detail::adjugate(m);
+        for(std::size_t i = 0; i < N * N; ++i) {
+            inv.data()[i] *= scale;
+        }
+        detail::batch_put(ret, idx, inv);
+    }, policy);
+
+    return ret;
+}
+
+template<typename T, std::size_t N, std::size_t M>
+fixed_batch_t<T, N, M> batch_solve(const fixed_batch_t<T, N, N>& a, const fixed_batch_t<T, N, M>& b, const execution_policy_t& policy /* = sequential_policy */) {
+    static_assert(N <= 4u, "batch_solve: only matrices up to 4 * 4");
+    if(a.size() != b.size()) {
+        throw std::runtime_error("batch_solve: batches of different sizes");
+    }
+
+    fixed_batch_t<T, N, M> ret(a.size());
+    detail::batch_for<T>(a.size(), [&]<typename V>(std::size_t idx) {
+        fixed_matrix_t<V, N, N> m = detail::batch_get<V>(a, idx);
+        V scale = V{} + T{1};
+        scale /= detail::closed_det(m);
+
+        fixed_matrix_t<V, N, M> x = detail::adjugate(m) * detail::batch_get<V>(b, idx);
+        for(std::size_t i = 0; i < N * M; ++i) {
+            x.data()[i] *= scale;
+        }
+        detail::batch_put(ret, idx, x);
+    }, policy);
+
+    return ret;
+}
+
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+fixed_batch_t<T, R, C> batch_multiply(const fixed_batch_t<T, R, K>& lhs, const fixed_batch_t<T, K, C>& rhs, const execution_policy_t& policy /* = sequential_policy */) {
+    if(lhs.size() != rhs.size()) {
+        throw std::runtime_error("batch_multiply: batches of different sizes");
+    }
+
+    fixed_batch_t<T, R, C> ret(lhs.size());
+    detail::batch_for<T>(lhs.size(), [&]<typename V>(std::size_t idx) {
+        detail::batch_put(ret, idx, detail::batch_get<V>(lhs, idx) * detail::batch_get<V>(rhs, idx));
+    }, policy);
+
+    return ret;
+}
+
+} /* namespace matrix */
@@ -8,8 +8,15 @@
 #include <iostream>
 #include <optional>
 #include <iomanip>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
 
 #include "matrix_buffer.hpp"
+#include "matrix_view.hpp"
+#include "gemm.hpp"
+#include "execution.hpp"
+#include "expression.hpp"
 
 namespace matrix {
 
@@ -34,16 +41,35 @@ public:
     using matrix_buff_t<T>::get_rows_number;
     using matrix_buff_t<T>::get_cols_number;
     using matrix_buff_t<T>::get_elements_number;
+    using matrix_buff_t<T>::get_leading_dimension;
 
     matrix_t() : matrix_buff_t<T>(0u, 0u) {}
     matrix_t(const matrix_t& rhs);
     matrix_t(std::size_t rows, std::size_t cols, T val = T{});
     matrix_t(const std::initializer_list<std::initializer_list<T>>& init);
+    explicit matrix_t(const_matrix_view_t<T> v);
     matrix_t& operator=(const matrix_t& rhs);
+    matrix_t(matrix_t&& rhs) noexcept = default;
+    matrix_t& operator=(matrix_t&& rhs) noexcept = default;
     ~matrix_t() = default;
 
+    /* evaluation of lazy expression (see expression.hpp) */
+    template<typename E> matrix_t(const expression_t<E>& expr);
+    template<typename E> matrix_t& operator=(const expression_t<E>& expr);
+
     void resize(std::size_t rows, std::size_t cols);
 
+    /* views of elements, they are valid until storage is reallocated (resize, insert_col, assignment) */
+    matrix_view_t<T> view() {return {get_ptr(0u, 0u), get_rows_number(), get_cols_number(), get_leading_dimension()};}
+    const_matrix_view_t<T> view() const {return {get_ptr(0u, 0u), get_rows_number(), get_cols_number(), get_leading_dimension()};}
+
+    matrix_view_t<T> submatrix(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) {
+        return view().submatrix(row, col, rows, cols);
+    }
+    const_matrix_view_t<T> submatrix(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+        return view().submatrix(row, col, rows, cols);
+    }
+
     /*  
         insert colomn on idx position
 
@@ -93,7 +119,20 @@ std::istream& operator>>(std::istream& in,  matrix::matrix_t<T>& m);
       
 */
 template<typename T>
-matrix_t<T> multiplication(const matrix_t<T>& lhs, const matrix_t<T>& rhs);
+matrix_t<T> multiplication(const matrix_t<T>& lhs, const matrix_t<T>& rhs, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+matrix_t<T> multiplication(const_matrix_view_t<T> lhs, const_matrix_view_t<T> rhs, const execution_policy_t& policy = sequential_policy);
+
+/* lhs and rhs must have the same sizes */
+template<typename T>
+matrix_t<T> addition(const matrix_t<T>& lhs, const matrix_t<T>& rhs, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+matrix_t<T> transposition(const matrix_t<T>& m, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+matrix_t<T> transposition(const_matrix_view_t<T> m, const execution_policy_t& policy = sequential_policy);
 
 /* 
     ***solve linear system***
@@ -110,12 +149,81 @@ matrix_t<T> multiplication(const matrix_t<T>& lhs, const matrix_t<T>& rhs);
 template<typename T>
 std::pair<matrix_t<T>, matrix_t<T>> solve_linear_system(const matrix_t<T>& left, const matrix_t<T>& right);
 
+template<typename T>
+std::pair<matrix_t<T>, matrix_t<T>> solve_linear_system(const_matrix_view_t<T> left, const_matrix_view_t<T> right);
+
+
+/*  row operations of every pivot step are split into 2D tiles of policy,
+    view overloads work in place, e.g. on left part of augmented matrix */
+template<typename T>
+void gauss_straight(matrix_t<T>& m, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+void gauss_straight(matrix_view_t<T> m, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+void gauss_reverse(matrix_t<T>& m, const execution_policy_t& policy = sequential_policy);
 
 template<typename T>
-void gauss_straight(matrix_t<T>& m);
+void gauss_reverse(matrix_view_t<T> m, const execution_policy_t& policy = sequential_policy);
 
+/*
+    ***LU decomposition with partial pivoting: P * A = L * U***
+
+    right-looking blocked algorithm: panel of block_size columns is factorized by row operations,
+    then block row of U is found by triangular solve and trailing submatrix is updated by gemm.
+    L (with unit diagonal) and U are stored in one matrix
+
+    function contract:
+
+        1) matrix must be square
+        2) T - floating point type
+*/
 template<typename T>
-void gauss_reverse(matrix_t<T>& m);
+class lu_decomposition_t final {
+public:
+    static const std::size_t block_size = 64u;
+
+    explicit lu_decomposition_t(const matrix_t<T>& m, const execution_policy_t& policy = sequential_policy);
+    explicit lu_decomposition_t(const_matrix_view_t<T> m, const execution_policy_t& policy = sequential_policy);
+
+    std::size_t size() const {return lu_.get_rows_number();}
+
+    /* some pivot is exactly zero */
+    bool singular() const {return singular_;}
+    /* some pivot is zero with tolerance */
+    bool degenerate() const;
+
+    T det() const;
+
+    /* X: A * X = rhs, rhs - n * k matrix */
+    matrix_t<T> solve(const matrix_t<T>& rhs) const {return solve(rhs.view());}
+    matrix_t<T> solve(const_matrix_view_t<T> rhs) const;
+    matrix_t<T> inverse() const;
+
+    const matrix_t<T>& get_lu() const {return lu_;}
+    /* i-th row of P * A is permutation[i]-th row of A */
+    const std::vector<std::size_t>& get_permutation() const {return permutation_;}
+
+private:
+    void factorize_panel(std::size_t k0, std::size_t kb);
+    void solve_block_row(std::size_t k0, std::size_t kb);
+    void update_trailing(std::size_t k0, std::size_t kb);
+
+    /* c -= a * b */
+    void subtract_product(const_matrix_view_t<T> a, const_matrix_view_t<T> b, matrix_view_t<T> c) const;
+
+private:
+    matrix_t<T> lu_;
+    std::vector<std::size_t> permutation_;
+    bool odd_permutation_ = false;
+    bool singular_ = false;
+    execution_policy_t policy_;
+};
+
+/* inverse of square matrix, throws if it's singular */
+template<typename T>
+matrix_t<T> inverse(const matrix_t<T>& m, const execution_policy_t& policy = sequential_policy);
 
 /* ------------------------------------------------------------------
                         IMPLEMENTATION
@@ -165,6 +273,29 @@ matrix_t<T>::matrix_t(const std::initializer_list<std::initializer_list<T>>& ini
     }
 }
 
+template<typename T>
+matrix_t<T>::matrix_t(const_matrix_view_t<T> v) : matrix_buff_t<T>(v.get_rows_number(), v.get_cols_number()) {
+    for(std::size_t i = 0, maxi = get_rows_number(); i < maxi; ++i) {
+        auto row = v[i];
+        for(std::size_t j = 0, maxj = get_cols_number(); j < maxj; ++j) {
+            construct_at(i, j, row[j]);
+        }
+    }
+}
+
+template<typename T>
+template<typename E>
+matrix_t<T>::matrix_t(const expression_t<E>& expr) : matrix_buff_t<T>(0u, 0u) {
+    assign(*this, expr);
+}
+
+template<typename T>
+template<typename E>
+matrix_t<T>& matrix_t<T>::operator=(const expression_t<E>& expr) {
+    assign(*this, expr);
+    return *this;
+}
+
 template<typename T>
 void matrix_t<T>::resize(std::size_t rows, std::size_t cols) {
     matrix_t<T> tmp;
@@ -259,49 +390,29 @@ std::size_t matrix::matrix_t<T>::max_abs_col_elem(std::size_t idx, std::size_t s
 
 template<typename T>
 T matrix::matrix_t<T>::det() const {
-    long double ret = 1.0;
-
-    matrix_t<double> copy = *this;
-
-    std::size_t current_m = 0;
-    std::size_t current_n = 0;
-
-    std::size_t max_m = copy.get_rows_number();
-    std::size_t max_n = copy.get_cols_number();
-
-    while((current_m < max_m) && (current_n < max_n)) {
-        std::size_t max_elem = copy.max_abs_col_elem(current_n, current_m, max_m);
-        if(copy[max_elem][current_n] == 0) {
-            ++current_n;
-            continue;
-        }
-
-        if(max_elem != current_m) {
-            ret *= -1;
-            copy.swap_rows(max_elem, current_m);
-        }
-
-        for(std::size_t i = current_m + 1; i < max_m; ++i) {
-            double f = copy[i][current_n] / copy[current_m][current_n];
-            copy[i][current_n] = 0.0;
-            for (std::size_t j = current_n + 1; j < max_n; ++j) {
-                copy[i][j] = copy[i][j] - f * copy[current_m][j];
-            }
-        }
-
-        ++current_m;
-        ++current_n;
+    if(get_rows_number() != get_cols_number()) {
+        throw std::runtime_error("matrix_t::det: matrix is not square");
     }
 
-    for(std::size_t i = 0lu, max = copy.get_cols_number(); i < max; ++i) {
-        if(std::abs(ret) < tolerance) {
-            return 0.0;
+    /* integer matrices are decomposed in double */
+    using value_t = std::conditional_t<std::is_same_v<T, long double>, long double, double>;
+    matrix_t<value_t> copy(get_rows_number(), get_cols_number());
+    for(std::size_t i = 0, maxi = get_rows_number(); i < maxi; ++i) {
+        for(std::size_t j = 0, maxj = get_cols_number(); j < maxj; ++j) {
+            copy[i][j] = static_cast<value_t>(at(i, j));
         }
+    }
 
-        ret *= copy[i][i];
+    value_t ret = lu_decomposition_t<value_t>(copy).det();
+    if(std::abs(ret) < tolerance) {
+        return T{};
     }
 
-    return ret;
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<T>(std::llround(ret));
+    } else {
+        return static_cast<T>(ret);
+    }
 }
 
 template<typename T>
@@ -370,30 +481,77 @@ std::istream& matrix::operator>>(std::istream& in,  matrix::matrix_t<T>& m) {
 }
 
 template<typename T>
-matrix::matrix_t<T> matrix::multiplication(const matrix_t<T>& lhs, const matrix_t<T>& rhs) {
-    std::size_t ret_m = lhs.get_rows_number();
-    std::size_t ret_n = rhs.get_cols_number();
+matrix::matrix_t<T> matrix::multiplication(const matrix_t<T>& lhs, const matrix_t<T>& rhs, const execution_policy_t& policy /* = sequential_policy */) {
+    return multiplication(lhs.view(), rhs.view(), policy);
+}
 
-    matrix_t<T> ret{ret_m, ret_n};
-    for(std::size_t i = 0, maxi = ret_m; i < maxi; ++i) {
-        for(std::size_t j = 0, maxj = ret_n; j < maxj; ++j) {
-            T elem{};
-            for(std::size_t k = 0, maxk = lhs.get_cols_number(); k < maxk; ++k) {
-                elem += (lhs[i][k] * rhs[k][j]);
-            }
+template<typename T>
+matrix::matrix_t<T> matrix::multiplication(const_matrix_view_t<T> lhs, const_matrix_view_t<T> rhs, const execution_policy_t& policy /* = sequential_policy */) {
+    matrix_t<T> ret{lhs.get_rows_number(), rhs.get_cols_number()};
+    gemm(lhs, rhs, ret.view(), policy);
+    return ret;
+}
 
-            ret[i][j] = elem;
+template<typename T>
+matrix::matrix_t<T> matrix::addition(const matrix_t<T>& lhs, const matrix_t<T>& rhs, const execution_policy_t& policy /* = sequential_policy */) {
+    matrix_t<T> ret{lhs.get_rows_number(), lhs.get_cols_number()};
+
+    policy.parallel_for_tiles(ret.get_rows_number(), ret.get_cols_number(), tile_rows, tile_cols,
+                              [&](std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+        for(std::size_t i = row_begin; i < row_end; ++i) {
+            for(std::size_t j = col_begin; j < col_end; ++j) {
+                ret[i][j] = lhs[i][j] + rhs[i][j];
+            }
         }
+    });
 
-    }
+    return ret;
+}
+
+template<typename T>
+matrix::matrix_t<T> matrix::transposition(const matrix_t<T>& m, const execution_policy_t& policy /* = sequential_policy */) {
+    return transposition(m.view(), policy);
+}
+
+template<typename T>
+matrix::matrix_t<T> matrix::transposition(const_matrix_view_t<T> m, const execution_policy_t& policy /* = sequential_policy */) {
+    matrix_t<T> ret{m.get_cols_number(), m.get_rows_number()};
+
+    /* square tiles, so both reading rows and writing columns stay in cache */
+    policy.parallel_for_tiles(m.get_rows_number(), m.get_cols_number(), tile_rows, tile_rows,
+                              [&](std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+        for(std::size_t i = row_begin; i < row_end; ++i) {
+            for(std::size_t j = col_begin; j < col_end; ++j) {
+                ret[j][i] = m[i][j];
+            }
+        }
+    });
 
     return ret;
 }
 
 template<typename T>
 std::pair<matrix_t<T>, matrix_t<T>> solve_linear_system(const matrix_t<T>& left, const matrix_t<T>& right) {
-    matrix_t<T> tmp(left);
-    tmp.insert_col(left.get_cols_number(), right);
+    return solve_linear_system(left.view(), right.view());
+}
+
+template<typename T>
+std::pair<matrix_t<T>, matrix_t<T>> solve_linear_system(const_matrix_view_t<T> left, const_matrix_view_t<T> right) {
+    /* square system with nonzero pivots has the only solution */
+    if constexpr (std::is_floating_point_v<T>) {
+        if(left.get_rows_number() && (left.get_rows_number() == left.get_cols_number())) {
+            lu_decomposition_t<T> lu(left);
+            if(!lu.degenerate()) {
+                return {lu.solve(right), matrix_t<T>()};
+            }
+        }
+    }
+
+    /* augmented matrix [left | right] is filled in place */
+    std::size_t rows = left.get_rows_number(), cols = left.get_cols_number();
+    matrix_t<T> tmp(rows, cols + 1);
+    copy_view(left, tmp.submatrix(0u, 0u, rows, cols));
+    copy_view(right, tmp.submatrix(0u, cols, rows, 1u));
 
     gauss_straight(tmp);
     gauss_reverse(tmp);
@@ -419,6 +577,10 @@ std::pair<matrix_t<T>, matrix_t<T>> solve_linear_system(const matrix_t<T>& left,
     std::size_t max_m = tmp.get_rows_number();
     std::size_t max_n = tmp.get_cols_number();
 
+    /* pivot columns are moved to the beginning, order[i] - unknown of column i */
+    std::vector<std::size_t> order(max_n - 1);
+    std::iota(order.begin(), order.end(), 0u);
+
     std::size_t rank = 0u;
     while((current_m < max_m) && (current_n < max_n - 1)) {
         if(matrix::equal(tmp[current_m][current_n], 0.0)) {
@@ -437,47 +599,75 @@ std::pair<matrix_t<T>, matrix_t<T>> solve_linear_system(const matrix_t<T>& left,
         }
 
         tmp.swap_cols(rank, current_n);
+        std::swap(order[rank], order[current_n]);
         ++rank;
         ++current_n; ++current_m;
     }
 
+    /* free unknowns are zero, system can have less equations than unknowns */
     matrix_t<T> partial_solution(tmp.get_cols_number() - 1, 1);
-    for(std::size_t i = 0, maxi = partial_solution.get_rows_number(); i < maxi; ++i) {
-        partial_solution[i][0] = tmp[i][tmp.get_cols_number() - 1]; 
+    for(std::size_t i = 0; i < rank; ++i) {
+        partial_solution[order[i]][0] = tmp[i][tmp.get_cols_number() - 1];
     }
 
     if((tmp.get_cols_number() == 1) || (tmp.get_cols_number() == (rank + 1))) {
-        return {partial_solution, matrix_t<T>()};
+        return {std::move(partial_solution), matrix_t<T>()};
     }
 
     matrix_t<T> fundamental_matrix(tmp.get_cols_number() - 1, tmp.get_cols_number() - rank - 1);
     for(std::size_t i = 0, maxi = rank; i < maxi; ++i) {
         for(std::size_t j = 0, maxj = fundamental_matrix.get_cols_number(); j < maxj; ++j) {
-            fundamental_matrix[i][j] = -tmp[i][rank + j];
+            fundamental_matrix[order[i]][j] = -tmp[i][rank + j];
         }
     }
 
-    current_m = rank;
-    current_n = 0;
+    for(std::size_t j = 0, maxj = fundamental_matrix.get_cols_number(); j < maxj; ++j) {
+        fundamental_matrix[order[rank + j]][j] = 1.0;
+    }
 
-    max_m = fundamental_matrix.get_rows_number();
-    max_n = fundamental_matrix.get_cols_number();
-    while((current_m < max_m) && (current_n < max_n)) {
-        fundamental_matrix[current_m][current_n] = 1.0;
-        ++current_m; ++current_n;
+    return {std::move(partial_solution), std::move(fundamental_matrix)};
+}
+
+namespace detail {
+
+template<typename Row>
+void eliminate_row(Row row, Row pivot_row, long double f, std::size_t begin, std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j) {
+        row[j] = row[j] - f * pivot_row[j];
+
+        /* for accuracy of calculations */
+        if(equal(row[j], 0.0)) {
+            row[j] = 0.0;
+        }
     }
+}
 
-    return {partial_solution, fundamental_matrix};
+/* m[i][begin, end) -= f * m[pivot][begin, end), rows of usual views are passed as pointers */
+template<typename T>
+void eliminate_row(matrix_view_t<T> m, std::size_t i, std::size_t pivot, long double f, std::size_t begin, std::size_t end) {
+    if(m.has_unit_col_stride()) {
+        eliminate_row(&m(i, 0u), &m(pivot, 0u), f, begin, end);
+    } else {
+        eliminate_row(m[i], m[pivot], f, begin, end);
+    }
 }
 
+} /* namespace detail */
+
 template<typename T>
-void gauss_straight(matrix_t<T>& m) {
+void gauss_straight(matrix_t<T>& m, const execution_policy_t& policy /* = sequential_policy */) {
+    gauss_straight(m.view(), policy);
+}
+
+template<typename T>
+void gauss_straight(matrix_view_t<T> m, const execution_policy_t& policy /* = sequential_policy */) {
     std::size_t current_m = 0;
     std::size_t current_n = 0;
 
     std::size_t max_m = m.get_rows_number();
     std::size_t max_n = m.get_cols_number();
 
+    std::vector<long double> factors(max_m);
     while((current_m < max_m) && (current_n < max_n)) {
         std::size_t max_elem = m.max_abs_col_elem(current_n, current_m, max_m);
         if(equal(m[max_elem][current_n], 0.0)) {
@@ -490,17 +680,17 @@ void gauss_straight(matrix_t<T>& m) {
         }
 
         for(std::size_t i = current_m + 1; i < max_m; ++i) {
-            long double f = m[i][current_n] / m[current_m][current_n];
+            factors[i] = m[i][current_n] / m[current_m][current_n];
             m[i][current_n] = 0.0;
-            for (std::size_t j = current_n + 1; j < max_n; ++j) {
-                m[i][j] = m[i][j] - f * m[current_m][j];
+        }
 
-                /* for accuracy of calculations */
-                if(equal(m[i][j], 0.0)) {
-                    m[i][j] = 0.0;
-                }
+        std::size_t first_row = current_m + 1, first_col = current_n + 1;
+        policy.parallel_for_tiles(max_m - first_row, max_n - first_col, tile_rows, tile_cols,
+                                  [&](std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+            for(std::size_t i = first_row + row_begin, maxi = first_row + row_end; i < maxi; ++i) {
+                detail::eliminate_row(m, i, current_m, factors[i], first_col + col_begin, first_col + col_end);
             }
-        }
+        });
 
         ++current_m;
         ++current_n;
@@ -508,35 +698,45 @@ void gauss_straight(matrix_t<T>& m) {
 }
 
 template<typename T>
-void gauss_reverse(matrix_t<T>& m) {
+void gauss_reverse(matrix_t<T>& m, const execution_policy_t& policy /* = sequential_policy */) {
+    gauss_reverse(m.view(), policy);
+}
+
+template<typename T>
+void gauss_reverse(matrix_view_t<T> m, const execution_policy_t& policy /* = sequential_policy */) {
     std::size_t current_m = 0;
     std::size_t current_n = 0;
 
     std::size_t max_m = m.get_rows_number();
     std::size_t max_n = m.get_cols_number();
 
+    std::vector<long double> factors(max_m);
+    std::vector<char> skip(max_m);
     while((current_m < max_m) && (current_n < max_n)) {
-        if(equal(m[current_m][current_m], 0.0)) {
+        if(equal(m[current_m][current_n], 0.0)) {
             ++current_n;
             continue;
         }
 
         for(std::size_t i = 0; i < current_m; ++i) {
-            if(equal(m[i][current_n], 0.0)) {
-                continue;
-            }
-
-            long double f = m[i][current_n] / m[current_m][current_n];
-            for (std::size_t j = current_n + 1; j < max_n; ++j) {
-                m[i][j] = m[i][j] - f * m[current_m][j];
+            skip[i] = equal(m[i][current_n], 0.0);
+            factors[i] = skip[i] ? 0.0 : m[i][current_n] / m[current_m][current_n];
+        }
 
-                /* for accuracy of calculations */
-                if(equal(m[i][j], 0.0)) {
-                    m[i][j] = 0.0;
+        std::size_t first_col = current_n + 1;
+        policy.parallel_for_tiles(current_m, max_n - first_col, tile_rows, tile_cols,
+                                  [&](std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+            for(std::size_t i = row_begin; i < row_end; ++i) {
+                if(!skip[i]) {
+                    detail::eliminate_row(m, i, current_m, factors[i], first_col + col_begin, first_col + col_end);
                 }
             }
+        });
 
-            m[i][current_n] = 0.0;
+        for(std::size_t i = 0; i < current_m; ++i) {
+            if(!skip[i]) {
+                m[i][current_n] = 0.0;
+            }
         }
 
         ++current_m;
@@ -544,4 +744,216 @@ void gauss_reverse(matrix_t<T>& m) {
     }
 }
 
+template<typename T>
+lu_decomposition_t<T>::lu_decomposition_t(const matrix_t<T>& m, const execution_policy_t& policy /* = sequential_policy */) :
+        lu_decomposition_t(m.view(), policy) {}
+
+template<typename T>
+lu_decomposition_t<T>::lu_decomposition_t(const_matrix_view_t<T> m, const execution_policy_t& policy /* = sequential_policy */) :
+        lu_(m), permutation_(m.get_rows_number()), policy_(policy) {
+    if(m.get_rows_number() != m.get_cols_number()) {
+        throw std::runtime_error("lu_decomposition_t: matrix is not square");
+    }
+
+    std::iota(permutation_.begin(), permutation_.end(), 0u);
+
+    std::size_t n = size();
+    for(std::size_t k0 = 0; k0 < n; k0 += block_size) {
+        std::size_t kb = std::min(block_size, n - k0);
+        factorize_panel(k0, kb);
+
+        if(k0 + kb < n) {
+            solve_block_row(k0, kb);
+            update_trailing(k0, kb);
+        }
+    }
+}
+
+/* unblocked elimination in columns [k0, k0 + kb), row swaps are applied to the whole rows */
+template<typename T>
+void lu_decomposition_t<T>::factorize_panel(std::size_t k0, std::size_t kb) {
+    std::size_t n = size();
+    for(std::size_t j = k0, maxj = k0 + kb; j < maxj; ++j) {
+        std::size_t pivot_row = lu_.max_abs_col_elem(j, j, n);
+        if(lu_[pivot_row][j] == T{}) {
+            singular_ = true;
+            continue;
+        }
+
+        if(pivot_row != j) {
+            lu_.swap_rows(pivot_row, j);
+            std::swap(permutation_[pivot_row], permutation_[j]);
+            odd_permutation_ = !odd_permutation_;
+        }
+
+        const T* row_j = &lu_[j][0];
+        T pivot = row_j[j];
+        for(std::size_t i = j + 1; i < n; ++i) {
+            T* row_i = &lu_[i][0];
+            T f = (row_i[j] /= pivot);
+            for(std::size_t c = j + 1; c < maxj; ++c) {
+                row_i[c] -= f * row_j[c];
+            }
+        }
+    }
+}
+
+/* U12 = L11^(-1) * A12, columns of A12 are split between threads */
+template<typename T>
+void lu_decomposition_t<T>::solve_block_row(std::size_t k0, std::size_t kb) {
+    std::size_t first_col = k0 + kb;
+    policy_.parallel_for_tiles(1u, size() - first_col, 1u, tile_cols,
+                               [&](std::size_t, std::size_t, std::size_t col_begin, std::size_t col_end) {
+        for(std::size_t i = k0 + 1; i < k0 + kb; ++i) {
+            T* row_i = &lu_[i][0];
+            for(std::size_t p = k0; p < i; ++p) {
+                const T* row_p = &lu_[p][0];
+                T f = row_i[p];
+                for(std::size_t c = first_col + col_begin, maxc = first_col + col_end; c < maxc; ++c) {
+                    row_i[c] -= f * row_p[c];
+                }
+            }
+        }
+    });
+}
+
+/* A22 -= L21 * U12 */
+template<typename T>
+void lu_decomposition_t<T>::update_trailing(std::size_t k0, std::size_t kb) {
+    std::size_t n = size(), first = k0 + kb;
+    matrix_view_t<T> lu = lu_.view();
+    subtract_product(lu.submatrix(first, k0, n - first, kb), lu.submatrix(k0, first, kb, n - first),
+                     lu.submatrix(first, first, n - first, n - first));
+}
+
+template<typename T>
+void lu_decomposition_t<T>::subtract_product(const_matrix_view_t<T> a, const_matrix_view_t<T> b, matrix_view_t<T> c) const {
+    std::size_t m = a.get_rows_number(), k = a.get_cols_number();
+    if(!m || !k || !c.get_cols_number()) {
+        return;
+    }
+
+    /* gemm only adds, so negated copy of a is multiplied */
+    std::vector<T> negated(m * k);
+    for(std::size_t i = 0; i < m; ++i) {
+        auto row = a[i];
+        for(std::size_t p = 0; p < k; ++p) {
+            negated[i * k + p] = -row[p];
+        }
+    }
+
+    gemm(const_matrix_view_t<T>(negated.data(), m, k, k), b, c, policy_);
+}
+
+template<typename T>
+bool lu_decomposition_t<T>::degenerate() const {
+    for(std::size_t i = 0, maxi = size(); i < maxi; ++i) {
+        if(equal(lu_[i][i], 0.0)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template<typename T>
+T lu_decomposition_t<T>::det() const {
+    if(singular_) {
+        return T{};
+    }
+
+    T ret = odd_permutation_ ? -1 : 1;
+    for(std::size_t i = 0, maxi = size(); i < maxi; ++i) {
+        ret *= lu_[i][i];
+    }
+
+    return ret;
+}
+
+template<typename T>
+matrix_t<T> lu_decomposition_t<T>::solve(const_matrix_view_t<T> rhs) const {
+    if(singular_) {
+        throw std::runtime_error("lu_decomposition_t::solve: matrix is singular");
+    }
+
+    if(rhs.get_rows_number() != size()) {
+        throw std::runtime_error("lu_decomposition_t::solve: invalid right side sizes");
+    }
+
+    std::size_t n = size(), k = rhs.get_cols_number();
+    matrix_t<T> x(n, k);
+    if(!n || !k) {
+        return x;
+    }
+
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t j = 0; j < k; ++j) {
+            x[i][j] = rhs[permutation_[i]][j];
+        }
+    }
+
+    const_matrix_view_t<T> lu = lu_.view();
+    matrix_view_t<T> xv = x.view();
+
+    /* L * Y = P * rhs: rows of block are updated by previous blocks with gemm, then substituted */
+    for(std::size_t i0 = 0; i0 < n; i0 += block_size) {
+        std::size_t i1 = std::min(i0 + block_size, n);
+        subtract_product(lu.submatrix(i0, 0u, i1 - i0, i0), xv.submatrix(0u, 0u, i0, k), xv.submatrix(i0, 0u, i1 - i0, k));
+
+        for(std::size_t i = i0 + 1; i < i1; ++i) {
+            T* x_i = &x[i][0];
+            for(std::size_t p = i0; p < i; ++p) {
+                const T* x_p = &x[p][0];
+                T f = lu_[i][p];
+                for(std::size_t j = 0; j < k; ++j) {
+                    x_i[j] -= f * x_p[j];
+                }
+            }
+        }
+    }
+
+    /* U * X = Y: the same from the last block */
+    for(std::size_t i1 = n; i1 > 0;) {
+        std::size_t i0 = (i1 > block_size) ? i1 - block_size : 0u;
+        if(i1 < n) {
+            subtract_product(lu.submatrix(i0, i1, i1 - i0, n - i1), xv.submatrix(i1, 0u, n - i1, k), xv.submatrix(i0, 0u, i1 - i0, k));
+        }
+
+        for(std::size_t i = i1; i-- > i0;) {
+            T* x_i = &x[i][0];
+            for(std::size_t p = i + 1; p < i1; ++p) {
+                const T* x_p = &x[p][0];
+                T f = lu_[i][p];
+                for(std::size_t j = 0; j < k; ++j) {
+                    x_i[j] -= f * x_p[j];
+                }
+            }
+
+            T pivot = lu_[i][i];
+            for(std::size_t j = 0; j < k; ++j) {
+                x_i[j] /= pivot;
+            }
+        }
+
+        i1 = i0;
+    }
+
+    return x;
+}
+
+template<typename T>
+matrix_t<T> lu_decomposition_t<T>::inverse() const {
+    matrix_t<T> identity(size(), size());
+    for(std::size_t i = 0, maxi = size(); i < maxi; ++i) {
+        identity[i][i] = T{1};
+    }
+
+    return solve(identity);
+}
+
+template<typename T>
+matrix_t<T> inverse(const matrix_t<T>& m, const execution_policy_t& policy /* = sequential_policy */) {
+    return lu_decomposition_t<T>(m, policy).inverse();
+}
+
 } /* namespace matrix */
\ No newline at end of file
@@ -1,25 +1,21 @@
 #include "matrix_chain.hpp"
 
-namespace matrix {
+#include <limits>
+#include <numeric>
+#include <unordered_map>
 
-Imatrix_chain_t::Imatrix_chain_t() {
-    dp_table_.resize(dp_table_capacity_, dp_table_capacity_);
-}
+namespace matrix {
 
 void Imatrix_chain_t::push(std::size_t rows, std::size_t cols) {
     if(!cols || !rows) {
         throw std::runtime_error("matrix_chain_t::push: invalid matrix sizes");
     }
 
-    if(dp_table_size_ == dp_table_capacity_) {
-        dp_table_capacity_ *= 2;
-        dp_table_.resize(dp_table_capacity_, dp_table_capacity_);
-    }
-
-    if(!dp_table_size_) {
+    if(sizes_.empty()) {
         sizes_.push_back(rows);
         sizes_.push_back(cols);
-        ++dp_table_size_;
+        cost_.push_back({0u});
+        split_.push_back({0u});
         return;
     } 
     
@@ -29,47 +25,113 @@ void Imatrix_chain_t::push(std::size_t rows, std::size_t cols) {
 
     sizes_.push_back(cols);
 
-    std::size_t j = dp_table_size_;
-    for(int i = dp_table_size_ - 1; i >= 0; --i) {
-        std::vector<std::size_t> variants;
-        std::size_t variants_size = j - i;
-        variants.reserve(variants_size);
+    std::size_t j = cost_.size();
+    cost_.push_back({0u});
+    split_.push_back({j});
+    column_.resize(j + 1);
+    column_[j] = 0u;
 
+    /* column_[k] - cost of product k..j, cost_[i] - costs of products i..k */
+    for(std::size_t i = j; i-- > 0;) {
+        const std::vector<std::size_t>& row = cost_[i];
+        std::size_t best = std::numeric_limits<std::size_t>::max(), best_k = i;
         for(std::size_t k = i; k < j; ++k) {
-            std::size_t candidate = dp_table_[i][k] + dp_table_[k+1][j] + sizes_[i] * sizes_[k+1] * sizes_[j+1];
-            variants.push_back(candidate);
+            std::size_t candidate = row[k - i] + column_[k + 1] + sizes_[i] * sizes_[k + 1] * sizes_[j + 1];
+            if(candidate < best) {
+                best = candidate;
+                best_k = k;
+            }
         }
 
-       auto&& it = std::min_element(variants.begin(), variants.end());
-       dp_table_[i][j] = *it;
-       dp_table_[j][i] = i + std::distance(variants.begin(), it);
+        column_[i] = best;
+        cost_[i].push_back(best);
+        split_[i].push_back(best_k);
     }
 
-    optimal_order_.clear();
-    calculate_optimal_order(0, dp_table_size_);
+    optimal_order_ = detail::chain_order(j + 1, [this](std::size_t i, std::size_t j) {return split_[i][j - i];});
+}
 
-    ++dp_table_size_;
+std::size_t Imatrix_chain_t::get_optimal_order_oper() const {
+    return cost_.empty() ? 0u : cost_.front().back();
 }
 
-void Imatrix_chain_t::calculate_optimal_order(std::size_t i, std::size_t j) {
-    if(i >= j) {
-        return;
+/*  vertex y between x and z is cut off (its two matrices are multiplied first), if it's cheaper than
+    fan of triangles from the smallest vertex w: 1/w + 1/y < 1/x + 1/z. One sweep with stack cuts such
+    vertices, the rest of polygon is fan from w */
+std::vector<std::size_t> Imatrix_chain_t::get_heuristic_order() const {
+    std::size_t count = size();
+    if(count < 2u) {
+        return {};
     }
 
-    if((i + 1) == j) {
-        optimal_order_.push_back(i);
-        return;
+    std::size_t n = sizes_.size();
+    std::size_t m = std::distance(sizes_.begin(), std::min_element(sizes_.begin(), sizes_.end()));
+    long double w = sizes_[m];
+
+    /* apex[a * n + c] - third vertex of triangle on side (a, c), a < c */
+    std::unordered_map<std::size_t, std::size_t> apex;
+    apex.reserve(2 * count);
+    auto add_triangle = [&](std::size_t a, std::size_t b, std::size_t c) {
+        std::size_t low = std::min({a, b, c}), high = std::max({a, b, c});
+        apex[low * n + high] = a + b + c - low - high;
+    };
+
+    auto cut = [&](std::size_t x, std::size_t y, std::size_t z) {
+        long double wx = sizes_[x], wy = sizes_[y], wz = sizes_[z];
+        return wx * wy * wz + w * wx * wz < w * wx * wy + w * wy * wz;
+    };
+
+    std::vector<std::size_t> stack{m};
+    for(std::size_t t = 1; t <= n; ++t) {
+        std::size_t z = (m + t) % n;
+        while((stack.size() >= 2u) && (stack.size() + n - t >= 3u) && cut(stack[stack.size() - 2], stack.back(), z)) {
+            add_triangle(stack[stack.size() - 2], stack.back(), z);
+            stack.pop_back();
+        }
+
+        if(t < n) {
+            stack.push_back(z);
+        }
     }
 
-    std::size_t pivot = dp_table_[j][i];
-    calculate_optimal_order(pivot + 1, j);    
-    calculate_optimal_order(i, pivot);
+    for(std::size_t t = 1; t + 1 < stack.size(); ++t) {
+        add_triangle(m, stack[t], stack[t + 1]);
+    }
 
-    optimal_order_.push_back(pivot);
+    /* product i..j is side (i, j + 1) */
+    return detail::chain_order(count, [&](std::size_t i, std::size_t j) {return apex.at(i * n + j + 1) - 1;});
+}
+
+std::size_t Imatrix_chain_t::get_order_oper(const std::vector<std::size_t>& order) const {
+    std::size_t count = size();
+
+    /* begin[e] - first matrix of product ending with e, end[b] - last matrix of product starting with b */
+    std::vector<std::size_t> begin(count), end(count);
+    std::iota(begin.begin(), begin.end(), 0u);
+    std::iota(end.begin(), end.end(), 0u);
+
+    std::size_t ret = 0u;
+    for(std::size_t k : order) {
+        if((k + 1 >= count) || (end[begin[k]] != k) || (begin[end[k + 1]] != k + 1)) {
+            throw std::runtime_error("matrix_chain_t::get_order_oper: invalid order");
+        }
+
+        std::size_t b = begin[k], e = end[k + 1];
+        ret += sizes_[b] * sizes_[k + 1] * sizes_[e + 1];
+        end[b] = e;
+        begin[e] = b;
+    }
+
+    return ret;
 }
 
 void Imatrix_chain_t::dump(std::ostream& stream) const {
-    stream << dp_table_;
+    for(std::size_t i = 0, maxi = cost_.size(); i < maxi; ++i) {
+        for(std::size_t j = i; j < maxi; ++j) {
+            stream << cost_[i][j - i] << "(" << split_[i][j - i] << ") ";
+        }
+        stream << std::endl;
+    }
 }
 
-} /* namespace matrix */
\ No newline at end of file
+} /* namespace matrix */
@@ -1,36 +1,430 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
 #include "matrix.hpp"
+#include "execution.hpp"
 
 namespace matrix {
 
+/*  order of multiplications is list of splits: k means product ending with matrix k is multiplied by
+    product starting with matrix k + 1. Products of right part go first, then left part, then split itself */
 class Imatrix_chain_t {
 public:
 
-    Imatrix_chain_t();
+    Imatrix_chain_t() = default;
 
+    /* new column of dp table, O(n^2) */
     void push(std::size_t rows, std::size_t cols);
 
     void dump(std::ostream& stream) const;
 
     std::vector<std::size_t> get_optimal_order() const {return optimal_order_; }
-    std::size_t get_optimal_order_oper() const { return dp_table_[dp_table_size_ - 1][dp_table_size_ - 1];}
+    std::size_t get_optimal_order_oper() const;
+
+    /*  near optimal order in O(n) (Chin's sweep, analysed by Hu and Shing), its cost is at most 25% above optimum.
+        Chain is polygon with vertices sizes_, matrices are its sides, order is triangulation */
+    std::vector<std::size_t> get_heuristic_order() const;
+
+    /* scalar multiplications of any order */
+    std::size_t get_order_oper(const std::vector<std::size_t>& order) const;
+
+    const std::vector<std::size_t>& get_sizes() const {return sizes_;}
+    std::size_t size() const {return cost_.size();}
 
 private:
-    void calculate_optimal_order(std::size_t i, std::size_t j);
-private:
-    /* table dp_table_size_ * dp_table_size_ , which contain information about optimal order */
-    matrix_t<std::size_t> dp_table_;
-    std::size_t dp_table_size_ = 0; 
-    std::size_t dp_table_capacity_ = 8; /* for amortization */
+    /*  upper triangle of dp table by rows: cost_[i][j - i] - operations of product i..j,
+        split_[i][j - i] - its last multiplication. Row is contiguous in k, column of new matrix is
+        built in column_, so push doesn't copy table */
+    std::vector<std::vector<std::size_t>> cost_;
+    std::vector<std::vector<std::size_t>> split_;
+    std::vector<std::size_t> column_;
 
     std::vector<std::size_t> sizes_;
     std::vector<std::size_t> optimal_order_;
 };
 
+template<typename T>
+struct chain_order_t {
+    T cost;
+    std::vector<std::size_t> order;
+};
+
+/*
+    ***cost models of matrix chain***
+
+    model gives value of product A_i .. A_j split at k from values of its factors:
+
+        value_type leaf(i) const                            - value of single matrix
+        value_type combine(left, right, i, k, j) const      - left of A_i .. A_k, right of A_k+1 .. A_j
+
+    combine must be monotone in left and right, then dp finds optimal order.
+    Callable cost(i, k, j) is additive model: left + right + cost(i, k, j)
+*/
+
+/* floating point operations, 2 * m * n * k for every product */
+class flops_model_t final {
+public:
+    using value_type = std::size_t;
+
+    explicit flops_model_t(std::vector<std::size_t> sizes) : sizes_(std::move(sizes)) {}
+
+    value_type leaf(std::size_t) const {return 0u;}
+    value_type combine(value_type left, value_type right, std::size_t i, std::size_t k, std::size_t j) const {
+        return left + right + 2u * sizes_[i] * sizes_[k + 1] * sizes_[j + 1];
+    }
+
+private:
+    std::vector<std::size_t> sizes_;
+};
+
+/*  peak bytes of temporary products: both factors of product are kept until it's done, they are computed
+    one after another (as chain_evaluator_t does with sequential policy). Operands and result aren't counted */
+class memory_model_t final {
+public:
+    using value_type = std::size_t;
+
+    memory_model_t(std::vector<std::size_t> sizes, std::size_t element_size) : sizes_(std::move(sizes)), element_size_(element_size) {}
+
+    std::size_t bytes(std::size_t i, std::size_t j) const {return (i == j) ? 0u : sizes_[i] * sizes_[j + 1] * element_size_;}
+
+    value_type leaf(std::size_t) const {return 0u;}
+    value_type combine(value_type left, value_type right, std::size_t i, std::size_t k, std::size_t j) const {
+        return bytes(i, k) + bytes(k + 1, j) + std::max(left, right);
+    }
+
+private:
+    std::vector<std::size_t> sizes_;
+    std::size_t element_size_;
+};
+
+/* seconds of gemm: overhead + per_flop * 2mnk + per_byte * (mk + kn + mn) * element_size */
+struct gemm_timing_t {
+    double overhead = 0.0;
+    double per_flop = 0.0;
+    double per_byte = 0.0;
+    std::size_t element_size = sizeof(double);
+
+    double time(std::size_t m, std::size_t n, std::size_t k) const {
+        return overhead + per_flop * 2.0 * m * n * k + per_byte * static_cast<double>(m * k + k * n + m * n) * element_size;
+    }
+};
+
+/*  gemm is timed on square and skinny shapes, coefficients are fitted by least squares of relative error
+    (negative ones are dropped). Takes about a second */
+template<typename T>
+gemm_timing_t calibrate_gemm(const execution_policy_t& policy = sequential_policy);
+
+/* predicted seconds of gemm calls */
+class time_model_t final {
+public:
+    using value_type = double;
+
+    time_model_t(std::vector<std::size_t> sizes, const gemm_timing_t& timing) : sizes_(std::move(sizes)), timing_(timing) {}
+
+    value_type leaf(std::size_t) const {return 0.0;}
+    value_type combine(value_type left, value_type right, std::size_t i, std::size_t k, std::size_t j) const {
+        return left + right + timing_.time(sizes_[i], sizes_[j + 1], sizes_[k + 1]);
+    }
+
+private:
+    std::vector<std::size_t> sizes_;
+    gemm_timing_t timing_;
+};
+
+namespace detail {
+
+template<typename Cost>
+struct additive_model_t {
+    using value_type = std::invoke_result_t<Cost, std::size_t, std::size_t, std::size_t>;
+
+    Cost cost;
+
+    value_type leaf(std::size_t) const {return value_type{};}
+    value_type combine(value_type left, value_type right, std::size_t i, std::size_t k, std::size_t j) const {
+        return left + right + cost(i, k, j);
+    }
+};
+
+template<typename Model>
+auto chain_model(Model model) {
+    if constexpr(std::is_invocable_v<Model, std::size_t, std::size_t, std::size_t>) {
+        return additive_model_t<Model>{std::move(model)};
+    } else {
+        return model;
+    }
+}
+
+template<typename Model>
+using chain_value_t = typename decltype(chain_model(std::declval<Model>()))::value_type;
+
+template<typename Split>
+std::vector<std::size_t> chain_order(std::size_t count, Split split);
+
+} /* namespace detail */
+
+/*  optimal order of count matrices for model (or additive cost(i, k, j)).
+    Cells of one diagonal of dp table are independent, so diagonals are computed one by one in parallel.
+    Table is n * n with mirrored lower triangle: both value[i][k] and value[k + 1][j] are read along rows */
+template<typename Model>
+chain_order_t<detail::chain_value_t<Model>> optimal_chain_order(std::size_t count, Model model, const execution_policy_t& policy = sequential_policy);
+
+/*  the same with memory cap: splits, whose peak of memory model is above budget, are rejected and the best
+    of the rest is taken for every product. It's greedy, if it fails, order of the smallest peak is returned,
+    when it fits. nullopt means that no order fits budget */
+template<typename Model>
+std::optional<chain_order_t<detail::chain_value_t<Model>>> optimal_chain_order(std::size_t count, Model model, const memory_model_t& memory,
+                                                                               std::size_t budget, const execution_policy_t& policy = sequential_policy);
+
+/* value of model for given order */
+template<typename Model>
+detail::chain_value_t<Model> chain_order_value(std::size_t count, Model model, const std::vector<std::size_t>& order);
+
 /*------------------------------------------------------------
                     REALIZATION
 -------------------------------------------------------------*/
 
+namespace detail {
+
+/* reversed preorder (split, left, right) is order (right, left, split) */
+template<typename Split>
+std::vector<std::size_t> chain_order(std::size_t count, Split split) {
+    std::vector<std::size_t> ret;
+    if(count < 2u) {
+        return ret;
+    }
+
+    ret.reserve(count - 1);
+    std::vector<std::pair<std::size_t, std::size_t>> stack{{0u, count - 1}};
+    while(!stack.empty()) {
+        auto [i, j] = stack.back();
+        stack.pop_back();
+        if(i >= j) {
+            continue;
+        }
+
+        std::size_t k = split(i, j);
+        ret.push_back(k);
+        stack.push_back({k + 1, j});
+        stack.push_back({i, k});
+    }
+
+    std::reverse(ret.begin(), ret.end());
+    return ret;
+}
+
+/* cells of diagonal in one task */
+const std::size_t chain_grain = 16u;
+
+/* peaks of memory model are checked, if memory isn't null */
+template<typename Model>
+std::optional<chain_order_t<typename Model::value_type>> chain_dp(std::size_t count, const Model& model, const execution_policy_t& policy,
+                                                                  const memory_model_t* memory, std::size_t budget) {
+    using T = typename Model::value_type;
+    const std::size_t rejected = std::numeric_limits<std::size_t>::max();
+    if(count == 0u) {
+        return chain_order_t<T>{T{}, {}};
+    }
+
+    std::vector<T> table(count * count, T{});
+    std::vector<std::size_t> split(count * count, 0u);
+    std::vector<std::size_t> peak(memory ? count * count : 0u, 0u);
+    for(std::size_t i = 0; i < count; ++i) {
+        table[i * count + i] = model.leaf(i);
+    }
+
+    for(std::size_t length = 1; length < count; ++length) {
+        std::size_t cells = count - length;
+        std::size_t tasks = (cells + chain_grain - 1) / chain_grain;
+        policy.parallel_for(tasks, [&](std::size_t task) {
+            for(std::size_t i = task * chain_grain, maxi = std::min(i + chain_grain, cells); i < maxi; ++i) {
+                std::size_t j = i + length;
+                const T* row_i = table.data() + i * count;
+                const T* row_j = table.data() + j * count;
+
+                bool found = false;
+                T best{};
+                std::size_t best_k = i, best_peak = rejected;
+                for(std::size_t k = i; k < j; ++k) {
+                    std::size_t candidate_peak = 0u;
+                    if(memory) {
+                        std::size_t left = peak[i * count + k], right = peak[j * count + k + 1];
+                        if((left == rejected) || (right == rejected)) {
+                            continue;
+                        }
+
+                        candidate_peak = memory->combine(left, right, i, k, j);
+                        if(candidate_peak > budget) {
+                            continue;
+                        }
+                    }
+
+                    T candidate = model.combine(row_i[k], row_j[k + 1], i, k, j);
+                    if(!found || (candidate < best)) {
+                        found = true;
+                        best = candidate;
+                        best_k = k;
+                        best_peak = candidate_peak;
+                    }
+                }
+
+                table[i * count + j] = table[j * count + i] = best;
+                split[i * count + j] = best_k;
+                if(memory) {
+                    peak[i * count + j] = peak[j * count + i] = best_peak;
+                }
+            }
+        });
+    }
+
+    if(memory && (peak[count - 1] == rejected)) {
+        return std::nullopt;
+    }
+
+    return chain_order_t<T>{table[count - 1], chain_order(count, [&](std::size_t i, std::size_t j) {return split[i * count + j];})};
+}
+
+} /* namespace detail */
+
+template<typename Model>
+chain_order_t<detail::chain_value_t<Model>> optimal_chain_order(std::size_t count, Model model, const execution_policy_t& policy /* = sequential_policy */) {
+    return *detail::chain_dp(count, detail::chain_model(std::move(model)), policy, nullptr, 0u);
+}
+
+template<typename Model>
+std::optional<chain_order_t<detail::chain_value_t<Model>>> optimal_chain_order(std::size_t count, Model model, const memory_model_t& memory,
+                                                                               std::size_t budget, const execution_policy_t& policy /* = sequential_policy */) {
+    auto chain_model = detail::chain_model(std::move(model));
+    auto ret = detail::chain_dp(count, chain_model, policy, &memory, budget);
+    if(!ret) {
+        auto smallest = detail::chain_dp(count, memory, policy, nullptr, 0u);
+        if(smallest->cost <= budget) {
+            ret = chain_order_t<detail::chain_value_t<Model>>{chain_order_value(count, chain_model, smallest->order), std::move(smallest->order)};
+        }
+    }
+
+    return ret;
+}
+
+template<typename Model>
+detail::chain_value_t<Model> chain_order_value(std::size_t count, Model model, const std::vector<std::size_t>& order) {
+    auto chain_model = detail::chain_model(std::move(model));
+
+    /* begin[e] - first matrix of product ending with e, end[b] - last matrix of product starting with b, value[b] - its value */
+    std::vector<std::size_t> begin(count), end(count);
+    std::vector<detail::chain_value_t<Model>> value(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        begin[i] = end[i] = i;
+        value[i] = chain_model.leaf(i);
+    }
+
+    for(std::size_t k : order) {
+        if((k + 1 >= count) || (end[begin[k]] != k) || (begin[end[k + 1]] != k + 1)) {
+            throw std::runtime_error("chain_order_value: invalid order");
+        }
+
+        std::size_t b = begin[k], e = end[k + 1];
+        value[b] = chain_model.combine(value[b], value[k + 1], b, k, e);
+        end[b] = e;
+        begin[e] = b;
+    }
+
+    return count ? value.front() : detail::chain_value_t<Model>{};
+}
+
+template<typename T>
+gemm_timing_t calibrate_gemm(const execution_policy_t& policy /* = sequential_policy */) {
+    /* m, n, k: flops bound, small (overhead bound) and skinny (memory bound) */
+    const std::size_t shapes[][3] = {{8, 8, 8}, {32, 32, 32}, {128, 128, 128}, {384, 384, 384}, {768, 768, 768},
+                                     {2048, 2048, 4}, {4, 2048, 2048}, {2048, 4, 2048}, {1024, 1024, 32}};
+    const double min_seconds = 0.05;
+
+    gemm_timing_t ret;
+    ret.element_size = sizeof(T);
+    std::vector<std::array<double, 3>> features;
+    std::vector<double> times;
+    for(auto&& shape : shapes) {
+        std::size_t m = shape[0], n = shape[1], k = shape[2];
+        std::vector<T> a(m * k, T{1}), b(k * n, T{1}), c(m * n, T{});
+
+        std::size_t repeats = 0u;
+        auto start = std::chrono::high_resolution_clock::now();
+        double seconds = 0.0;
+        for(; seconds < min_seconds; seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count()) {
+            gemm(m, n, k, a.data(), k, b.data(), n, c.data(), n, policy);
+            ++repeats;
+        }
+
+        features.push_back({1.0, 2.0 * m * n * k, static_cast<double>(m * k + k * n + m * n) * sizeof(T)});
+        times.push_back(seconds / repeats);
+    }
+
+    /* normal equations of scaled columns, coefficient is dropped while some of them is negative */
+    std::array<bool, 3> active{true, true, true};
+    std::array<double, 3> coefficients{};
+    for(std::size_t attempt = 0; attempt < 3; ++attempt) {
+        std::array<double, 3> scale{};
+        for(std::size_t s = 0; s < times.size(); ++s) {
+            for(std::size_t p = 0; p < 3; ++p) {
+                scale[p] = std::max(scale[p], features[s][p] / times[s]);
+            }
+        }
+
+        matrix_t<double> normal(3, 3), right(3, 1);
+        for(std::size_t p = 0; p < 3; ++p) {
+            normal[p][p] = active[p] ? 0.0 : 1.0;
+        }
+
+        for(std::size_t s = 0; s < times.size(); ++s) {
+            for(std::size_t p = 0; p < 3; ++p) {
+                if(!active[p]) {
+                    continue;
+                }
+
+                double fp = features[s][p] / times[s] / scale[p];
+                right[p][0] += fp;
+                for(std::size_t q = 0; q < 3; ++q) {
+                    if(active[q]) {
+                        normal[p][q] += fp * features[s][q] / times[s] / scale[q];
+                    }
+                }
+            }
+        }
+
+        matrix_t<double> solution = solve_linear_system(normal, right).first;
+        if(solution.get_elements_number() == 0u) {
+            break;
+        }
+
+        std::size_t most_negative = 3u;
+        for(std::size_t p = 0; p < 3; ++p) {
+            coefficients[p] = active[p] ? solution[p][0] / scale[p] : 0.0;
+            if((coefficients[p] < 0.0) && ((most_negative == 3u) || (coefficients[p] < coefficients[most_negative]))) {
+                most_negative = p;
+            }
+        }
+
+        if(most_negative == 3u) {
+            break;
+        }
+
+        active[most_negative] = false;
+        coefficients[most_negative] = 0.0;
+    }
+
+    ret.overhead = std::max(coefficients[0], 0.0);
+    ret.per_flop = std::max(coefficients[1], 0.0);
+    ret.per_byte = std::max(coefficients[2], 0.0);
+    return ret;
+}
 
-} /* namespace matrix */
\ No newline at end of file
+} /* namespace matrix */
@@ -0,0 +1,478 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "matrix.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+/*
+    ***binary matrix file***
+
+    64 bytes header, then elements without padding in row major (or column major) order.
+    Data starts on 64 bytes offset, so mapped elements are aligned as matrix storage.
+    Byte order mark is written in native order, file of other byte order is rejected
+*/
+enum class dtype_t : std::uint32_t {int32 = 1, int64 = 2, float32 = 3, float64 = 4, float80 = 5};
+enum class layout_t : std::uint32_t {row_major = 0, col_major = 1};
+
+struct matrix_header_t {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    dtype_t dtype;
+    layout_t layout;
+    std::uint32_t element_size;
+    std::uint32_t reserved;
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint64_t data_offset;
+};
+
+constexpr char matrix_magic[8] = "MATRIXB";
+constexpr std::uint32_t matrix_file_version = 1u;
+constexpr std::uint32_t matrix_byte_order = 0x01020304u;
+constexpr std::size_t matrix_data_offset = 64u;
+
+static_assert(sizeof(matrix_header_t) <= matrix_data_offset, "matrix_header_t doesn't fit in data offset");
+
+template<typename T>
+constexpr dtype_t dtype_of();
+
+/* writes through own 4 MiB buffer, throws if file can't be written */
+template<typename T>
+void write_binary(const std::string& path, const matrix_t<T>& m, layout_t layout = layout_t::row_major);
+
+/* reads file of any dtype (elements are converted to T) and layout */
+template<typename T>
+matrix_t<T> read_binary(const std::string& path, const execution_policy_t& policy = sequential_policy);
+
+/*
+    ***read only matrix mapped from binary file***
+
+    elements aren't copied, pages are loaded by system on first access,
+    dtype of file must be T. Mapping is released by destructor
+*/
+template<typename T>
+class mapped_matrix_t final {
+public:
+    explicit mapped_matrix_t(const std::string& path);
+    mapped_matrix_t(const mapped_matrix_t&) = delete;
+    mapped_matrix_t& operator=(const mapped_matrix_t&) = delete;
+    mapped_matrix_t(mapped_matrix_t&& rhs) noexcept;
+    mapped_matrix_t& operator=(mapped_matrix_t&& rhs) noexcept;
+    ~mapped_matrix_t();
+
+    std::size_t get_rows_number() const {return rows_;}
+    std::size_t get_cols_number() const {return cols_;}
+    std::size_t get_elements_number() const {return rows_ * cols_;}
+    layout_t get_layout() const {return layout_;}
+
+    const T& at(std::size_t row, std::size_t col) const {return data_[row * row_stride_ + col * col_stride_];}
+
+    /* elements in layout order */
+    const T* data() const {return data_;}
+
+    /* strided for column major file, can be passed to algorithms without copy */
+    const_matrix_view_t<T> view() const {return {data_, rows_, cols_, row_stride_, col_stride_};}
+
+    matrix_t<T> to_matrix(const execution_policy_t& policy = sequential_policy) const;
+
+private:
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0u;
+    const T* data_ = nullptr;
+    std::size_t rows_ = 0u, cols_ = 0u;
+    std::size_t row_stride_ = 0u, col_stride_ = 0u;
+    layout_t layout_ = layout_t::row_major;
+};
+
+/*
+    ***text format***
+
+    elements separated by whitespaces, as operator<< writes them, but without locale and
+    formatted extraction of istream: characters are taken from stream buffer, numbers are
+    parsed by from_chars. Only characters of m elements are taken from stream.
+    On invalid number failbit is set, as operator>> does
+*/
+template<typename T>
+std::istream& read_text(std::istream& in, matrix_t<T>& m);
+
+/* shortest representation, which is read back to the same value */
+template<typename T>
+std::ostream& write_text(std::ostream& out, const matrix_t<T>& m);
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+constexpr dtype_t dtype_of() {
+    if constexpr(std::is_same_v<T, std::int32_t>) {
+        return dtype_t::int32;
+    } else if constexpr(std::is_same_v<T, std::int64_t>) {
+        return dtype_t::int64;
+    } else if constexpr(std::is_same_v<T, float>) {
+        return dtype_t::float32;
+    } else if constexpr(std::is_same_v<T, double>) {
+        return dtype_t::float64;
+    } else {
+        static_assert(std::is_same_v<T, long double>, "dtype_of: type can't be stored in binary matrix file");
+        return dtype_t::float80;
+    }
+}
+
+namespace detail {
+
+const std::size_t io_buffer_size = 4u << 20u;
+
+/* whole file mapped read only */
+class file_mapping_t final {
+public:
+    explicit file_mapping_t(const std::string& path);
+    file_mapping_t(const file_mapping_t&) = delete;
+    file_mapping_t& operator=(const file_mapping_t&) = delete;
+    ~file_mapping_t() {unmap();}
+
+    /* mapping is passed to owner, it must call munmap */
+    std::pair<void*, std::size_t> release();
+
+    const char* data() const {return static_cast<const char*>(data_);}
+    std::size_t size() const {return size_;}
+
+private:
+    void unmap();
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0u;
+};
+
+inline file_mapping_t::file_mapping_t(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::runtime_error("file_mapping_t: can't open " + path);
+    }
+
+    struct stat st;
+    if(::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("file_mapping_t: can't get size of " + path);
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    if(size_) {
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+
+    if(data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("file_mapping_t: can't map " + path);
+    }
+}
+
+inline std::pair<void*, std::size_t> file_mapping_t::release() {
+    std::pair<void*, std::size_t> ret{data_, size_};
+    data_ = nullptr;
+    size_ = 0u;
+    return ret;
+}
+
+inline void file_mapping_t::unmap() {
+    if(data_) {
+        ::munmap(data_, size_);
+    }
+}
+
+inline std::size_t element_size(dtype_t dtype) {
+    switch(dtype) {
+        case dtype_t::int32:   return sizeof(std::int32_t);
+        case dtype_t::int64:   return sizeof(std::int64_t);
+        case dtype_t::float32: return sizeof(float);
+        case dtype_t::float64: return sizeof(double);
+        case dtype_t::float80: return sizeof(long double);
+    }
+
+    throw std::runtime_error("matrix file: unknown dtype");
+}
+
+/* checks header and size of mapped file */
+inline const matrix_header_t& check_header(const file_mapping_t& file) {
+    if(file.size() < matrix_data_offset) {
+        throw std::runtime_error("matrix file: file is too small for header");
+    }
+
+    const matrix_header_t& header = *reinterpret_cast<const matrix_header_t*>(file.data());
+    if(std::memcmp(header.magic, matrix_magic, sizeof(matrix_magic)) || (header.version != matrix_file_version)) {
+        throw std::runtime_error("matrix file: invalid header");
+    }
+
+    if(header.byte_order != matrix_byte_order) {
+        throw std::runtime_error("matrix file: byte order of file differs from native");
+    }
+
+    if((header.element_size != element_size(header.dtype)) ||
+       ((header.layout != layout_t::row_major) && (header.layout != layout_t::col_major))) {
+        throw std::runtime_error("matrix file: invalid header");
+    }
+
+    std::uint64_t elements = header.rows * header.cols;
+    if((header.cols && (elements / header.cols != header.rows)) || (header.data_offset < matrix_data_offset) ||
+       (file.size() < header.data_offset) || ((file.size() - header.data_offset) / header.element_size < elements)) {
+        throw std::runtime_error("matrix file: file is too small for matrix");
+    }
+
+    return header;
+}
+
+/* row i of result from mapped elements of type U */
+template<typename T, typename U>
+void convert_rows(const void* src, const matrix_header_t& header, matrix_t<T>& m, const execution_policy_t& policy) {
+    const U* data = static_cast<const U*>(src);
+    std::size_t rows = header.rows, cols = header.cols;
+    bool row_major = (header.layout == layout_t::row_major);
+
+    policy.parallel_for((rows + tile_rows - 1) / tile_rows, [&](std::size_t tile) {
+        for(std::size_t i = tile * tile_rows, end = std::min(i + tile_rows, rows); i < end; ++i) {
+            auto row = m[i];
+            if(row_major && std::is_same_v<T, U>) {
+                std::memcpy(&row[0], data + i * cols, cols * sizeof(T));
+            } else if(row_major) {
+                for(std::size_t j = 0; j < cols; ++j) {
+                    row[j] = static_cast<T>(data[i * cols + j]);
+                }
+            } else {
+                for(std::size_t j = 0; j < cols; ++j) {
+                    row[j] = static_cast<T>(data[j * rows + i]);
+                }
+            }
+        }
+    });
+}
+
+/* without locale of isspace */
+inline bool is_space(int c) {
+    return (c == ' ') || (c == '\n') || (c == '\t') || (c == '\r') || (c == '\v') || (c == '\f');
+}
+
+/* characters of one number from stream buffer, returns its length, 0 at the end of stream */
+inline std::size_t next_token(std::streambuf& buf, char* token, std::size_t capacity) {
+    using traits = std::streambuf::traits_type;
+    int c = buf.sgetc();
+    while((c != traits::eof()) && is_space(c)) {
+        c = buf.snextc();
+    }
+
+    std::size_t ret = 0u;
+    while((c != traits::eof()) && !is_space(c)) {
+        if(ret == capacity) {
+            return capacity + 1;
+        }
+
+        token[ret++] = traits::to_char_type(c);
+        c = buf.snextc();
+    }
+
+    return ret;
+}
+
+} /* namespace detail */
+
+template<typename T>
+void write_binary(const std::string& path, const matrix_t<T>& m, layout_t layout /* = layout_t::row_major */) {
+    static_assert(std::is_trivially_copyable_v<T>, "write_binary: elements must be trivially copyable");
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out) {
+        throw std::runtime_error("write_binary: can't open " + path);
+    }
+
+    std::size_t rows = m.get_rows_number(), cols = m.get_cols_number();
+    char header_bytes[matrix_data_offset] = {};
+    matrix_header_t header{};
+    std::memcpy(header.magic, matrix_magic, sizeof(matrix_magic));
+    header.version = matrix_file_version;
+    header.byte_order = matrix_byte_order;
+    header.dtype = dtype_of<T>();
+    header.layout = layout;
+    header.element_size = sizeof(T);
+    header.rows = rows;
+    header.cols = cols;
+    header.data_offset = matrix_data_offset;
+    std::memcpy(header_bytes, &header, sizeof(header));
+    out.write(header_bytes, matrix_data_offset);
+
+    /* elements are gathered in buffer in layout order and written by big blocks */
+    std::vector<T> buffer(std::max<std::size_t>(detail::io_buffer_size / sizeof(T), 1u));
+    std::size_t filled = 0u;
+    auto flush = [&] {
+        out.write(reinterpret_cast<const char*>(buffer.data()), filled * sizeof(T));
+        filled = 0u;
+    };
+
+    std::size_t outer = (layout == layout_t::row_major) ? rows : cols;
+    std::size_t inner = (layout == layout_t::row_major) ? cols : rows;
+    for(std::size_t i = 0; i < outer; ++i) {
+        for(std::size_t j = 0; j < inner; ++j) {
+            if(filled == buffer.size()) {
+                flush();
+            }
+
+            buffer[filled++] = (layout == layout_t::row_major) ? m[i][j] : m[j][i];
+        }
+    }
+    flush();
+
+    out.flush();
+    if(!out) {
+        throw std::runtime_error("write_binary: can't write " + path);
+    }
+}
+
+template<typename T>
+matrix_t<T> read_binary(const std::string& path, const execution_policy_t& policy /* = sequential_policy */) {
+    detail::file_mapping_t file(path);
+    const matrix_header_t& header = detail::check_header(file);
+    const void* src = file.data() + header.data_offset;
+    ::madvise(const_cast<char*>(file.data()), file.size(), MADV_SEQUENTIAL);
+
+    matrix_t<T> ret(header.rows, header.cols);
+    switch(header.dtype) {
+        case dtype_t::int32:   detail::convert_rows<T, std::int32_t>(src, header, ret, policy); break;
+        case dtype_t::int64:   detail::convert_rows<T, std::int64_t>(src, header, ret, policy); break;
+        case dtype_t::float32: detail::convert_rows<T, float>(src, header, ret, policy); break;
+        case dtype_t::float64: detail::convert_rows<T, double>(src, header, ret, policy); break;
+        case dtype_t::float80: detail::convert_rows<T, long double>(src, header, ret, policy); break;
+    }
+
+    return ret;
+}
+
+template<typename T>
+mapped_matrix_t<T>::mapped_matrix_t(const std::string& path) {
+    detail::file_mapping_t file(path);
+    const matrix_header_t& header = detail::check_header(file);
+    if(header.dtype != dtype_of<T>()) {
+        throw std::runtime_error("mapped_matrix_t: dtype of file differs from matrix type");
+    }
+
+    if(header.data_offset % alignof(T)) {
+        throw std::runtime_error("mapped_matrix_t: elements of file are unaligned");
+    }
+
+    rows_ = header.rows;
+    cols_ = header.cols;
+    layout_ = header.layout;
+    row_stride_ = (layout_ == layout_t::row_major) ? cols_ : 1u;
+    col_stride_ = (layout_ == layout_t::row_major) ? 1u : rows_;
+    data_ = reinterpret_cast<const T*>(file.data() + header.data_offset);
+    std::tie(mapping_, mapping_size_) = file.release();
+}
+
+template<typename T>
+mapped_matrix_t<T>::mapped_matrix_t(mapped_matrix_t&& rhs) noexcept {
+    *this = std::move(rhs);
+}
+
+template<typename T>
+mapped_matrix_t<T>& mapped_matrix_t<T>::operator=(mapped_matrix_t&& rhs) noexcept {
+    std::swap(mapping_, rhs.mapping_);
+    std::swap(mapping_size_, rhs.mapping_size_);
+    std::swap(data_, rhs.data_);
+    std::swap(rows_, rhs.rows_);
+    std::swap(cols_, rhs.cols_);
+    std::swap(row_stride_, rhs.row_stride_);
+    std::swap(col_stride_, rhs.col_stride_);
+    std::swap(layout_, rhs.layout_);
+    return *this;
+}
+
+template<typename T>
+mapped_matrix_t<T>::~mapped_matrix_t() {
+    if(mapping_) {
+        ::munmap(mapping_, mapping_size_);
+    }
+}
+
+template<typename T>
+matrix_t<T> mapped_matrix_t<T>::to_matrix(const execution_policy_t& policy /* = sequential_policy */) const {
+    matrix_header_t header{};
+    header.rows = rows_;
+    header.cols = cols_;
+    header.layout = layout_;
+
+    matrix_t<T> ret(rows_, cols_);
+    detail::convert_rows<T, T>(data_, header, ret, policy);
+    return ret;
+}
+
+template<typename T>
+std::istream& read_text(std::istream& in, matrix_t<T>& m) {
+    std::istream::sentry sentry(in);
+    if(!sentry) {
+        return in;
+    }
+
+    std::streambuf& buf = *in.rdbuf();
+    char token[128];
+    for(std::size_t i = 0, rows = m.get_rows_number(); i < rows; ++i) {
+        auto row = m[i];
+        for(std::size_t j = 0, cols = m.get_cols_number(); j < cols; ++j) {
+            std::size_t length = detail::next_token(buf, token, sizeof(token));
+            if(!length || (length > sizeof(token))) {
+                in.setstate(length ? std::ios::failbit : (std::ios::failbit | std::ios::eofbit));
+                return in;
+            }
+
+            /* from_chars doesn't accept leading plus */
+            const char* first = token + ((token[0] == '+') && (length > 1));
+            auto [last, error] = std::from_chars(first, token + length, row[j]);
+            if((error != std::errc{}) || (last != token + length)) {
+                in.setstate(std::ios::failbit);
+                return in;
+            }
+        }
+    }
+
+    return in;
+}
+
+template<typename T>
+std::ostream& write_text(std::ostream& out, const matrix_t<T>& m) {
+    std::vector<char> buffer(detail::io_buffer_size);
+    std::size_t filled = 0u;
+    for(std::size_t i = 0; m.get_cols_number() && (i < m.get_rows_number()); ++i) {
+        for(std::size_t j = 0; j < m.get_cols_number(); ++j) {
+            /* longest number (long double) takes less than 64 characters */
+            if(buffer.size() - filled < 64u) {
+                out.write(buffer.data(), filled);
+                filled = 0u;
+            }
+
+            filled = std::to_chars(buffer.data() + filled, buffer.data() + buffer.size(), m[i][j]).ptr - buffer.data();
+            buffer[filled++] = ' ';
+        }
+        buffer[filled - 1] = '\n';
+    }
+    out.write(buffer.data(), filled);
+
+    return out;
+}
+
+} /* namespace matrix */
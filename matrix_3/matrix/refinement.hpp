@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "matrix.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+/*
+    ***mixed precision iterative refinement***
+
+    A is factorized once in Low (float by default, so LU goes through vectorized gemm kernels
+    of float), then solution is refined in T:
+
+        r = b - A * x (in T),   L * U * d = r (in Low),   x += d
+
+    Every step reduces error by cond(A) * eps(Low), so it converges to accuracy of T when
+    cond(A) < 1 / eps(Low). If refinement stagnates, diverges or LU in Low is singular,
+    system is solved by LU in T (fallback).
+
+    function contract:
+
+        1) A - n * n, b - n * k
+        2) T, Low - floating point types
+*/
+struct refinement_options_t {
+    std::size_t max_iterations = 30u;
+
+    /* refinement stagnates, when correction is reduced less than by this factor */
+    double stagnation_ratio = 0.5;
+};
+
+template<typename T>
+struct refinement_result_t {
+    matrix_t<T> x;
+    std::size_t iterations = 0u;
+
+    /* refinement didn't converge, x is found by LU in T */
+    bool fallback = false;
+
+    /* normwise backward error ||b - A * x|| / (||A|| * ||x|| + ||b||), infinity norms */
+    T backward_error = T{};
+};
+
+template<typename T, typename Low = float>
+refinement_result_t<T> solve_refined(const_matrix_view_t<T> a, const_matrix_view_t<T> b,
+                                     const refinement_options_t& options = {}, const execution_policy_t& policy = sequential_policy);
+
+template<typename T, typename Low = float>
+refinement_result_t<T> solve_refined(const matrix_t<T>& a, const matrix_t<T>& b,
+                                     const refinement_options_t& options = {}, const execution_policy_t& policy = sequential_policy) {
+    return solve_refined<T, Low>(a.view(), b.view(), options, policy);
+}
+
+/* normwise backward error of solution x of A * x = b */
+template<typename T>
+T backward_error(const matrix_t<T>& a, const matrix_t<T>& b, const matrix_t<T>& x, const execution_policy_t& policy = sequential_policy);
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+namespace detail {
+
+/* max of row sums of absolute values */
+template<typename E, typename T = std::remove_const_t<E>>
+T norm_inf(matrix_view_t<E> m) {
+    T ret{};
+    for(std::size_t i = 0; i < m.get_rows_number(); ++i) {
+        T sum{};
+        auto row = m[i];
+        for(std::size_t j = 0; j < m.get_cols_number(); ++j) {
+            sum += std::abs(row[j]);
+        }
+        ret = std::max(ret, sum);
+    }
+
+    return ret;
+}
+
+/* the biggest absolute value, nan if matrix has not finite elements */
+template<typename E, typename T = std::remove_const_t<E>>
+T max_abs(matrix_view_t<E> m) {
+    T ret{};
+    for(std::size_t i = 0; i < m.get_rows_number(); ++i) {
+        auto row = m[i];
+        for(std::size_t j = 0; j < m.get_cols_number(); ++j) {
+            if(!std::isfinite(row[j])) {
+                return std::numeric_limits<T>::quiet_NaN();
+            }
+            ret = std::max(ret, std::abs(row[j]));
+        }
+    }
+
+    return ret;
+}
+
+/* E - element type of view, it can be const */
+template<typename To, typename E>
+matrix_t<To> convert(matrix_view_t<E> m) {
+    matrix_t<To> ret(m.get_rows_number(), m.get_cols_number());
+    for(std::size_t i = 0; i < m.get_rows_number(); ++i) {
+        auto row = m[i];
+        for(std::size_t j = 0; j < m.get_cols_number(); ++j) {
+            ret[i][j] = static_cast<To>(row[j]);
+        }
+    }
+
+    return ret;
+}
+
+/* r = b - A * x */
+template<typename T>
+matrix_t<T> residual(const_matrix_view_t<T> a, const_matrix_view_t<T> b, const matrix_t<T>& x, const execution_policy_t& policy) {
+    matrix_t<T> ret = multiplication(a, x.view(), policy);
+    for(std::size_t i = 0; i < ret.get_rows_number(); ++i) {
+        auto row = b[i];
+        for(std::size_t j = 0; j < ret.get_cols_number(); ++j) {
+            ret[i][j] = row[j] - ret[i][j];
+        }
+    }
+
+    return ret;
+}
+
+template<typename T>
+T backward_error(const matrix_t<T>& r, T a_norm, const matrix_t<T>& x, T b_norm) {
+    T denominator = a_norm * norm_inf(x.view()) + b_norm;
+    return (denominator > T{}) ? norm_inf(r.view()) / denominator : T{};
+}
+
+} /* namespace detail */
+
+template<typename T, typename Low /* = float */>
+refinement_result_t<T> solve_refined(const_matrix_view_t<T> a, const_matrix_view_t<T> b,
+                                     const refinement_options_t& options /* = {} */, const execution_policy_t& policy /* = sequential_policy */) {
+    static_assert(std::is_floating_point_v<T> && std::is_floating_point_v<Low>, "solve_refined: only floating point types");
+
+    std::size_t n = a.get_rows_number();
+    if((a.get_cols_number() != n) || (b.get_rows_number() != n)) {
+        throw std::runtime_error("solve_refined: invalid matrix sizes");
+    }
+
+    refinement_result_t<T> ret;
+    T a_norm = detail::norm_inf(a), b_norm = detail::norm_inf(b);
+    auto solve_in_t = [&] {
+        ret.x = lu_decomposition_t<T>(a, policy).solve(b);
+        ret.fallback = true;
+        ret.backward_error = detail::backward_error(detail::residual(a, b, ret.x, policy), a_norm, ret.x, b_norm);
+        return ret;
+    };
+
+    /* elements out of range of Low */
+    if(!(detail::max_abs(a) <= static_cast<T>(std::numeric_limits<Low>::max()))) {
+        return solve_in_t();
+    }
+
+    lu_decomposition_t<Low> lu(detail::convert<Low>(a).view(), policy);
+    if(lu.singular()) {
+        return solve_in_t();
+    }
+
+    ret.x = detail::convert<T>(lu.solve(detail::convert<Low>(b).view()).view());
+
+    /* stop criterion of normwise backward error */
+    const T tolerance = std::numeric_limits<T>::epsilon() * std::sqrt(static_cast<T>(std::max<std::size_t>(n, 1u)));
+    T previous_correction = std::numeric_limits<T>::infinity();
+    for(;;) {
+        matrix_t<T> r = detail::residual(a, b, ret.x, policy);
+        ret.backward_error = detail::backward_error(r, a_norm, ret.x, b_norm);
+        if(ret.backward_error <= tolerance) {
+            return ret;
+        }
+
+        if((ret.iterations == options.max_iterations) || !std::isfinite(ret.backward_error)) {
+            return solve_in_t();
+        }
+
+        /* correction is scaled into range of Low, so small residuals don't underflow */
+        T scale = detail::max_abs(r.view());
+        for(std::size_t i = 0; i < n; ++i) {
+            for(std::size_t j = 0; j < r.get_cols_number(); ++j) {
+                r[i][j] /= scale;
+            }
+        }
+
+        matrix_t<Low> d = lu.solve(detail::convert<Low>(r.view()).view());
+        T correction{};
+        for(std::size_t i = 0; i < n; ++i) {
+            for(std::size_t j = 0; j < d.get_cols_number(); ++j) {
+                T delta = scale * static_cast<T>(d[i][j]);
+                ret.x[i][j] += delta;
+                correction = std::max(correction, std::abs(delta));
+            }
+        }
+        ++ret.iterations;
+
+        /* correction is below precision of x */
+        if(correction <= std::numeric_limits<T>::epsilon() * detail::max_abs(ret.x.view())) {
+            ret.backward_error = detail::backward_error(detail::residual(a, b, ret.x, policy), a_norm, ret.x, b_norm);
+            return ret;
+        }
+
+        if(!(correction <= options.stagnation_ratio * previous_correction)) {
+            return solve_in_t();
+        }
+        previous_correction = correction;
+    }
+}
+
+template<typename T>
+T backward_error(const matrix_t<T>& a, const matrix_t<T>& b, const matrix_t<T>& x, const execution_policy_t& policy /* = sequential_policy */) {
+    return detail::backward_error(detail::residual(a.view(), b.view(), x, policy), detail::norm_inf(a.view()), x, detail::norm_inf(b.view()));
+}
+
+} /* namespace matrix */
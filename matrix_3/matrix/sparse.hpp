@@ -0,0 +1,297 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "matrix.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+/* element of sparse matrix in coordinate form */
+template<typename T>
+struct triplet_t {
+    std::size_t row;
+    std::size_t col;
+    T value;
+};
+
+template<typename T>
+class csc_matrix_t;
+
+/*
+    ***compressed sparse row matrix***
+
+    values of row i are values[row_ptr[i] .. row_ptr[i + 1]), their columns are col_idx[...],
+    columns in every row are sorted and unique (duplicated triplets are summed)
+*/
+template<typename T>
+class csr_matrix_t final {
+public:
+    csr_matrix_t() = default;
+    csr_matrix_t(std::size_t rows, std::size_t cols, const std::vector<triplet_t<T>>& triplets);
+    explicit csr_matrix_t(const csc_matrix_t<T>& m);
+    explicit csr_matrix_t(const matrix_t<T>& m);
+
+    std::size_t get_rows_number() const {return rows_;}
+    std::size_t get_cols_number() const {return cols_;}
+    std::size_t get_nonzeros_number() const {return values_.size();}
+
+    const std::vector<std::size_t>& get_row_ptr() const {return row_ptr_;}
+    const std::vector<std::size_t>& get_col_idx() const {return col_idx_;}
+    const std::vector<T>& get_values() const {return values_;}
+
+    matrix_t<T> to_dense() const;
+
+    /* y = A * x, rows are split between threads of policy */
+    std::vector<T> multiply(const std::vector<T>& x, const execution_policy_t& policy = sequential_policy) const;
+
+    /* the same into existing vector, iterative solvers don't allocate on every product */
+    void multiply(const std::vector<T>& x, std::vector<T>& y, const execution_policy_t& policy = sequential_policy) const;
+
+private:
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::vector<std::size_t> row_ptr_{0u};
+    std::vector<std::size_t> col_idx_;
+    std::vector<T> values_;
+
+    friend class csc_matrix_t<T>;
+};
+
+/* compressed sparse column matrix, the same as csr_matrix_t for columns */
+template<typename T>
+class csc_matrix_t final {
+public:
+    csc_matrix_t() = default;
+    csc_matrix_t(std::size_t rows, std::size_t cols, const std::vector<triplet_t<T>>& triplets);
+    explicit csc_matrix_t(const csr_matrix_t<T>& m);
+    explicit csc_matrix_t(const matrix_t<T>& m);
+
+    std::size_t get_rows_number() const {return rows_;}
+    std::size_t get_cols_number() const {return cols_;}
+    std::size_t get_nonzeros_number() const {return values_.size();}
+
+    const std::vector<std::size_t>& get_col_ptr() const {return col_ptr_;}
+    const std::vector<std::size_t>& get_row_idx() const {return row_idx_;}
+    const std::vector<T>& get_values() const {return values_;}
+
+    matrix_t<T> to_dense() const;
+
+    /* y = A * x, columns scatter into y, so it's sequential, use csr_matrix_t for parallel one */
+    std::vector<T> multiply(const std::vector<T>& x) const;
+    void multiply(const std::vector<T>& x, std::vector<T>& y) const;
+
+private:
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::vector<std::size_t> col_ptr_{0u};
+    std::vector<std::size_t> row_idx_;
+    std::vector<T> values_;
+
+    friend class csr_matrix_t<T>;
+};
+
+namespace detail {
+
+/* rows of SpMV taken by one task */
+constexpr std::size_t spmv_chunk = 4096u;
+
+/*  compressed form of triplets: major index is row for csr and column for csc.
+    Counting sort by minor index, then stable counting sort by major index gives sorted minor indices */
+template<typename T, typename Major, typename Minor>
+void compress(std::size_t major_count, std::size_t minor_count, const std::vector<triplet_t<T>>& triplets, Major major, Minor minor,
+              std::vector<std::size_t>& ptr, std::vector<std::size_t>& idx, std::vector<T>& values) {
+    std::vector<std::size_t> minor_ptr(minor_count + 1, 0u);
+    for(auto&& t : triplets) {
+        if((major(t) >= major_count) || (minor(t) >= minor_count)) {
+            throw std::runtime_error("sparse matrix: triplet is out of matrix");
+        }
+        ++minor_ptr[minor(t) + 1];
+    }
+    std::partial_sum(minor_ptr.begin(), minor_ptr.end(), minor_ptr.begin());
+
+    std::vector<std::size_t> by_minor(triplets.size());
+    for(std::size_t k = 0; k < triplets.size(); ++k) {
+        by_minor[minor_ptr[minor(triplets[k])]++] = k;
+    }
+
+    ptr.assign(major_count + 1, 0u);
+    for(auto&& t : triplets) {
+        ++ptr[major(t) + 1];
+    }
+    std::partial_sum(ptr.begin(), ptr.end(), ptr.begin());
+
+    std::vector<std::size_t> position(ptr.begin(), ptr.end() - 1);
+    std::vector<std::size_t> sorted(triplets.size());
+    for(std::size_t k : by_minor) {
+        sorted[position[major(triplets[k])]++] = k;
+    }
+
+    /* duplicates are neighbours now */
+    idx.clear(); idx.reserve(triplets.size());
+    values.clear(); values.reserve(triplets.size());
+    std::size_t begin = 0u;
+    for(std::size_t i = 0; i < major_count; ++i) {
+        std::size_t end = ptr[i + 1];
+        ptr[i] = idx.size();
+        for(std::size_t p = begin; p < end; ++p) {
+            const triplet_t<T>& t = triplets[sorted[p]];
+            if((idx.size() > ptr[i]) && (idx.back() == minor(t))) {
+                values.back() += t.value;
+            } else {
+                idx.push_back(minor(t));
+                values.push_back(t.value);
+            }
+        }
+        begin = end;
+    }
+    ptr[major_count] = idx.size();
+}
+
+/* the same matrix in the other compressed form: transposition of ptr/idx arrays */
+template<typename T>
+void transpose_compressed(std::size_t major_count, std::size_t minor_count,
+                          const std::vector<std::size_t>& ptr, const std::vector<std::size_t>& idx, const std::vector<T>& values,
+                          std::vector<std::size_t>& t_ptr, std::vector<std::size_t>& t_idx, std::vector<T>& t_values) {
+    t_ptr.assign(minor_count + 1, 0u);
+    for(std::size_t i : idx) {
+        ++t_ptr[i + 1];
+    }
+    std::partial_sum(t_ptr.begin(), t_ptr.end(), t_ptr.begin());
+
+    std::vector<std::size_t> position(t_ptr.begin(), t_ptr.end() - 1);
+    t_idx.resize(idx.size());
+    t_values.resize(values.size());
+    for(std::size_t j = 0; j < major_count; ++j) {
+        for(std::size_t p = ptr[j]; p < ptr[j + 1]; ++p) {
+            std::size_t q = position[idx[p]]++;
+            t_idx[q] = j;
+            t_values[q] = values[p];
+        }
+    }
+}
+
+template<typename T>
+std::vector<triplet_t<T>> dense_triplets(const matrix_t<T>& m) {
+    std::vector<triplet_t<T>> ret;
+    for(std::size_t i = 0, maxi = m.get_rows_number(); i < maxi; ++i) {
+        for(std::size_t j = 0, maxj = m.get_cols_number(); j < maxj; ++j) {
+            if(m[i][j] != T{}) {
+                ret.push_back({i, j, m[i][j]});
+            }
+        }
+    }
+
+    return ret;
+}
+
+} /* namespace detail */
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+csr_matrix_t<T>::csr_matrix_t(std::size_t rows, std::size_t cols, const std::vector<triplet_t<T>>& triplets) : rows_(rows), cols_(cols) {
+    detail::compress(rows, cols, triplets, [](const triplet_t<T>& t) {return t.row;}, [](const triplet_t<T>& t) {return t.col;},
+                     row_ptr_, col_idx_, values_);
+}
+
+template<typename T>
+csr_matrix_t<T>::csr_matrix_t(const csc_matrix_t<T>& m) : rows_(m.rows_), cols_(m.cols_) {
+    detail::transpose_compressed(m.cols_, m.rows_, m.col_ptr_, m.row_idx_, m.values_, row_ptr_, col_idx_, values_);
+}
+
+template<typename T>
+csr_matrix_t<T>::csr_matrix_t(const matrix_t<T>& m) : csr_matrix_t(m.get_rows_number(), m.get_cols_number(), detail::dense_triplets(m)) {}
+
+template<typename T>
+matrix_t<T> csr_matrix_t<T>::to_dense() const {
+    matrix_t<T> ret(rows_, cols_);
+    for(std::size_t i = 0; i < rows_; ++i) {
+        for(std::size_t p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+            ret[i][col_idx_[p]] = values_[p];
+        }
+    }
+
+    return ret;
+}
+
+template<typename T>
+std::vector<T> csr_matrix_t<T>::multiply(const std::vector<T>& x, const execution_policy_t& policy /* = sequential_policy */) const {
+    std::vector<T> y;
+    multiply(x, y, policy);
+    return y;
+}
+
+template<typename T>
+void csr_matrix_t<T>::multiply(const std::vector<T>& x, std::vector<T>& y, const execution_policy_t& policy /* = sequential_policy */) const {
+    if(x.size() != cols_) {
+        throw std::runtime_error("csr_matrix_t::multiply: invalid vector size");
+    }
+
+    y.resize(rows_);
+    policy.parallel_for((rows_ + detail::spmv_chunk - 1) / detail::spmv_chunk, [&](std::size_t chunk) {
+        for(std::size_t i = chunk * detail::spmv_chunk, maxi = std::min(i + detail::spmv_chunk, rows_); i < maxi; ++i) {
+            T sum{};
+            for(std::size_t p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+                sum += values_[p] * x[col_idx_[p]];
+            }
+            y[i] = sum;
+        }
+    });
+}
+
+template<typename T>
+csc_matrix_t<T>::csc_matrix_t(std::size_t rows, std::size_t cols, const std::vector<triplet_t<T>>& triplets) : rows_(rows), cols_(cols) {
+    detail::compress(cols, rows, triplets, [](const triplet_t<T>& t) {return t.col;}, [](const triplet_t<T>& t) {return t.row;},
+                     col_ptr_, row_idx_, values_);
+}
+
+template<typename T>
+csc_matrix_t<T>::csc_matrix_t(const csr_matrix_t<T>& m) : rows_(m.rows_), cols_(m.cols_) {
+    detail::transpose_compressed(m.rows_, m.cols_, m.row_ptr_, m.col_idx_, m.values_, col_ptr_, row_idx_, values_);
+}
+
+template<typename T>
+csc_matrix_t<T>::csc_matrix_t(const matrix_t<T>& m) : csc_matrix_t(m.get_rows_number(), m.get_cols_number(), detail::dense_triplets(m)) {}
+
+template<typename T>
+matrix_t<T> csc_matrix_t<T>::to_dense() const {
+    matrix_t<T> ret(rows_, cols_);
+    for(std::size_t j = 0; j < cols_; ++j) {
+        for(std::size_t p = col_ptr_[j]; p < col_ptr_[j + 1]; ++p) {
+            ret[row_idx_[p]][j] = values_[p];
+        }
+    }
+
+    return ret;
+}
+
+template<typename T>
+std::vector<T> csc_matrix_t<T>::multiply(const std::vector<T>& x) const {
+    std::vector<T> y;
+    multiply(x, y);
+    return y;
+}
+
+template<typename T>
+void csc_matrix_t<T>::multiply(const std::vector<T>& x, std::vector<T>& y) const {
+    if(x.size() != cols_) {
+        throw std::runtime_error("csc_matrix_t::multiply: invalid vector size");
+    }
+
+    y.assign(rows_, T{});
+    for(std::size_t j = 0; j < cols_; ++j) {
+        for(std::size_t p = col_ptr_[j]; p < col_ptr_[j + 1]; ++p) {
+            y[row_idx_[p]] += values_[p] * x[j];
+        }
+    }
+}
+
+} /* namespace matrix */
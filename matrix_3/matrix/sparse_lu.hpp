@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "sparse.hpp"
+#include "amd.hpp"
+
+namespace matrix {
+
+/*
+    ***sparse LU decomposition with partial pivoting: P * A * Q = L * U***
+
+    columns are taken in amd order (Q), every column is found by sparse triangular solve
+    with L computed so far (gilbert-peierls left-looking algorithm), so work is proportional
+    to arithmetic operations. Diagonal pivot is preferred, if it's not less than
+    pivot_tolerance * max element of column, otherwise the biggest one is taken
+
+    function contract:
+
+        1) matrix must be square
+        2) T - floating point type
+*/
+template<typename T>
+class sparse_lu_t final {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    explicit sparse_lu_t(const csc_matrix_t<T>& m, double pivot_tolerance = 0.1);
+
+    std::size_t size() const {return n_;}
+    bool singular() const {return singular_;}
+
+    /* nonzeros of L and U */
+    std::size_t get_factor_nonzeros() const {return l_idx_.size() + u_idx_.size();}
+
+    /* solution of A * x = b, throws if matrix is singular */
+    std::vector<T> solve(const std::vector<T>& b) const;
+
+private:
+    std::size_t reach(const csc_matrix_t<T>& m, std::size_t col, std::vector<std::size_t>& xi);
+    void dfs(std::size_t j, std::size_t& top, std::vector<std::size_t>& xi);
+
+private:
+    std::size_t n_;
+    bool singular_ = false;
+
+    /* L has unit diagonal, stored first in column; diagonal of U is stored last */
+    std::vector<std::size_t> l_ptr_, l_idx_, u_ptr_, u_idx_;
+    std::vector<T> l_values_, u_values_;
+
+    std::vector<std::size_t> pinv_; /* row i of A is pinv_[i] row of L * U */
+    std::vector<std::size_t> q_;    /* column k of L * U is q_[k] column of A */
+
+    /* dfs state */
+    std::vector<std::size_t> visited_;
+    std::size_t stamp_ = 0u;
+};
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+template<typename T>
+sparse_lu_t<T>::sparse_lu_t(const csc_matrix_t<T>& m, double pivot_tolerance /* = 0.1 */) : n_(m.get_cols_number()) {
+    if(m.get_rows_number() != m.get_cols_number()) {
+        throw std::runtime_error("sparse_lu_t: matrix must be square");
+    }
+
+    q_ = amd_order(m);
+    pinv_.assign(n_, npos);
+    visited_.assign(n_, 0u);
+
+    l_ptr_.assign(n_ + 1, 0u);
+    u_ptr_.assign(n_ + 1, 0u);
+    std::size_t expected_nonzeros = 4 * m.get_nonzeros_number() + n_;
+    l_idx_.reserve(expected_nonzeros); l_values_.reserve(expected_nonzeros);
+    u_idx_.reserve(expected_nonzeros); u_values_.reserve(expected_nonzeros);
+
+    std::vector<T> x(n_, T{});
+    std::vector<std::size_t> xi(2 * n_);
+
+    for(std::size_t k = 0; k < n_; ++k) {
+        l_ptr_[k] = l_idx_.size();
+        u_ptr_[k] = u_idx_.size();
+        std::size_t col = q_[k];
+
+        /* x = L \ A(:, col), nonzero pattern is xi[top .. n) in topological order */
+        std::size_t top = reach(m, col, xi);
+        const auto& a_ptr = m.get_col_ptr();
+        const auto& a_idx = m.get_row_idx();
+        const auto& a_values = m.get_values();
+        for(std::size_t p = a_ptr[col]; p < a_ptr[col + 1]; ++p) {
+            x[a_idx[p]] = a_values[p];
+        }
+
+        for(std::size_t px = top; px < n_; ++px) {
+            std::size_t j = xi[px];
+            std::size_t l_col = pinv_[j];
+            if(l_col == npos) {
+                continue;
+            }
+
+            T xj = x[j];
+            for(std::size_t p = l_ptr_[l_col] + 1; p < l_ptr_[l_col + 1]; ++p) {
+                x[l_idx_[p]] -= l_values_[p] * xj;
+            }
+        }
+
+        /* rows already pivotal go to U, the biggest of others is pivot */
+        std::size_t pivot_row = npos;
+        T max_abs{};
+        for(std::size_t px = top; px < n_; ++px) {
+            std::size_t i = xi[px];
+            if(pinv_[i] == npos) {
+                T abs = std::abs(x[i]);
+                if(abs > max_abs) {
+                    max_abs = abs;
+                    pivot_row = i;
+                }
+            } else {
+                u_idx_.push_back(pinv_[i]);
+                u_values_.push_back(x[i]);
+            }
+        }
+
+        if((pivot_row == npos) || !(max_abs > T{})) {
+            singular_ = true;
+            return;
+        }
+
+        if((pinv_[col] == npos) && (std::abs(x[col]) >= max_abs * pivot_tolerance)) {
+            pivot_row = col;
+        }
+
+        T pivot = x[pivot_row];
+        u_idx_.push_back(k);
+        u_values_.push_back(pivot);
+        pinv_[pivot_row] = k;
+
+        l_idx_.push_back(pivot_row);
+        l_values_.push_back(T{1});
+        for(std::size_t px = top; px < n_; ++px) {
+            std::size_t i = xi[px];
+            if(pinv_[i] == npos) {
+                l_idx_.push_back(i);
+                l_values_.push_back(x[i] / pivot);
+            }
+            x[i] = T{};
+        }
+    }
+
+    l_ptr_[n_] = l_idx_.size();
+    u_ptr_[n_] = u_idx_.size();
+
+    /* rows of L in pivot order */
+    for(std::size_t& i : l_idx_) {
+        i = pinv_[i];
+    }
+}
+
+/* rows reachable from pattern of A(:, col) in graph of L, it's pattern of L \ A(:, col) */
+template<typename T>
+std::size_t sparse_lu_t<T>::reach(const csc_matrix_t<T>& m, std::size_t col, std::vector<std::size_t>& xi) {
+    ++stamp_;
+    std::size_t top = n_;
+    const auto& a_ptr = m.get_col_ptr();
+    const auto& a_idx = m.get_row_idx();
+    for(std::size_t p = a_ptr[col]; p < a_ptr[col + 1]; ++p) {
+        if(visited_[a_idx[p]] != stamp_) {
+            dfs(a_idx[p], top, xi);
+        }
+    }
+
+    return top;
+}
+
+/*  non-recursive dfs, xi[0 .. head] is stack of rows, xi[n + head] - position in L column of stack row,
+    finished rows are pushed to xi[--top] */
+template<typename T>
+void sparse_lu_t<T>::dfs(std::size_t j, std::size_t& top, std::vector<std::size_t>& xi) {
+    std::size_t head = 0u;
+    xi[0] = j;
+    for(;;) {
+        j = xi[head];
+        std::size_t l_col = pinv_[j];
+        if(visited_[j] != stamp_) {
+            visited_[j] = stamp_;
+            xi[n_ + head] = (l_col == npos) ? 0u : l_ptr_[l_col];
+        }
+
+        bool done = true;
+        std::size_t end = (l_col == npos) ? 0u : l_ptr_[l_col + 1];
+        for(std::size_t p = xi[n_ + head]; p < end; ++p) {
+            std::size_t i = l_idx_[p];
+            if(visited_[i] == stamp_) {
+                continue;
+            }
+
+            xi[n_ + head] = p;
+            xi[++head] = i;
+            done = false;
+            break;
+        }
+
+        if(done) {
+            xi[--top] = j;
+            if(head == 0u) {
+                return;
+            }
+            --head;
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> sparse_lu_t<T>::solve(const std::vector<T>& b) const {
+    if(singular_) {
+        throw std::runtime_error("sparse_lu_t::solve: matrix is singular");
+    }
+
+    if(b.size() != n_) {
+        throw std::runtime_error("sparse_lu_t::solve: invalid right side size");
+    }
+
+    std::vector<T> y(n_);
+    for(std::size_t i = 0; i < n_; ++i) {
+        y[pinv_[i]] = b[i];
+    }
+
+    for(std::size_t j = 0; j < n_; ++j) {
+        T yj = y[j];
+        for(std::size_t p = l_ptr_[j] + 1; p < l_ptr_[j + 1]; ++p) {
+            y[l_idx_[p]] -= l_values_[p] * yj;
+        }
+    }
+
+    for(std::size_t j = n_; j-- > 0;) {
+        y[j] /= u_values_[u_ptr_[j + 1] - 1];
+        T yj = y[j];
+        for(std::size_t p = u_ptr_[j]; p + 1 < u_ptr_[j + 1]; ++p) {
+            y[u_idx_[p]] -= u_values_[p] * yj;
+        }
+    }
+
+    std::vector<T> x(n_);
+    for(std::size_t k = 0; k < n_; ++k) {
+        x[q_[k]] = y[k];
+    }
+
+    return x;
+}
+
+} /* namespace matrix */
@@ -0,0 +1,575 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "matrix.hpp"
+#include "execution.hpp"
+
+namespace matrix {
+
+/*
+    ***symmetric eigen-decomposition and singular value decomposition***
+
+    symmetric_eigen: A = V * diag(values) * V^T, values are ascending, columns of V are eigenvectors
+
+        1) A is reduced to tridiagonal T = Q^T * A * Q by householder reflections, matrix-vector
+           product and rank 2 update of every step are split between threads by rows
+        2) T = Z * diag(values) * Z^T by implicit QL with wilkinson shifts, rotations of several
+           sweeps are applied to rows of Z^T by column tiles in parallel
+        3) Q is accumulated from blocks of reflections in compact WY form (I - Y * S * Y^T)
+           and V = Q * Z, both by gemm
+
+    svd: A = U * diag(values) * V^T, values are descending
+        A - m * n, U - m * min(m, n), V - n * min(m, n)
+
+        one-sided jacobi: pairs of columns of A are rotated until all of them are orthogonal,
+        then singular values are norms of columns. Columns are split into blocks, which fit in cache,
+        pairs of blocks of every round of round-robin ordering are disjoint, so they are rotated
+        in parallel. Columns of U for singular values at rounding level of A are not orthonormal
+        (zero for zero singular values).
+
+    function contract: T - floating point type.
+    Results don't depend on threads number, functions throw if iterations don't converge
+*/
+template<typename T>
+struct symmetric_eigen_t {
+    std::vector<T> values;
+    matrix_t<T> vectors;
+};
+
+template<typename T>
+struct svd_t {
+    matrix_t<T> u;
+    std::vector<T> values;
+    matrix_t<T> v;
+};
+
+/* only lower triangle of A is used */
+template<typename T>
+symmetric_eigen_t<T> symmetric_eigen(const_matrix_view_t<T> a, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+symmetric_eigen_t<T> symmetric_eigen(const matrix_t<T>& a, const execution_policy_t& policy = sequential_policy) {
+    return symmetric_eigen(a.view(), policy);
+}
+
+template<typename T>
+svd_t<T> svd(const_matrix_view_t<T> a, const execution_policy_t& policy = sequential_policy);
+
+template<typename T>
+svd_t<T> svd(const matrix_t<T>& a, const execution_policy_t& policy = sequential_policy) {
+    return svd(a.view(), policy);
+}
+
+/* ------------------------------------------------------------------
+                        IMPLEMENTATION
+---------------------------------------------------------------------*/
+
+namespace detail {
+
+/* reflections in one block of Q accumulation */
+constexpr std::size_t reflection_block = 32u;
+
+/* QL rotations are applied by batches of rotation_batch * n rotations to tiles of columns */
+constexpr std::size_t rotation_batch = 16u;
+constexpr std::size_t rotation_tile_cols = 64u;
+
+/* memory for 2 blocks of rows of one-sided jacobi */
+constexpr std::size_t svd_block_bytes = 1u << 18u;
+
+template<typename T>
+matrix_t<T> identity(std::size_t n) {
+    matrix_t<T> ret(n, n);
+    for(std::size_t i = 0; i < n; ++i) {
+        ret[i][i] = T{1};
+    }
+
+    return ret;
+}
+
+/*  H = I - beta * v * v^T, H * x = alpha * e1
+    x is replaced by v (v[0] == 1), returns beta, beta == 0 if H == I */
+template<typename T>
+T make_reflection(std::vector<T>& x, T& alpha) {
+    T sigma{};
+    for(std::size_t i = 1; i < x.size(); ++i) {
+        sigma += x[i] * x[i];
+    }
+
+    if(sigma == T{}) {
+        alpha = x[0];
+        x[0] = T{1};
+        return T{};
+    }
+
+    T mu = std::sqrt(x[0] * x[0] + sigma);
+    T v0 = (x[0] <= T{}) ? x[0] - mu : -sigma / (x[0] + mu);
+    for(std::size_t i = 1; i < x.size(); ++i) {
+        x[i] /= v0;
+    }
+    x[0] = T{1};
+    alpha = mu;
+
+    return T{2} * v0 * v0 / (sigma + v0 * v0);
+}
+
+/* independent partial sums, so additions are not chained and can be vectorized without reordering */
+template<typename T>
+T dot(const T* lhs, const T* rhs, std::size_t size) {
+    constexpr std::size_t lanes = 8u;
+    T sums[lanes] = {};
+    std::size_t i = 0;
+    for(; i + lanes <= size; i += lanes) {
+        for(std::size_t l = 0; l < lanes; ++l) {
+            sums[l] += lhs[i + l] * rhs[i + l];
+        }
+    }
+
+    T ret{};
+    for(; i < size; ++i) {
+        ret += lhs[i] * rhs[i];
+    }
+    for(std::size_t l = 0; l < lanes; ++l) {
+        ret += sums[l];
+    }
+
+    return ret;
+}
+
+/* [lhs, rhs] = [c * lhs - s * rhs, s * lhs + c * rhs], rows are loaded by blocks, so block is vectorized */
+template<typename T>
+void rotate_rows(T* lhs, T* rhs, std::size_t size, T c, T s) {
+    constexpr std::size_t lanes = 8u;
+    std::size_t k = 0;
+    for(; k + lanes <= size; k += lanes) {
+        T x[lanes], y[lanes];
+        for(std::size_t l = 0; l < lanes; ++l) {
+            x[l] = lhs[k + l];
+            y[l] = rhs[k + l];
+        }
+        for(std::size_t l = 0; l < lanes; ++l) {
+            lhs[k + l] = c * x[l] - s * y[l];
+        }
+        for(std::size_t l = 0; l < lanes; ++l) {
+            rhs[k + l] = s * x[l] + c * y[l];
+        }
+    }
+
+    for(; k < size; ++k) {
+        T x = lhs[k], y = rhs[k];
+        lhs[k] = c * x - s * y;
+        rhs[k] = s * x + c * y;
+    }
+}
+
+/* row -= vi * w + wi * v, by blocks like rotate_rows */
+template<typename T>
+void rank2_update(T* row, const T* v, const T* w, std::size_t size, T vi, T wi) {
+    constexpr std::size_t lanes = 8u;
+    std::size_t k = 0;
+    for(; k + lanes <= size; k += lanes) {
+        T x[lanes];
+        for(std::size_t l = 0; l < lanes; ++l) {
+            x[l] = row[k + l] - (vi * w[k + l] + wi * v[k + l]);
+        }
+        for(std::size_t l = 0; l < lanes; ++l) {
+            row[k + l] = x[l];
+        }
+    }
+
+    for(; k < size; ++k) {
+        row[k] -= vi * w[k] + wi * v[k];
+    }
+}
+
+/*  a = Q * T * Q^T, d - diagonal of T, e - subdiagonal (e[n - 1] == 0).
+    reflection k is stored in column k of a below diagonal (rows from k + 1), beta[k] - its factor */
+template<typename T>
+void tridiagonalize(matrix_t<T>& a, std::vector<T>& d, std::vector<T>& e, std::vector<T>& beta, const execution_policy_t& policy) {
+    std::size_t n = a.get_rows_number();
+    matrix_view_t<T> av = a.view();
+    std::vector<T> v, p(n);
+
+    for(std::size_t k = 0; k + 2 < n; ++k) {
+        std::size_t m = n - k - 1;
+        v.resize(m);
+        for(std::size_t i = 0; i < m; ++i) {
+            v[i] = av(k + 1 + i, k);
+        }
+
+        d[k] = av(k, k);
+        beta[k] = make_reflection(v, e[k]);
+        for(std::size_t i = 0; i < m; ++i) {
+            av(k + 1 + i, k) = v[i];
+        }
+
+        if(beta[k] == T{}) {
+            continue;
+        }
+
+        /* p = beta * A22 * v, w = p - (beta / 2) * (p^T * v) * v, A22 -= v * w^T + w * v^T */
+        policy.parallel_for_tiles(m, 1u, tile_rows, 1u, [&](std::size_t row_begin, std::size_t row_end, std::size_t, std::size_t) {
+            for(std::size_t i = row_begin; i < row_end; ++i) {
+                p[i] = beta[k] * dot(&av(k + 1 + i, k + 1), v.data(), m);
+            }
+        });
+
+        T pv{};
+        for(std::size_t i = 0; i < m; ++i) {
+            pv += p[i] * v[i];
+        }
+        T factor = beta[k] * pv / T{2};
+        for(std::size_t i = 0; i < m; ++i) {
+            p[i] -= factor * v[i];
+        }
+
+        policy.parallel_for_tiles(m, 1u, tile_rows, 1u, [&](std::size_t row_begin, std::size_t row_end, std::size_t, std::size_t) {
+            for(std::size_t i = row_begin; i < row_end; ++i) {
+                rank2_update(&av(k + 1 + i, k + 1), v.data(), p.data(), m, v[i], p[i]);
+            }
+        });
+    }
+
+    if(n > 1) {
+        d[n - 2] = av(n - 2, n - 2);
+        e[n - 2] = av(n - 1, n - 2);
+    }
+    d[n - 1] = av(n - 1, n - 1);
+    e[n - 1] = T{};
+}
+
+/*  Q = H(0) * H(1) * ... * H(n - 3), blocks of reflections are applied from the last one:
+    Q(r0:, r0:) = (I - Y * S * Y^T) * Q(r0:, r0:), S is upper triangular */
+template<typename T>
+matrix_t<T> accumulate_reflections(const matrix_t<T>& a, const std::vector<T>& beta, const execution_policy_t& policy) {
+    std::size_t n = a.get_rows_number();
+    matrix_t<T> q = identity<T>(n);
+    std::size_t count = (n > 2) ? n - 2 : 0u;
+
+    for(std::size_t end = count; end > 0;) {
+        std::size_t begin = ((end - 1) / reflection_block) * reflection_block;
+        std::size_t b = end - begin, r0 = begin + 1, rows = n - r0;
+
+        /* yt - Y^T, reflection j starts from row j of Y */
+        matrix_t<T> yt(b, rows);
+        for(std::size_t j = 0; j < b; ++j) {
+            yt[j][j] = T{1};
+            for(std::size_t i = j + 1; i < rows; ++i) {
+                yt[j][i] = a[r0 + i][begin + j];
+            }
+        }
+
+        /* S(0:j, j) = -beta(j) * S(0:j, 0:j) * Y(:, 0:j)^T * y(j), stored with minus */
+        matrix_t<T> s(b, b);
+        std::vector<T> products(b);
+        for(std::size_t j = 0; j < b; ++j) {
+            for(std::size_t i = 0; i < j; ++i) {
+                products[i] = T{};
+                for(std::size_t r = j; r < rows; ++r) {
+                    products[i] += yt[i][r] * yt[j][r];
+                }
+            }
+
+            for(std::size_t i = 0; i < j; ++i) {
+                T sum{};
+                for(std::size_t l = i; l < j; ++l) {
+                    sum += s[i][l] * products[l];
+                }
+                s[i][j] = -beta[begin + j] * sum;
+            }
+            s[j][j] = -beta[begin + j];
+        }
+
+        matrix_view_t<T> qs = q.submatrix(r0, r0, rows, rows);
+        matrix_t<T> w = multiplication(std::as_const(yt).view(), qs.as_const(), policy);
+        matrix_t<T> sw = multiplication(s, w, policy);
+        gemm(std::as_const(yt).view().transposed(), std::as_const(sw).view(), qs, policy);
+
+        end = begin;
+    }
+
+    return q;
+}
+
+/* implicit QL on tridiagonal (d, e), d becomes eigenvalues, rotations are applied to rows of zt */
+template<typename T>
+void tridiagonal_ql(std::vector<T>& d, std::vector<T>& e, matrix_t<T>& zt, const execution_policy_t& policy) {
+    struct rotation_t {
+        std::size_t row;
+        T c, s;
+    };
+
+    std::size_t n = d.size();
+    const T eps = std::numeric_limits<T>::epsilon();
+    const std::size_t max_iterations = 60u;
+    matrix_view_t<T> zv = zt.view();
+    std::vector<rotation_t> rotations;
+    T f{}, norm{};
+
+    /* rotations don't depend on Z, so they are collected from several sweeps and applied by narrow
+       column tiles, which stay in cache, instead of streaming all Z^T through memory on every sweep */
+    auto apply_rotations = [&] {
+        policy.parallel_for_tiles(1u, n, 1u, rotation_tile_cols, [&](std::size_t, std::size_t, std::size_t col_begin, std::size_t col_end) {
+            for(const auto& rotation : rotations) {
+                rotate_rows(&zv(rotation.row, col_begin), &zv(rotation.row + 1, col_begin), col_end - col_begin, rotation.c, rotation.s);
+            }
+        });
+        rotations.clear();
+    };
+
+    for(std::size_t l = 0; l < n; ++l) {
+        norm = std::max(norm, std::abs(d[l]) + std::abs(e[l]));
+        std::size_t m = l;
+        while((m + 1 < n) && (std::abs(e[m]) > eps * norm)) {
+            ++m;
+        }
+
+        for(std::size_t iteration = 0; m > l; ++iteration) {
+            if(iteration == max_iterations) {
+                throw std::runtime_error("symmetric_eigen: QL iterations don't converge");
+            }
+
+            /* wilkinson shift */
+            T g = d[l];
+            T p = (d[l + 1] - g) / (T{2} * e[l]);
+            T r = std::hypot(p, T{1});
+            r = (p < T{}) ? -r : r;
+            d[l] = e[l] / (p + r);
+            d[l + 1] = e[l] * (p + r);
+            T dl1 = d[l + 1];
+            T h = g - d[l];
+            for(std::size_t i = l + 2; i < n; ++i) {
+                d[i] -= h;
+            }
+            f += h;
+
+            p = d[m];
+            T c = T{1}, c2 = c, c3 = c, s{}, s2{};
+            T el1 = e[l + 1];
+            for(std::size_t i = m; i-- > l;) {
+                c3 = c2;
+                c2 = c;
+                s2 = s;
+                g = c * e[i];
+                h = c * p;
+                r = std::hypot(p, e[i]);
+                e[i + 1] = s * r;
+                s = e[i] / r;
+                c = p / r;
+                p = c * d[i] - s * g;
+                d[i + 1] = h + s * (c * g + s * d[i]);
+                rotations.push_back({i, c, s});
+            }
+            p = -s * s2 * c3 * el1 * e[l] / dl1;
+            e[l] = s * p;
+            d[l] = c * p;
+
+            if(rotations.size() >= rotation_batch * n) {
+                apply_rotations();
+            }
+
+            if(std::abs(e[l]) <= eps * norm) {
+                break;
+            }
+        }
+
+        d[l] += f;
+        e[l] = T{};
+    }
+
+    apply_rotations();
+}
+
+
+/* A - m * n, m >= n. Columns of A are rows of w, columns of V are rows of vt */
+template<typename T>
+svd_t<T> jacobi_svd(const_matrix_view_t<T> a, const execution_policy_t& policy) {
+    std::size_t m = a.get_rows_number(), n = a.get_cols_number();
+    if(!n) {
+        return {matrix_t<T>(m, 0u), {}, matrix_t<T>()};
+    }
+
+    matrix_t<T> w(a.transposed()), vt = identity<T>(n);
+    matrix_view_t<T> wv = w.view(), vv = vt.view();
+
+    const T tolerance = std::numeric_limits<T>::epsilon() * std::sqrt(static_cast<T>(std::max<std::size_t>(m, 1u)));
+    const std::size_t max_sweeps = 64u;
+    std::vector<T> norms(n);
+    T negligible{};
+
+    /*  rotation of rows i < j, returns false if they are orthogonal already.
+        Rows below rounding level of the longest row (negligible) are not rotated: they are noise of
+        previous rotations, which can stay correlated with long rows (e.g. with fma) forever */
+    auto rotate = [&](std::size_t i, std::size_t j) {
+        T* wi = &wv(i, 0);
+        T* wj = &wv(j, 0);
+        T alpha = norms[i], beta = norms[j];
+        if(!(std::min(alpha, beta) > negligible)) {
+            return false;
+        }
+
+        T gamma = dot(wi, wj, m);
+        if(!(std::abs(gamma) > tolerance * std::sqrt(alpha * beta))) {
+            return false;
+        }
+
+        T zeta = (beta - alpha) / (T{2} * gamma);
+        T t = ((zeta < T{}) ? T{-1} : T{1}) / (std::abs(zeta) + std::sqrt(T{1} + zeta * zeta));
+        T c = T{1} / std::sqrt(T{1} + t * t), s = c * t;
+        rotate_rows(wi, wj, m, c, s);
+        rotate_rows(&vv(i, 0), &vv(j, 0), n, c, s);
+        norms[i] = alpha - t * gamma;
+        norms[j] = beta + t * gamma;
+        return true;
+    };
+
+    /*  rows are split into blocks, 2 blocks of rows of w and vt fit in svd_block_bytes.
+        Sweep: pairs inside every block, then pairs of blocks by round-robin ordering
+        (round pairs order[i] with order[size - 1 - i], index blocks is empty place for odd blocks).
+        Pairs of rows of 2 blocks are rotated in cache, different pairs of blocks - in parallel */
+    std::size_t block = std::max<std::size_t>(svd_block_bytes / (2u * (m + n) * sizeof(T)), 1u);
+    std::size_t blocks = (n + block - 1) / block;
+    std::size_t size = blocks + (blocks % 2u);
+    std::vector<std::size_t> order(size);
+    std::iota(order.begin(), order.end(), 0u);
+    std::vector<char> rotated(std::max(blocks, size / 2u));
+
+    for(std::size_t sweep = 0;; ++sweep) {
+        if(sweep == max_sweeps) {
+            throw std::runtime_error("svd: jacobi sweeps don't converge");
+        }
+
+        for(std::size_t i = 0; i < n; ++i) {
+            norms[i] = dot(&wv(i, 0), &wv(i, 0), m);
+        }
+        negligible = tolerance * tolerance * *std::max_element(norms.begin(), norms.end());
+
+        policy.parallel_for(blocks, [&](std::size_t b) {
+            rotated[b] = false;
+            for(std::size_t i = b * block, end = std::min(i + block, n); i < end; ++i) {
+                for(std::size_t j = i + 1; j < end; ++j) {
+                    rotated[b] |= rotate(i, j);
+                }
+            }
+        });
+        bool converged = std::none_of(rotated.begin(), rotated.begin() + blocks, [](char r) {return r;});
+
+        for(std::size_t round = 0; round + 1 < size; ++round) {
+            policy.parallel_for(size / 2u, [&](std::size_t idx) {
+                std::size_t lhs = std::min(order[idx], order[size - 1 - idx]);
+                std::size_t rhs = std::max(order[idx], order[size - 1 - idx]);
+                rotated[idx] = false;
+                if(rhs == blocks) {
+                    return;
+                }
+
+                for(std::size_t i = lhs * block, i_end = std::min(i + block, n); i < i_end; ++i) {
+                    for(std::size_t j = rhs * block, j_end = std::min(j + block, n); j < j_end; ++j) {
+                        rotated[idx] |= rotate(i, j);
+                    }
+                }
+            });
+
+            converged = converged && std::none_of(rotated.begin(), rotated.begin() + size / 2u, [](char r) {return r;});
+            std::rotate(order.begin() + 1, order.end() - 1, order.end());
+        }
+
+        if(converged) {
+            break;
+        }
+    }
+
+    std::vector<std::size_t> idx(n);
+    std::iota(idx.begin(), idx.end(), 0u);
+    std::vector<T> sigma(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        sigma[i] = std::sqrt(dot(&wv(i, 0), &wv(i, 0), m));
+    }
+    std::stable_sort(idx.begin(), idx.end(), [&](std::size_t lhs, std::size_t rhs) {return sigma[lhs] > sigma[rhs];});
+
+    svd_t<T> ret{matrix_t<T>(m, n), std::vector<T>(n), matrix_t<T>(n, n)};
+    for(std::size_t r = 0; r < n; ++r) {
+        std::size_t i = idx[r];
+        ret.values[r] = sigma[i];
+        T scale = (sigma[i] > T{}) ? T{1} / sigma[i] : T{};
+        for(std::size_t k = 0; k < m; ++k) {
+            ret.u[k][r] = wv(i, k) * scale;
+        }
+        for(std::size_t k = 0; k < n; ++k) {
+            ret.v[k][r] = vv(i, k);
+        }
+    }
+
+    return ret;
+}
+
+} /* namespace detail */
+
+template<typename T>
+symmetric_eigen_t<T> symmetric_eigen(const_matrix_view_t<T> a, const execution_policy_t& policy /* = sequential_policy */) {
+    static_assert(std::is_floating_point_v<T>, "symmetric_eigen: only floating point types");
+
+    std::size_t n = a.get_rows_number();
+    if(a.get_cols_number() != n) {
+        throw std::runtime_error("symmetric_eigen: matrix must be square");
+    }
+
+    if(!n) {
+        return {};
+    }
+
+    /* symmetric copy of lower triangle */
+    matrix_t<T> work(n, n);
+    for(std::size_t i = 0; i < n; ++i) {
+        auto row = a[i];
+        for(std::size_t j = 0; j <= i; ++j) {
+            work[i][j] = row[j];
+            work[j][i] = row[j];
+        }
+    }
+
+    std::vector<T> d(n), e(n), beta(n);
+    detail::tridiagonalize(work, d, e, beta, policy);
+
+    matrix_t<T> zt = detail::identity<T>(n);
+    detail::tridiagonal_ql(d, e, zt, policy);
+
+    std::vector<std::size_t> idx(n);
+    std::iota(idx.begin(), idx.end(), 0u);
+    std::stable_sort(idx.begin(), idx.end(), [&](std::size_t lhs, std::size_t rhs) {return d[lhs] < d[rhs];});
+
+    symmetric_eigen_t<T> ret;
+    ret.values.resize(n);
+    matrix_t<T> sorted(n, n);
+    for(std::size_t r = 0; r < n; ++r) {
+        ret.values[r] = d[idx[r]];
+        copy_view(std::as_const(zt).submatrix(idx[r], 0u, 1u, n), sorted.submatrix(r, 0u, 1u, n));
+    }
+
+    matrix_t<T> q = detail::accumulate_reflections(work, beta, policy);
+    ret.vectors = multiplication(std::as_const(q).view(), std::as_const(sorted).view().transposed(), policy);
+    return ret;
+}
+
+template<typename T>
+svd_t<T> svd(const_matrix_view_t<T> a, const execution_policy_t& policy /* = sequential_policy */) {
+    static_assert(std::is_floating_point_v<T>, "svd: only floating point types");
+
+    if(a.get_rows_number() >= a.get_cols_number()) {
+        return detail::jacobi_svd(a, policy);
+    }
+
+    /* A^T = U * S * V^T => A = V * S * U^T */
+    svd_t<T> ret = detail::jacobi_svd(a.transposed(), policy);
+    std::swap(ret.u, ret.v);
+    return ret;
+}
+
+} /* namespace matrix */
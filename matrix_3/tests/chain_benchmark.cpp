@@ -0,0 +1,63 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../matrix/matrix_chain.hpp"
+
+/*  ordering of chain of random matrices: incremental dp (push), wavefront dp on thread pool and O(n) heuristic
+    usage: ./chain_benchmark [threads] [count ...] */
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t threads = (argc > 1) ? std::stoull(argv[1]) : 4u;
+    std::vector<std::size_t> counts;
+    for(int i = 2; i < argc; ++i) {
+        counts.push_back(std::stoull(argv[i]));
+    }
+
+    if(counts.empty()) {
+        counts = {250u, 500u, 1000u, 2000u};
+    }
+
+    matrix::thread_pool_t pool(threads);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> dis(1u, 1000u);
+    for(std::size_t count : counts) {
+        std::vector<std::size_t> sizes(count + 1);
+        for(auto&& size : sizes) {
+            size = dis(gen);
+        }
+
+        matrix::Imatrix_chain_t chain;
+        double push_time = measure([&]() {
+            for(std::size_t i = 0; i < count; ++i) {
+                chain.push(sizes[i], sizes[i + 1]);
+            }
+        });
+
+        auto flops = [&sizes](std::size_t i, std::size_t k, std::size_t j) {return sizes[i] * sizes[k + 1] * sizes[j + 1];};
+        matrix::chain_order_t<std::size_t> sequential, parallel;
+        double sequential_time = measure([&]() {sequential = matrix::optimal_chain_order(count, flops);});
+        double parallel_time = measure([&]() {parallel = matrix::optimal_chain_order(count, flops, matrix::execution_policy_t(pool));});
+
+        std::vector<std::size_t> heuristic;
+        double heuristic_time = measure([&]() {heuristic = chain.get_heuristic_order();});
+        double ratio = static_cast<double>(chain.get_order_oper(heuristic)) / chain.get_optimal_order_oper();
+
+        bool success = (sequential.cost == chain.get_optimal_order_oper()) && (parallel.order == sequential.order);
+        std::cout << std::setw(6) << count << " matrices: push " << std::fixed << std::setprecision(3) << push_time << " s, wavefront "
+                  << sequential_time << " s, wavefront x" << threads << " " << parallel_time << " s, heuristic " << std::setprecision(5)
+                  << heuristic_time << " s (cost x" << std::setprecision(3) << ratio << ")" << (success ? " SUCCESS" : " FAILED")
+                  << std::defaultfloat << std::endl;
+    }
+}
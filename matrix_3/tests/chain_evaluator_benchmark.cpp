@@ -0,0 +1,86 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../matrix/chain_evaluator.hpp"
+
+/*  chain of random matrices: optimal order against naive left to right one,
+    then orders of calibrated time model and of flops with memory cap (between the smallest peak and peak of optimal order)
+    usage: ./chain_evaluator_benchmark [threads] [count] [max_size]
+
+    check: results of all orders must be equal */
+
+void report(const std::string& name, const matrix::chain_stats_t& stats) {
+    std::cout << std::setw(14) << name << ": " << std::fixed << std::setprecision(3) << stats.seconds << " s, "
+              << std::setprecision(2) << stats.flops * 1e-9 << " GFlop, " << stats.flops * 1e-9 / stats.seconds << " GFlop/s, peak temporaries "
+              << std::setprecision(1) << stats.peak_bytes / (1024.0 * 1024.0) << " MiB" << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t threads = (argc > 1) ? std::stoull(argv[1]) : 4u;
+    std::size_t count = (argc > 2) ? std::stoull(argv[2]) : 12u;
+    std::size_t max_size = (argc > 3) ? std::stoull(argv[3]) : 1200u;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> size(16u, max_size);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::vector<std::size_t> sizes(count + 1);
+    for(auto&& elem : sizes) {
+        elem = size(gen);
+    }
+
+    std::vector<matrix::matrix_t<double>> operands;
+    std::vector<const matrix::matrix_t<double>*> chain;
+    operands.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        operands.emplace_back(sizes[i], sizes[i + 1]);
+        for(std::size_t r = 0; r < sizes[i]; ++r) {
+            for(std::size_t c = 0; c < sizes[i + 1]; ++c) {
+                operands.back()[r][c] = dis(gen) / sizes[i];
+            }
+        }
+        chain.push_back(&operands.back());
+    }
+
+    matrix::thread_pool_t pool(threads);
+    matrix::chain_evaluator_t<double> evaluator{matrix::execution_policy_t(pool)};
+    std::cout << count << " matrices, sizes 16 .. " << max_size << ", " << threads << " threads" << std::endl;
+
+    matrix::matrix_t<double> naive = evaluator.evaluate_left_to_right(chain);
+    report("left to right", evaluator.get_stats());
+
+    matrix::matrix_t<double> optimal = evaluator.evaluate(chain);
+    report("optimal", evaluator.get_stats());
+
+    /* buffers of the first evaluations are reused */
+    evaluator.evaluate(chain);
+    report("optimal again", evaluator.get_stats());
+
+    matrix::gemm_timing_t timing = matrix::calibrate_gemm<double>(matrix::execution_policy_t(pool));
+    std::cout << "gemm timing: overhead " << timing.overhead << " s, " << 1e-9 / timing.per_flop << " GFlop/s, "
+              << ((timing.per_byte > 0.0) ? 1e-9 / timing.per_byte : 0.0) << " GB/s" << std::endl;
+
+    matrix::time_model_t time_model(sizes, timing);
+    std::cout << std::fixed << std::setprecision(4) << "predicted: optimal " << matrix::chain_order_value(count, time_model, matrix::optimal_chain_order(count, matrix::flops_model_t(sizes)).order)
+              << " s, time model " << matrix::optimal_chain_order(count, time_model).cost << " s" << std::defaultfloat << std::endl;
+
+    matrix::matrix_t<double> timed = evaluator.evaluate(chain, matrix::optimal_chain_order(count, time_model).order);
+    report("time model", evaluator.get_stats());
+
+    matrix::memory_model_t memory(sizes, sizeof(double));
+    std::size_t budget = (matrix::chain_order_value(count, memory, matrix::optimal_chain_order(count, matrix::flops_model_t(sizes)).order)
+                          + matrix::optimal_chain_order(count, memory).cost) / 2;
+    auto capped_order = matrix::optimal_chain_order(count, matrix::flops_model_t(sizes), memory, budget);
+    bool success = (naive == optimal) && (timed == optimal);
+    if(capped_order) {
+        matrix::matrix_t<double> capped = evaluator.evaluate(chain, capped_order->order);
+        report("memory cap", evaluator.get_stats());
+        success = success && (capped == optimal) && (evaluator.get_stats().peak_bytes <= budget);
+    } else {
+        std::cout << std::setw(14) << "memory cap" << ": no order within " << budget << " bytes" << std::endl;
+    }
+
+    std::cout << (success ? "SUCCESS" : "FAILED") << std::endl;
+}
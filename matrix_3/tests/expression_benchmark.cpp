@@ -0,0 +1,84 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+
+#include "../matrix/matrix.hpp"
+
+/*  fused expression evaluation against temporary per operator
+    usage: ./expression_benchmark [size] [repeats]
+
+    bytes moved is a model: every matrix read or written once is size * size * sizeof(double),
+    new temporary is also zero filled by its constructor (one more write).
+    For product only traffic of size * size matrices out of gemm is counted */
+
+using matrix_t = matrix::matrix_t<double>;
+
+matrix_t random_matrix(std::size_t size, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    matrix_t ret(size, size);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            ret[i][j] = dis(gen);
+        }
+    }
+
+    return ret;
+}
+
+template<typename F>
+double measure(std::size_t repeats, F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for(std::size_t i = 0; i < repeats; ++i) {
+        func();
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count() / repeats;
+}
+
+void print_result(const std::string& name, double matrices_moved, double matrix_bytes, double time, bool success) {
+    double bytes = matrices_moved * matrix_bytes;
+    std::cout << std::setw(24) << name << ": " << std::fixed << std::setprecision(1) << std::setw(6) << matrices_moved << " matrices, "
+              << std::setw(8) << bytes / (1024.0 * 1024.0) << " MB moved, " << std::setprecision(4) << time << " s, "
+              << std::setprecision(2) << bytes / time / 1e9 << " GB/s " << (success ? "SUCCESS" : "FAILED") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t size = (argc > 1) ? std::stoull(argv[1]) : 2048u;
+    std::size_t repeats = (argc > 2) ? std::stoull(argv[2]) : 10u;
+    double matrix_bytes = static_cast<double>(size * size * sizeof(double));
+
+    std::mt19937 gen(42);
+    matrix_t a = random_matrix(size, gen);
+    matrix_t b = random_matrix(size, gen);
+    matrix_t d = random_matrix(size, gen);
+    double c = 0.5;
+
+    /* every operator evaluated separately: b * c (fill, read, write), a + t (fill, 2 reads, write), t - d (the same) */
+    auto separate = [&]() {
+        matrix_t scaled = matrix::evaluate(b * c);
+        matrix_t sum = matrix::evaluate(a + scaled);
+        return matrix::evaluate(sum - d);
+    };
+    double before_time = measure(repeats, separate);
+
+    /* one loop: 3 reads, 1 write into existing result */
+    matrix_t fused(size, size);
+    double after_time = measure(repeats, [&]() {fused = a + b * c - d;});
+
+    print_result("A + B * c - D before", 11.0, matrix_bytes, before_time, true);
+    print_result("A + B * c - D after", 4.0, matrix_bytes, after_time, separate() == fused);
+
+    /* multiplication writes zero filled temporary, addition reads it and d into new matrix */
+    auto separate_product = [&]() {return matrix::addition(d, matrix::multiplication(a, b));};
+    double product_before_time = measure(1u, separate_product);
+
+    /* d is copied into result, gemm reads and writes it once */
+    matrix_t fused_product(size, size);
+    double product_after_time = measure(1u, [&]() {fused_product = d + a * b;});
+
+    print_result("D + A * B before", 6.0, matrix_bytes, product_before_time, true);
+    print_result("D + A * B after", 4.0, matrix_bytes, product_after_time, separate_product() == fused_product);
+}
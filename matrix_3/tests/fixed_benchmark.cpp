@@ -0,0 +1,125 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../matrix/fixed_matrix.hpp"
+
+/*  determinant and inverse of many small matrices: matrix_t (LU on heap), fixed_matrix_t one by one
+    and batch in structure of arrays layout (simd lanes, chunks on thread pool)
+    usage: ./fixed_benchmark [count] [threads]
+
+    matrix_t is measured on tenth of matrices, as it allocates on every call
+    check: sums of fixed and batch results must be equal */
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+void report(const std::string& name, std::size_t count, double seconds, double check) {
+    std::cout << std::setw(16) << name << ": " << std::fixed << std::setprecision(4) << seconds << " s, "
+              << std::setprecision(1) << count * 1e-6 / seconds << " M matrices/s, check " << std::setprecision(6) << check
+              << std::defaultfloat << std::endl;
+}
+
+template<std::size_t N>
+void run(std::size_t count, std::size_t threads) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::vector<matrix::fixed_matrix_t<double, N, N>> fixed(count);
+    matrix::fixed_batch_t<double, N, N> batch(count);
+    for(std::size_t idx = 0; idx < count; ++idx) {
+        for(std::size_t i = 0; i < N * N; ++i) {
+            fixed[idx].data()[i] = dis(gen);
+        }
+        batch.set(idx, fixed[idx]);
+    }
+
+    std::cout << N << " * " << N << ", " << count << " matrices" << std::endl;
+
+    /* matrix_t allocates, so it's measured on part of matrices */
+    std::size_t dynamic_count = count / 10;
+    std::vector<matrix::matrix_t<double>> dynamic;
+    for(std::size_t idx = 0; idx < dynamic_count; ++idx) {
+        dynamic.push_back(fixed[idx].to_matrix());
+    }
+
+    double check = 0.0;
+    double seconds = measure([&] {
+        for(auto&& m : dynamic) {
+            check += m.det();
+        }
+    });
+    report("matrix_t det", dynamic_count, seconds, check);
+
+    check = 0.0;
+    seconds = measure([&] {
+        for(auto&& m : fixed) {
+            check += matrix::det(m);
+        }
+    });
+    report("fixed det", count, seconds, check);
+
+    std::vector<double> dets;
+    seconds = measure([&] {
+        dets = matrix::batch_det(batch);
+    });
+    check = 0.0;
+    for(double d : dets) {
+        check += d;
+    }
+    report("batch det", count, seconds, check);
+
+    matrix::thread_pool_t pool(threads);
+    seconds = measure([&] {
+        dets = matrix::batch_det(batch, matrix::execution_policy_t(pool));
+    });
+    report("batch det (mt)", count, seconds, check);
+
+    check = 0.0;
+    seconds = measure([&] {
+        for(auto&& m : dynamic) {
+            check += matrix::inverse(m)[0][0];
+        }
+    });
+    report("matrix_t inverse", dynamic_count, seconds, check);
+
+    std::vector<matrix::fixed_matrix_t<double, N, N>> fixed_inverses;
+    seconds = measure([&] {
+        fixed_inverses.resize(count);
+        for(std::size_t idx = 0; idx < count; ++idx) {
+            fixed_inverses[idx] = matrix::inverse(fixed[idx]);
+        }
+    });
+    check = 0.0;
+    for(auto&& m : fixed_inverses) {
+        check += m[0][0];
+    }
+    report("fixed inverse", count, seconds, check);
+
+    matrix::fixed_batch_t<double, N, N> inverses;
+    seconds = measure([&] {
+        inverses = matrix::batch_inverse(batch);
+    });
+    check = 0.0;
+    for(std::size_t idx = 0; idx < count; ++idx) {
+        check += inverses.element(0, 0)[idx];
+    }
+    report("batch inverse", count, seconds, check);
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = (argc > 1) ? std::stoull(argv[1]) : 1000000u;
+    std::size_t threads = (argc > 2) ? std::stoull(argv[2]) : 4u;
+
+    run<3>(count, threads);
+    run<4>(count, threads);
+    return 0;
+}
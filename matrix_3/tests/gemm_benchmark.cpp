@@ -0,0 +1,86 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../matrix/matrix.hpp"
+#include "../matrix/matrix_chain.hpp"
+
+/*  GFLOP/s of matrix::gemm for square matrices
+    usage: ./gemm_benchmark [max size] [naive check max size]
+    sizes go from 64 up to max size (4096 by default) with step x2,
+    up to naive check max size result is compared with naive triple loop.
+    At the end coefficients of time model of matrix chain (see calibrate_gemm) are printed */
+
+template<typename T>
+std::vector<T> random_vector(std::size_t size, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::vector<T> ret(size);
+    for(auto&& elem : ret) {
+        elem = static_cast<T>(dis(gen));
+    }
+
+    return ret;
+}
+
+template<typename T>
+long double max_naive_error(std::size_t size, const std::vector<T>& a, const std::vector<T>& b, const std::vector<T>& c) {
+    long double ret = 0.0;
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            long double elem = 0.0;
+            for(std::size_t k = 0; k < size; ++k) {
+                elem += static_cast<long double>(a[i * size + k]) * b[k * size + j];
+            }
+            ret = std::max(ret, std::abs(elem - c[i * size + j]));
+        }
+    }
+
+    return ret;
+}
+
+template<typename T>
+void run_benchmark(const std::string& name, std::size_t max_size, std::size_t check_size, std::mt19937& gen) {
+    for(std::size_t size = 64u; size <= max_size; size *= 2u) {
+        std::vector<T> a = random_vector<T>(size * size, gen);
+        std::vector<T> b = random_vector<T>(size * size, gen);
+        std::vector<T> c(size * size);
+
+        /* small sizes are repeated to get measurable time */
+        std::size_t repeats = std::max<std::size_t>(1u, (256u * 256u * 256u) / (size * size * size));
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for(std::size_t i = 0; i < repeats; ++i) {
+            matrix::gemm(size, size, size, a.data(), size, b.data(), size, c.data(), size);
+        }
+        auto finish = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(finish - start).count() / repeats;
+
+        std::cout << std::setw(12) << name << std::setw(6) << size << ": "
+                  << std::setw(8) << std::fixed << std::setprecision(2) << 2.0 * size * size * size / seconds * 1e-9 << " GFLOP/s";
+
+        if(size <= check_size) {
+            std::fill(c.begin(), c.end(), T{});
+            matrix::gemm(size, size, size, a.data(), size, b.data(), size, c.data(), size);
+            std::cout << ", max error " << std::scientific << std::setprecision(2) << max_naive_error(size, a, b, c);
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_size = (argc > 1) ? std::stoull(argv[1]) : 4096u;
+    std::size_t check_size = (argc > 2) ? std::stoull(argv[2]) : 512u;
+
+    std::mt19937 gen(42);
+    run_benchmark<float>("float", max_size, check_size, gen);
+    run_benchmark<double>("double", max_size, check_size, gen);
+    run_benchmark<long double>("long double", max_size, check_size, gen);
+
+    for(auto timing : {matrix::calibrate_gemm<float>(), matrix::calibrate_gemm<double>()}) {
+        std::cout << "time model, " << timing.element_size << " bytes: overhead " << std::scientific << std::setprecision(2) << timing.overhead
+                  << " s, per flop " << timing.per_flop << " s, per byte " << timing.per_byte << " s" << std::defaultfloat << std::endl;
+    }
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdio>
+
+#include "../matrix/matrix_io.hpp"
+
+/*  loading of size * size matrix: text by operator>>, text by read_text, binary file by read_binary and mapped view
+    usage: ./io_benchmark [size] [directory]
+
+    check: sums of elements must be equal */
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+double sum(const matrix::matrix_t<double>& m) {
+    double ret = 0.0;
+    for(std::size_t i = 0; i < m.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < m.get_cols_number(); ++j) {
+            ret += m[i][j];
+        }
+    }
+
+    return ret;
+}
+
+void report(const std::string& name, double seconds, std::size_t bytes, double check) {
+    std::cout << std::setw(16) << name << ": " << std::fixed << std::setprecision(3) << seconds << " s, "
+              << std::setprecision(1) << bytes / (1024.0 * 1024.0) / seconds << " MiB/s, check " << std::setprecision(6) << check
+              << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t size = (argc > 1) ? std::stoull(argv[1]) : 2000u;
+    std::string directory = (argc > 2) ? argv[2] : ".";
+    std::string text_path = directory + "/io_benchmark.txt", binary_path = directory + "/io_benchmark.bin";
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    matrix::matrix_t<double> m(size, size);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            m[i][j] = dis(gen);
+        }
+    }
+
+    std::cout << size << " * " << size << " matrix, check " << std::setprecision(6) << std::fixed << sum(m) << std::defaultfloat << std::endl;
+
+    double seconds = measure([&] {
+        std::ofstream out(text_path);
+        out << std::setprecision(17) << m;
+    });
+    std::size_t text_bytes = std::ifstream(text_path, std::ios::ate).tellg();
+    report("operator<<", seconds, text_bytes, sum(m));
+
+    seconds = measure([&] {
+        std::ofstream out(text_path);
+        matrix::write_text(out, m);
+    });
+    text_bytes = std::ifstream(text_path, std::ios::ate).tellg();
+    report("write_text", seconds, text_bytes, sum(m));
+
+    seconds = measure([&] {
+        matrix::write_binary(binary_path, m);
+    });
+    std::size_t binary_bytes = std::ifstream(binary_path, std::ios::ate).tellg();
+    report("write_binary", seconds, binary_bytes, sum(m));
+
+    matrix::matrix_t<double> read(size, size);
+    seconds = measure([&] {
+        std::ifstream in(text_path);
+        in >> read;
+    });
+    report("operator>>", seconds, text_bytes, sum(read));
+
+    read = matrix::matrix_t<double>(size, size);
+    seconds = measure([&] {
+        std::ifstream in(text_path);
+        matrix::read_text(in, read);
+    });
+    report("read_text", seconds, text_bytes, sum(read));
+
+    seconds = measure([&] {
+        read = matrix::read_binary<double>(binary_path);
+    });
+    report("read_binary", seconds, binary_bytes, sum(read));
+
+    /* mapping itself doesn't read elements, so sum is part of measurement */
+    double check = 0.0;
+    seconds = measure([&] {
+        matrix::mapped_matrix_t<double> mapped(binary_path);
+        for(std::size_t i = 0; i < mapped.get_elements_number(); ++i) {
+            check += mapped.data()[i];
+        }
+    });
+    report("mapped + sum", seconds, binary_bytes, check);
+
+    std::remove(text_path.c_str());
+    std::remove(binary_path.c_str());
+    return 0;
+}
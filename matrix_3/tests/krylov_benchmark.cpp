@@ -0,0 +1,78 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../matrix/krylov.hpp"
+#include "../matrix/sparse_cholesky.hpp"
+
+/*  krylov solvers with preconditioners against sparse cholesky on poisson equation of side * side grid
+    usage: ./krylov_benchmark [side] [threads]
+
+    time includes construction of preconditioner */
+
+using csr_t = matrix::csr_matrix_t<double>;
+
+csr_t poisson(std::size_t side) {
+    std::vector<matrix::triplet_t<double>> triplets;
+    for(std::size_t i = 0; i < side; ++i) {
+        for(std::size_t j = 0; j < side; ++j) {
+            std::size_t v = i * side + j;
+            triplets.push_back({v, v, 4.0});
+            if(j + 1 < side) {
+                triplets.push_back({v, v + 1, -1.0});
+                triplets.push_back({v + 1, v, -1.0});
+            }
+
+            if(i + 1 < side) {
+                triplets.push_back({v, v + side, -1.0});
+                triplets.push_back({v + side, v, -1.0});
+            }
+        }
+    }
+
+    return csr_t(side * side, side * side, triplets);
+}
+
+template<typename F>
+void measure(const std::string& name, F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    matrix::krylov_result_t<double> result = func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    std::cout << std::setw(20) << name << ": " << std::fixed << std::setprecision(3) << std::chrono::duration<double>(finish - start).count() << " s, "
+              << std::setw(5) << result.iterations << " iterations, residual " << std::scientific << std::setprecision(2) << result.residual
+              << (result.converged ? " SUCCESS" : " FAILED") << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t side = (argc > 1) ? std::stoull(argv[1]) : 300u;
+    std::size_t threads = (argc > 2) ? std::stoull(argv[2]) : 1u;
+
+    csr_t a = poisson(side);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::vector<double> b(a.get_rows_number());
+    for(auto&& elem : b) {
+        elem = dis(gen);
+    }
+
+    matrix::thread_pool_t pool(threads);
+    matrix::execution_policy_t policy(pool);
+    matrix::krylov_options_t options{1e-8, 10000u, 30u};
+    std::cout << "unknowns: " << a.get_rows_number() << ", tolerance: " << options.tolerance << std::endl;
+
+    measure("cg", [&]() {return matrix::conjugate_gradient(a, b, matrix::identity_preconditioner_t<double>(), options, policy);});
+    measure("cg + jacobi", [&]() {return matrix::conjugate_gradient(a, b, matrix::jacobi_preconditioner_t<double>(a), options, policy);});
+    measure("cg + ic0", [&]() {return matrix::conjugate_gradient(a, b, matrix::ic0_preconditioner_t<double>(a), options, policy);});
+    measure("bicgstab + ilu0", [&]() {return matrix::bicgstab(a, b, matrix::ilu0_preconditioner_t<double>(a), options, policy);});
+    measure("gmres(30) + ilu0", [&]() {return matrix::gmres(a, b, matrix::ilu0_preconditioner_t<double>(a), options, policy);});
+
+    auto start = std::chrono::high_resolution_clock::now();
+    matrix::sparse_cholesky_t<double> cholesky{matrix::csc_matrix_t<double>(a)};
+    std::vector<double> x = cholesky.solve(b);
+    auto finish = std::chrono::high_resolution_clock::now();
+    std::cout << std::setw(20) << "sparse cholesky" << ": " << std::fixed << std::setprecision(3)
+              << std::chrono::duration<double>(finish - start).count() << " s" << std::endl;
+}
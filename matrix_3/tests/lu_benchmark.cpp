@@ -0,0 +1,98 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "../matrix/matrix.hpp"
+
+/*  blocked LU against column by column gaussian elimination (previous det implementation)
+    usage: ./lu_benchmark [max size]
+    sizes go from 250 up to max size (2000 by default) with step x2 */
+
+using matrix_t = matrix::matrix_t<double>;
+
+matrix_t random_matrix(std::size_t size, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    matrix_t ret(size, size);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            ret[i][j] = dis(gen);
+        }
+    }
+
+    return ret;
+}
+
+/*  elimination with partial pivoting through proxy_row_t, as det() did before,
+    return log10 of |det|, because det of big random matrix overflows double */
+long double scalar_log_det(matrix_t copy) {
+    long double ret = 0.0;
+    std::size_t size = copy.get_rows_number();
+
+    for(std::size_t k = 0; k < size; ++k) {
+        std::size_t max_elem = copy.max_abs_col_elem(k, k, size);
+        if(copy[max_elem][k] == 0) {
+            return -INFINITY;
+        }
+
+        if(max_elem != k) {
+            copy.swap_rows(max_elem, k);
+        }
+
+        for(std::size_t i = k + 1; i < size; ++i) {
+            double f = copy[i][k] / copy[k][k];
+            copy[i][k] = 0.0;
+            for (std::size_t j = k + 1; j < size; ++j) {
+                copy[i][j] = copy[i][j] - f * copy[k][j];
+            }
+        }
+
+        ret += std::log10(std::abs(copy[k][k]));
+    }
+
+    return ret;
+}
+
+long double lu_log_det(const matrix::lu_decomposition_t<double>& lu) {
+    long double ret = 0.0;
+    for(std::size_t i = 0; i < lu.size(); ++i) {
+        ret += std::log10(std::abs(lu.get_lu()[i][i]));
+    }
+
+    return ret;
+}
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_size = (argc > 1) ? std::stoull(argv[1]) : 2000u;
+    std::mt19937 gen(42);
+
+    for(std::size_t size = 250u; size <= max_size; size *= 2u) {
+        matrix_t m = random_matrix(size, gen);
+        matrix_t rhs = random_matrix(size, gen);
+        rhs.resize(size, 1);
+
+        long double scalar = 0.0;
+        double scalar_time = measure([&]() {scalar = scalar_log_det(m);});
+        double lu_time = measure([&]() {matrix::lu_decomposition_t<double>(m).det();});
+
+        matrix::lu_decomposition_t<double> lu(m);
+        long double blocked = lu_log_det(lu);
+        double solve_time = measure([&]() {lu.solve(rhs);});
+        double inverse_time = measure([&]() {lu.inverse();});
+
+        std::cout << std::setw(5) << size << ": scalar det " << std::fixed << std::setprecision(4) << scalar_time
+                  << " s, lu det " << lu_time << " s (x" << std::setprecision(1) << scalar_time / lu_time << ")"
+                  << std::setprecision(4) << ", solve " << solve_time << " s, inverse " << inverse_time << " s, "
+                  << "log10|det| difference " << std::scientific << std::setprecision(2) << std::abs(scalar - blocked)
+                  << std::defaultfloat << std::endl;
+    }
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <functional>
+
+#include "../matrix/matrix.hpp"
+
+/*  scaling of parallel matrix operations
+    usage: ./parallel_benchmark [size] [max threads]
+    threads count goes from 1 up to max threads (all cores by default) with step x2,
+    efficiency = speedup / threads, result is compared with sequential one bitwise */
+
+using matrix_t = matrix::matrix_t<double>;
+using operation_t = std::function<matrix_t(const matrix::execution_policy_t&)>;
+
+matrix_t random_matrix(std::size_t size, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    matrix_t ret(size, size);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            ret[i][j] = dis(gen);
+        }
+    }
+
+    return ret;
+}
+
+bool identical(const matrix_t& lhs, const matrix_t& rhs) {
+    for(std::size_t i = 0; i < lhs.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < lhs.get_cols_number(); ++j) {
+            if(lhs[i][j] != rhs[i][j]) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void run_benchmark(const std::string& name, const operation_t& operation, std::size_t max_threads) {
+    matrix_t expected;
+    double sequential_time = 0.0;
+
+    for(std::size_t threads_count = 1u; threads_count <= max_threads; threads_count *= 2u) {
+        matrix::thread_pool_t pool(threads_count);
+        matrix::execution_policy_t policy(pool);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        matrix_t result = operation(policy);
+        auto finish = std::chrono::high_resolution_clock::now();
+        double time = std::chrono::duration<double>(finish - start).count();
+
+        if(threads_count == 1u) {
+            expected = result;
+            sequential_time = time;
+        }
+
+        double speedup = sequential_time / time;
+        std::cout << std::setw(16) << name << std::setw(4) << threads_count << " threads: "
+                  << std::fixed << std::setprecision(4) << time << " s, speedup " << std::setprecision(2) << speedup
+                  << ", efficiency " << speedup / threads_count * 100.0 << "% "
+                  << (identical(result, expected) ? "SUCCESS" : "FAILED") << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t size = (argc > 1) ? std::stoull(argv[1]) : 2048u;
+    std::size_t max_threads = (argc > 2) ? std::stoull(argv[2]) : std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::mt19937 gen(42);
+    matrix_t lhs = random_matrix(size, gen);
+    matrix_t rhs = random_matrix(size, gen);
+
+    run_benchmark("multiplication", [&](const matrix::execution_policy_t& policy) {return matrix::multiplication(lhs, rhs, policy);}, max_threads);
+    run_benchmark("addition", [&](const matrix::execution_policy_t& policy) {return matrix::addition(lhs, rhs, policy);}, max_threads);
+    run_benchmark("transposition", [&](const matrix::execution_policy_t& policy) {return matrix::transposition(lhs, policy);}, max_threads);
+    run_benchmark("gauss_straight", [&](const matrix::execution_policy_t& policy) {
+        matrix_t m = lhs;
+        matrix::gauss_straight(m, policy);
+        return m;
+    }, max_threads);
+}
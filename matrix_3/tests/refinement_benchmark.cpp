@@ -0,0 +1,108 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "../matrix/refinement.hpp"
+
+/*  linear system with random matrix: LU in long double and double against mixed precision refinement
+    (factorization in float or double, refinement in working type)
+    usage: ./refinement_benchmark [max size] [threads]
+    sizes go from 250 up to max size (1000 by default) with step x2
+
+    accuracy: normwise backward error and max difference with solution of LU in long double */
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+template<typename T>
+long double difference(const matrix::matrix_t<T>& x, const matrix::matrix_t<long double>& exact) {
+    long double ret = 0.0;
+    for(std::size_t i = 0; i < x.get_rows_number(); ++i) {
+        ret = std::max(ret, std::abs(x[i][0] - exact[i][0]));
+    }
+
+    return ret;
+}
+
+template<typename T>
+void report(const std::string& name, double seconds, double reference, const matrix::refinement_result_t<T>& result,
+            const matrix::matrix_t<long double>& exact) {
+    std::cout << std::setw(24) << name << ": " << std::fixed << std::setprecision(4) << seconds << " s (x"
+              << std::setprecision(1) << reference / seconds << "), iterations " << result.iterations
+              << (result.fallback ? " (fallback)" : "") << std::scientific << std::setprecision(2)
+              << ", backward error " << static_cast<long double>(result.backward_error)
+              << ", difference " << difference(result.x, exact) << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_size = (argc > 1) ? std::stoull(argv[1]) : 1000u;
+    std::size_t threads = (argc > 2) ? std::stoull(argv[2]) : 1u;
+    matrix::thread_pool_t pool(threads);
+    matrix::execution_policy_t policy(pool);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    for(std::size_t size = 250u; size <= max_size; size *= 2u) {
+        matrix::matrix_t<long double> a(size, size), b(size, 1);
+        for(std::size_t i = 0; i < size; ++i) {
+            for(std::size_t j = 0; j < size; ++j) {
+                a[i][j] = dis(gen);
+            }
+            b[i][0] = dis(gen);
+        }
+        matrix::matrix_t<double> a_double(size, size), b_double(size, 1);
+        for(std::size_t i = 0; i < size; ++i) {
+            for(std::size_t j = 0; j < size; ++j) {
+                a_double[i][j] = a[i][j];
+            }
+            b_double[i][0] = b[i][0];
+        }
+
+        std::cout << size << " * " << size << std::endl;
+
+        /* current path: LU in long double */
+        matrix::refinement_result_t<long double> exact;
+        double reference = measure([&] {
+            exact.x = matrix::lu_decomposition_t<long double>(a, policy).solve(b);
+        });
+        exact.fallback = true;
+        exact.backward_error = matrix::backward_error(a, b, exact.x, policy);
+        report("LU long double", reference, reference, exact, exact.x);
+
+        matrix::refinement_result_t<long double> long_float;
+        double seconds = measure([&] {
+            long_float = matrix::solve_refined<long double, float>(a, b, {}, policy);
+        });
+        report("float -> long double", seconds, reference, long_float, exact.x);
+
+        matrix::refinement_result_t<long double> long_double;
+        seconds = measure([&] {
+            long_double = matrix::solve_refined<long double, double>(a, b, {}, policy);
+        });
+        report("double -> long double", seconds, reference, long_double, exact.x);
+
+        matrix::refinement_result_t<double> plain;
+        seconds = measure([&] {
+            plain.x = matrix::lu_decomposition_t<double>(a_double, policy).solve(b_double);
+        });
+        plain.backward_error = matrix::backward_error(a_double, b_double, plain.x, policy);
+        plain.fallback = true;
+        report("LU double", seconds, reference, plain, exact.x);
+
+        matrix::refinement_result_t<double> double_float;
+        seconds = measure([&] {
+            double_float = matrix::solve_refined<double, float>(a_double, b_double, {}, policy);
+        });
+        report("float -> double", seconds, reference, double_float, exact.x);
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
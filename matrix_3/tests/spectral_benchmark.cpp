@@ -0,0 +1,107 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "../matrix/spectral.hpp"
+
+/*  symmetric eigen-decomposition and svd of random matrices
+    usage: ./spectral_benchmark [max size] [threads]
+    sizes go from 250 up to max size (1000 by default) with step x2
+
+    accuracy: max |A - U * diag(values) * V^T| / max |A| and max |U^T * U - I|, |V^T * V - I| */
+
+template<typename F>
+double measure(F func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto finish = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+double max_abs(const matrix::matrix_t<double>& m) {
+    double ret = 0.0;
+    for(std::size_t i = 0; i < m.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < m.get_cols_number(); ++j) {
+            ret = std::max(ret, std::abs(m[i][j]));
+        }
+    }
+
+    return ret;
+}
+
+double reconstruction_error(const matrix::matrix_t<double>& a, const matrix::matrix_t<double>& u, const std::vector<double>& values,
+                            const matrix::matrix_t<double>& v, const matrix::execution_policy_t& policy) {
+    matrix::matrix_t<double> scaled = u;
+    for(std::size_t i = 0; i < scaled.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < scaled.get_cols_number(); ++j) {
+            scaled[i][j] *= values[j];
+        }
+    }
+
+    matrix::matrix_t<double> product = matrix::multiplication(std::as_const(scaled).view(), v.view().transposed(), policy);
+    for(std::size_t i = 0; i < product.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < product.get_cols_number(); ++j) {
+            product[i][j] -= a[i][j];
+        }
+    }
+
+    return max_abs(product) / max_abs(a);
+}
+
+double orthogonality_error(const matrix::matrix_t<double>& m, const matrix::execution_policy_t& policy) {
+    matrix::matrix_t<double> product = matrix::multiplication(m.view().transposed(), m.view(), policy);
+    for(std::size_t i = 0; i < product.get_rows_number(); ++i) {
+        product[i][i] -= 1.0;
+    }
+
+    return max_abs(product);
+}
+
+void report(const std::string& name, double seconds, double reconstruction, double orthogonality) {
+    std::cout << std::setw(20) << name << ": " << std::fixed << std::setprecision(4) << seconds << " s"
+              << std::scientific << std::setprecision(2) << ", reconstruction " << reconstruction
+              << ", orthogonality " << orthogonality << std::defaultfloat << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_size = (argc > 1) ? std::stoull(argv[1]) : 1000u;
+    std::size_t threads = (argc > 2) ? std::stoull(argv[2]) : 1u;
+    matrix::thread_pool_t pool(threads);
+    matrix::execution_policy_t policy(pool);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    for(std::size_t size = 250u; size <= max_size; size *= 2u) {
+        matrix::matrix_t<double> a(size, size), symmetric(size, size);
+        for(std::size_t i = 0; i < size; ++i) {
+            for(std::size_t j = 0; j < size; ++j) {
+                a[i][j] = dis(gen);
+            }
+            for(std::size_t j = 0; j <= i; ++j) {
+                symmetric[i][j] = symmetric[j][i] = a[i][j];
+            }
+        }
+
+        std::cout << size << " * " << size << std::endl;
+
+        matrix::symmetric_eigen_t<double> eigen;
+        double seconds = measure([&] {
+            eigen = matrix::symmetric_eigen(symmetric, policy);
+        });
+        report("symmetric eigen", seconds, reconstruction_error(symmetric, eigen.vectors, eigen.values, eigen.vectors, policy),
+               orthogonality_error(eigen.vectors, policy));
+
+        matrix::svd_t<double> decomposition;
+        seconds = measure([&] {
+            decomposition = matrix::svd(a, policy);
+        });
+        report("svd", seconds, reconstruction_error(a, decomposition.u, decomposition.values, decomposition.v, policy),
+               std::max(orthogonality_error(decomposition.u, policy), orthogonality_error(decomposition.v, policy)));
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
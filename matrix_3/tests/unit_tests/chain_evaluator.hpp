@@ -0,0 +1,93 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <stdexcept>
+
+#include "../../matrix/chain_evaluator.hpp"
+
+namespace {
+
+std::vector<matrix::matrix_t<double>> random_operands(const std::vector<std::size_t>& sizes, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::vector<matrix::matrix_t<double>> ret;
+    for(std::size_t i = 0; i + 1 < sizes.size(); ++i) {
+        ret.emplace_back(sizes[i], sizes[i + 1]);
+        for(std::size_t r = 0; r < sizes[i]; ++r) {
+            for(std::size_t c = 0; c < sizes[i + 1]; ++c) {
+                ret.back()[r][c] = dis(gen);
+            }
+        }
+    }
+
+    return ret;
+}
+
+std::vector<const matrix::matrix_t<double>*> pointers(const std::vector<matrix::matrix_t<double>>& operands) {
+    std::vector<const matrix::matrix_t<double>*> ret;
+    for(auto&& operand : operands) {
+        ret.push_back(&operand);
+    }
+
+    return ret;
+}
+
+} /* namespace */
+
+TEST(ChainEvaluator, Evaluate) {
+    std::mt19937 gen(21);
+    std::vector<std::size_t> sizes{30, 35, 15, 5, 10, 20, 25, 3, 40};
+    auto operands = random_operands(sizes, gen);
+
+    matrix::matrix_t<double> expected = operands.front();
+    for(std::size_t i = 1; i < operands.size(); ++i) {
+        expected = matrix::multiplication(expected, operands[i]);
+    }
+
+    matrix::Imatrix_chain_t chain;
+    for(std::size_t i = 0; i + 1 < sizes.size(); ++i) {
+        chain.push(sizes[i], sizes[i + 1]);
+    }
+
+    matrix::chain_evaluator_t<double> evaluator;
+    matrix::matrix_t<double> naive = evaluator.evaluate_left_to_right(pointers(operands));
+    std::size_t naive_flops = evaluator.get_stats().flops;
+    matrix::matrix_t<double> optimal = evaluator.evaluate(pointers(operands));
+    ASSERT_EQ(naive, expected);
+    ASSERT_EQ(optimal, expected);
+    ASSERT_EQ(evaluator.get_stats().flops, 2 * chain.get_optimal_order_oper());
+    ASSERT_LT(evaluator.get_stats().flops, naive_flops);
+
+    matrix::thread_pool_t pool(4);
+    matrix::chain_evaluator_t<double> parallel(matrix::execution_policy_t{pool});
+    ASSERT_EQ(parallel.evaluate(pointers(operands), chain.get_heuristic_order()), expected);
+
+    matrix::chain_evaluator_t<double> single;
+    ASSERT_EQ(single.evaluate({&operands[2]}), operands[2]);
+}
+
+TEST(ChainEvaluator, Errors) {
+    std::mt19937 gen(22);
+    auto operands = random_operands({4, 5, 6, 7}, gen);
+    matrix::chain_evaluator_t<double> evaluator;
+    ASSERT_THROW(evaluator.evaluate({}), std::runtime_error);
+    ASSERT_THROW(evaluator.evaluate(pointers(operands), {0}), std::runtime_error);
+    ASSERT_THROW(evaluator.evaluate(pointers(operands), {0, 0}), std::runtime_error);
+    ASSERT_THROW(evaluator.evaluate({&operands[0], &operands[2]}), std::runtime_error);
+}
+
+TEST(ChainEvaluator, MemoryModel) {
+    std::mt19937 gen(23);
+    std::vector<std::size_t> sizes{40, 7, 60, 3, 50, 45, 9, 70};
+    auto operands = random_operands(sizes, gen);
+    std::size_t count = operands.size();
+    matrix::memory_model_t memory(sizes, sizeof(double));
+
+    matrix::chain_evaluator_t<double> evaluator;
+    for(auto&& order : {matrix::optimal_chain_order(count, memory).order, matrix::optimal_chain_order(count, matrix::flops_model_t(sizes)).order}) {
+        evaluator.evaluate(pointers(operands), order);
+        ASSERT_EQ(evaluator.get_stats().peak_bytes, matrix::chain_order_value(count, memory, order));
+        ASSERT_EQ(evaluator.get_stats().flops, matrix::chain_order_value(count, matrix::flops_model_t(sizes), order));
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+
+#include "../../matrix/matrix.hpp"
+#include "common.hpp"
+
+TEST(Expression, Elementwise) {
+    std::mt19937 gen(31);
+    matrix::matrix_t<double> a = random_matrix(70, 300, gen);
+    matrix::matrix_t<double> b = random_matrix(70, 300, gen);
+    matrix::matrix_t<double> d = random_matrix(70, 300, gen);
+
+    matrix::matrix_t<double> actual = a + b * 2.5 - d;
+    matrix::matrix_t<double> negated = -(a - d) / 2;
+    for(std::size_t i = 0; i < a.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < a.get_cols_number(); ++j) {
+            ASSERT_EQ(actual[i][j], a[i][j] + b[i][j] * 2.5 - d[i][j]);
+            ASSERT_EQ(negated[i][j], -(a[i][j] - d[i][j]) / 2);
+        }
+    }
+
+    /* in place update reads every element before writing it */
+    matrix::matrix_t<double> expected = actual;
+    actual = actual + 3 * actual;
+    for(std::size_t i = 0; i < a.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < a.get_cols_number(); ++j) {
+            ASSERT_EQ(actual[i][j], expected[i][j] + 3 * expected[i][j]);
+        }
+    }
+
+    EXPECT_THROW(a + matrix::matrix_t<double>(70, 299), std::runtime_error);
+}
+
+TEST(Expression, Product) {
+    std::mt19937 gen(32);
+    matrix::matrix_t<double> a = random_matrix(50, 40, gen);
+    matrix::matrix_t<double> b = random_matrix(40, 60, gen);
+    matrix::matrix_t<double> c = random_matrix(50, 60, gen);
+    matrix::matrix_t<double> product = matrix::multiplication(a, b);
+
+    matrix::matrix_t<double> actual = a * b;
+    ASSERT_EQ(actual, product);
+
+    /* c + a * b goes through gemm accumulation, a * b - c through product buffer */
+    actual = c + a * b;
+    ASSERT_EQ(actual, matrix::addition(c, product));
+    actual = a * b - c;
+    ASSERT_EQ(actual, matrix::addition(product, matrix::matrix_t<double>(-1.0 * c)));
+    actual = a * b + a * b;
+    ASSERT_EQ(actual, matrix::matrix_t<double>(2.0 * product));
+
+    /* operands of product are evaluated first */
+    matrix::matrix_t<double> scaled = (2.0 * a) * (b + b);
+    ASSERT_EQ(scaled, matrix::matrix_t<double>(4.0 * product));
+
+    /* product reading destination is computed into temporary */
+    matrix::matrix_t<double> square = random_matrix(40, 40, gen);
+    matrix::matrix_t<double> expected = matrix::multiplication(square, square);
+    square = square * square;
+    ASSERT_EQ(square, expected);
+
+    EXPECT_THROW(a * c, std::runtime_error);
+}
+
+TEST(Expression, Parallel) {
+    std::mt19937 gen(33);
+    matrix::matrix_t<double> a = random_matrix(300, 500, gen);
+    matrix::matrix_t<double> b = random_matrix(500, 200, gen);
+    matrix::matrix_t<double> c = random_matrix(300, 200, gen);
+
+    matrix::thread_pool_t pool(4);
+    matrix::execution_policy_t policy(pool);
+
+    matrix::matrix_t<double> sequential = c * 0.5 + a * b;
+    matrix::matrix_t<double> parallel = matrix::evaluate(c * 0.5 + a * b, policy);
+    ASSERT_EQ(sequential, parallel);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <cmath>
+#include <stdexcept>
+
+#include "../../matrix/fixed_matrix.hpp"
+
+namespace {
+
+template<typename T, std::size_t R, std::size_t C>
+matrix::fixed_matrix_t<T, R, C> random_fixed(std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    matrix::fixed_matrix_t<T, R, C> ret;
+    for(std::size_t i = 0; i < R * C; ++i) {
+        ret.data()[i] = static_cast<T>(dis(gen));
+    }
+
+    return ret;
+}
+
+template<std::size_t N>
+void check_fixed_square(std::mt19937& gen) {
+    for(int test = 0; test < 20; ++test) {
+        auto m = random_fixed<double, N, N>(gen);
+        matrix::matrix_t<double> dynamic = m.to_matrix();
+        ASSERT_NEAR(matrix::det(m), dynamic.det(), 1e-12);
+
+        auto product = m * matrix::inverse(m);
+        for(std::size_t i = 0; i < N; ++i) {
+            for(std::size_t j = 0; j < N; ++j) {
+                ASSERT_NEAR(product[i][j], (i == j) ? 1.0 : 0.0, 1e-8);
+            }
+        }
+
+        auto b = random_fixed<double, N, 2>(gen);
+        auto x = matrix::solve(m, b);
+        auto residual = m * x - b;
+        for(std::size_t i = 0; i < N * 2; ++i) {
+            ASSERT_NEAR(residual.data()[i], 0.0, 1e-8);
+        }
+    }
+}
+
+/* compares every matrix of batch with scalar functions */
+template<typename T, std::size_t N>
+void check_fixed_batch(std::size_t count, const matrix::execution_policy_t& policy, double tolerance) {
+    std::mt19937 gen(N);
+    matrix::fixed_batch_t<T, N, N> a(count), b(count);
+    for(std::size_t idx = 0; idx < count; ++idx) {
+        a.set(idx, random_fixed<T, N, N>(gen) + matrix::fixed_matrix_t<T, N, N>::identity());
+        b.set(idx, random_fixed<T, N, N>(gen));
+    }
+
+    std::vector<T> dets = matrix::batch_det(a, policy);
+    auto inverses = matrix::batch_inverse(a, policy);
+    auto products = matrix::batch_multiply(a, b, policy);
+    auto solutions = matrix::batch_solve(a, b, policy);
+    for(std::size_t idx = 0; idx < count; ++idx) {
+        auto m = a.get(idx);
+        ASSERT_NEAR(dets[idx], matrix::det(m), tolerance);
+
+        auto inverse = matrix::inverse(m), product = m * b.get(idx), solution = matrix::solve(m, b.get(idx));
+        for(std::size_t i = 0; i < N; ++i) {
+            for(std::size_t j = 0; j < N; ++j) {
+                ASSERT_NEAR(inverses.get(idx)[i][j], inverse[i][j], tolerance * std::abs(inverse[i][j]) + tolerance);
+                ASSERT_NEAR(products.get(idx)[i][j], product[i][j], tolerance);
+                ASSERT_NEAR(solutions.get(idx)[i][j], solution[i][j], tolerance * std::abs(solution[i][j]) + tolerance);
+            }
+        }
+    }
+}
+
+} /* namespace */
+
+TEST(FixedMatrix, Square) {
+    std::mt19937 gen(31);
+    check_fixed_square<1>(gen);
+    check_fixed_square<2>(gen);
+    check_fixed_square<3>(gen);
+    check_fixed_square<4>(gen);
+    check_fixed_square<5>(gen);
+    check_fixed_square<6>(gen);
+}
+
+TEST(FixedMatrix, Operations) {
+    constexpr matrix::fixed_matrix_t<int, 3, 3> m{{2, 0, 1}, {1, 3, 2}, {1, 1, 2}};
+    static_assert(matrix::det(m) == 6);
+    static_assert(matrix::det(matrix::fixed_matrix_t<int, 5, 5>::identity()) == 1);
+    static_assert((m * matrix::fixed_matrix_t<int, 3, 3>::identity())[1][2] == 2);
+
+    std::mt19937 gen(32);
+    auto lhs = random_fixed<double, 3, 5>(gen);
+    auto rhs = random_fixed<double, 5, 2>(gen);
+    ASSERT_EQ((lhs * rhs).to_matrix(), matrix::multiplication(lhs.to_matrix(), rhs.to_matrix()));
+    ASSERT_EQ(matrix::transposition(lhs).to_matrix(), matrix::transposition(lhs.to_matrix()));
+    ASSERT_EQ((matrix::fixed_matrix_t<double, 3, 5>(lhs.to_matrix())), lhs);
+
+    using fixed_t = matrix::fixed_matrix_t<double, 2, 2>;
+    ASSERT_THROW(matrix::inverse(fixed_t{{1.0, 2.0}, {2.0, 4.0}}), std::runtime_error);
+    ASSERT_THROW(matrix::solve(matrix::fixed_matrix_t<double, 5, 5>{}, matrix::fixed_matrix_t<double, 5, 1>{}), std::runtime_error);
+    ASSERT_THROW((fixed_t{{1.0, 2.0}, {3.0}}), std::runtime_error);
+    ASSERT_THROW(fixed_t{matrix::matrix_t<double>(2, 3)}, std::runtime_error);
+}
+
+TEST(FixedMatrix, Batch) {
+    check_fixed_batch<double, 1>(1003, matrix::sequential_policy, 1e-10);
+    check_fixed_batch<double, 2>(1003, matrix::sequential_policy, 1e-10);
+    check_fixed_batch<double, 3>(1003, matrix::sequential_policy, 1e-10);
+    check_fixed_batch<double, 4>(1003, matrix::sequential_policy, 1e-10);
+    check_fixed_batch<float, 1>(1003, matrix::sequential_policy, 1e-3);
+    check_fixed_batch<float, 3>(1003, matrix::sequential_policy, 1e-3);
+    check_fixed_batch<float, 4>(17, matrix::sequential_policy, 1e-3);
+
+    matrix::thread_pool_t pool(4);
+    check_fixed_batch<double, 4>(5000, matrix::execution_policy_t(pool), 1e-10);
+
+    matrix::fixed_batch_t<double, 2, 2> empty;
+    ASSERT_TRUE(matrix::batch_det(empty).empty());
+    ASSERT_THROW(matrix::batch_multiply(empty, matrix::fixed_batch_t<double, 2, 2>(3)), std::runtime_error);
+}
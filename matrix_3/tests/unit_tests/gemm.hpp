@@ -0,0 +1,78 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../../matrix/matrix.hpp"
+
+namespace {
+
+template<typename T>
+std::vector<T> random_vector(std::size_t size, std::mt19937& gen) {
+    std::uniform_int_distribution<int> dis(-8, 8);
+    std::vector<T> ret(size);
+    for(auto&& elem : ret) {
+        elem = static_cast<T>(dis(gen));
+    }
+
+    return ret;
+}
+
+/* small integers in both matrices, so every type must give exact naive result */
+template<typename T>
+void check_gemm(std::size_t m, std::size_t n, std::size_t k, std::mt19937& gen) {
+    std::size_t lda = k + 3, ldb = n + 1, ldc = n + 2;
+    std::vector<T> a = random_vector<T>(m * lda, gen);
+    std::vector<T> b = random_vector<T>(k * ldb, gen);
+    std::vector<T> c = random_vector<T>(m * ldc, gen);
+    std::vector<T> expected = c;
+
+    for(std::size_t i = 0; i < m; ++i) {
+        for(std::size_t j = 0; j < n; ++j) {
+            for(std::size_t p = 0; p < k; ++p) {
+                expected[i * ldc + j] += a[i * lda + p] * b[p * ldb + j];
+            }
+        }
+    }
+
+    matrix::gemm(m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc);
+    ASSERT_EQ(c, expected) << "m = " << m << ", n = " << n << ", k = " << k;
+}
+
+} /* namespace */
+
+TEST(Gemm, EdgeSizes) {
+    std::mt19937 gen(42);
+    std::vector<std::size_t> sizes = {1, 2, 5, 6, 7, 17, 33, 97};
+    for(auto m : sizes) {
+        for(auto n : sizes) {
+            for(auto k : sizes) {
+                check_gemm<double>(m, n, k, gen);
+                check_gemm<float>(m, n, k, gen);
+                check_gemm<long double>(m, n, k, gen);
+                check_gemm<int>(m, n, k, gen);
+            }
+        }
+    }
+}
+
+TEST(Gemm, SeveralBlocks) {
+    std::mt19937 gen(7);
+    check_gemm<double>(211, 1300, 530, gen);
+    check_gemm<float>(211, 1300, 530, gen);
+    check_gemm<long double>(101, 70, 300, gen);
+}
+
+TEST(Gemm, Multiplication) {
+    matrix::matrix_t<double> lhs = { {1, 2, 3},
+                                     {4, 5, 6} };
+    matrix::matrix_t<double> rhs = { {1, 0},
+                                     {0, 1},
+                                     {2, -1} };
+    matrix::matrix_t<double> expected = { {7, -1},
+                                          {16, -1} };
+
+    ASSERT_TRUE(matrix::multiplication(lhs, rhs) == expected);
+    ASSERT_EQ(matrix::multiplication(matrix::matrix_t<double>(3, 0), matrix::matrix_t<double>(0, 4)), matrix::matrix_t<double>(3, 4));
+}
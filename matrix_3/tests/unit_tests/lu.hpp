@@ -0,0 +1,116 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+
+#include "../../matrix/matrix.hpp"
+
+namespace {
+
+matrix::matrix_t<double> random_square(std::size_t size, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    matrix::matrix_t<double> ret(size, size);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            ret[i][j] = dis(gen);
+        }
+    }
+
+    return ret;
+}
+
+double max_abs_difference(const matrix::matrix_t<double>& lhs, const matrix::matrix_t<double>& rhs) {
+    double ret = 0.0;
+    for(std::size_t i = 0; i < lhs.get_rows_number(); ++i) {
+        for(std::size_t j = 0; j < lhs.get_cols_number(); ++j) {
+            ret = std::max(ret, std::abs(lhs[i][j] - rhs[i][j]));
+        }
+    }
+
+    return ret;
+}
+
+} /* namespace */
+
+TEST(LU, Determinant) {
+    matrix::matrix_t<double> m = { {0, 2, 1},
+                                   {1, 1, 1},
+                                   {2, 1, 3} };
+    ASSERT_TRUE(matrix::equal(m.det(), -3.0));
+
+    matrix::matrix_t<int> integer = { {2, 1},
+                                      {7, 4} };
+    ASSERT_EQ(integer.det(), 1);
+
+    matrix::matrix_t<double> singular = { {1, 2, 3},
+                                          {2, 4, 6},
+                                          {1, 0, 1} };
+    ASSERT_TRUE(matrix::equal(singular.det(), 0.0));
+    ASSERT_THROW(matrix::matrix_t<double>(2, 3).det(), std::runtime_error);
+
+    /* triangular matrix bigger than block */
+    matrix::matrix_t<double> triangular(150, 150);
+    for(std::size_t i = 0; i < 150; ++i) {
+        for(std::size_t j = i; j < 150; ++j) {
+            triangular[i][j] = (i == j) ? ((i % 2 == 0) ? 2.0 : 0.5) : 1.0;
+        }
+    }
+    ASSERT_TRUE(matrix::equal(triangular.det(), 1.0));
+}
+
+TEST(LU, Factorization) {
+    std::mt19937 gen(42);
+    std::size_t size = 200;
+    matrix::matrix_t<double> m = random_square(size, gen);
+    matrix::lu_decomposition_t<double> lu(m);
+
+    matrix::matrix_t<double> lower(size, size), upper(size, size), permuted(size, size);
+    for(std::size_t i = 0; i < size; ++i) {
+        for(std::size_t j = 0; j < size; ++j) {
+            if(j < i) {lower[i][j] = lu.get_lu()[i][j];} else {upper[i][j] = lu.get_lu()[i][j];}
+            permuted[i][j] = m[lu.get_permutation()[i]][j];
+        }
+        lower[i][i] = 1.0;
+    }
+
+    ASSERT_LT(max_abs_difference(matrix::multiplication(lower, upper), permuted), 1e-12);
+}
+
+TEST(LU, SolveInverse) {
+    std::mt19937 gen(7);
+    for(std::size_t size : {1u, 5u, 64u, 65u, 300u}) {
+        matrix::matrix_t<double> m = random_square(size, gen);
+        matrix::matrix_t<double> x = random_square(size, gen);
+        x.resize(size, 3);
+
+        matrix::lu_decomposition_t<double> lu(m);
+        ASSERT_LT(max_abs_difference(lu.solve(matrix::multiplication(m, x)), x), 1e-8) << "size = " << size;
+
+        matrix::matrix_t<double> identity(size, size);
+        for(std::size_t i = 0; i < size; ++i) {identity[i][i] = 1.0;}
+        ASSERT_LT(max_abs_difference(matrix::multiplication(m, matrix::inverse(m)), identity), 1e-8) << "size = " << size;
+
+        x.resize(size, 1);
+        auto&& [solution, fundamental] = matrix::solve_linear_system(m, matrix::multiplication(m, x));
+        ASSERT_LT(max_abs_difference(solution, x), 1e-8) << "size = " << size;
+        ASSERT_EQ(fundamental.get_elements_number(), 0u);
+    }
+
+    matrix::matrix_t<double> singular = { {1, 2},
+                                          {2, 4} };
+    ASSERT_THROW(matrix::inverse(singular), std::runtime_error);
+}
+
+TEST(LU, Parallel) {
+    std::mt19937 gen(3);
+    matrix::matrix_t<double> m = random_square(333, gen);
+    matrix::lu_decomposition_t<double> sequential(m);
+
+    matrix::thread_pool_t pool(4);
+    matrix::lu_decomposition_t<double> parallel(m, matrix::execution_policy_t(pool));
+
+    ASSERT_EQ(sequential.det(), parallel.det());
+    ASSERT_EQ(max_abs_difference(sequential.get_lu(), parallel.get_lu()), 0.0);
+    ASSERT_EQ(max_abs_difference(sequential.inverse(), parallel.inverse()), 0.0);
+}
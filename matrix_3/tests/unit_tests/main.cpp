@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+
+#include "gemm.hpp"
+#include "parallel.hpp"
+#include "lu.hpp"
+#include "expression.hpp"
+#include "storage.hpp"
+#include "sparse.hpp"
+#include "krylov.hpp"
+#include "matrix_chain.hpp"
+#include "chain_evaluator.hpp"
+#include "fixed_matrix.hpp"
+#include "matrix_io.hpp"
+#include "matrix_view.hpp"
+#include "refinement.hpp"
+#include "spectral.hpp"
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <stdexcept>
+
+#include "../../matrix/matrix_chain.hpp"
+
+namespace {
+
+matrix::Imatrix_chain_t random_chain(std::size_t count, std::size_t max_size, std::mt19937& gen) {
+    std::uniform_int_distribution<std::size_t> dis(1u, max_size);
+    matrix::Imatrix_chain_t ret;
+    std::size_t rows = dis(gen);
+    for(std::size_t i = 0; i < count; ++i) {
+        std::size_t cols = dis(gen);
+        ret.push(rows, cols);
+        rows = cols;
+    }
+
+    return ret;
+}
+
+} /* namespace */
+
+TEST(MatrixChain, Optimal) {
+    matrix::Imatrix_chain_t chain;
+    std::vector<std::size_t> sizes{30, 35, 15, 5, 10, 20, 25};
+    for(std::size_t i = 0; i + 1 < sizes.size(); ++i) {
+        chain.push(sizes[i], sizes[i + 1]);
+    }
+
+    /* ((A0 (A1 A2)) ((A3 A4) A5)) */
+    ASSERT_EQ(chain.get_optimal_order_oper(), 15125u);
+    ASSERT_EQ(chain.get_order_oper(chain.get_optimal_order()), 15125u);
+    ASSERT_EQ(chain.get_optimal_order(), (std::vector<std::size_t>{3, 4, 1, 0, 2}));
+
+    ASSERT_THROW(chain.push(24, 3), std::runtime_error);
+    ASSERT_THROW(chain.push(25, 0), std::runtime_error);
+    ASSERT_THROW(chain.get_order_oper({0, 0}), std::runtime_error);
+    ASSERT_THROW(chain.get_order_oper({5}), std::runtime_error);
+}
+
+TEST(MatrixChain, Heuristic) {
+    std::mt19937 gen(11);
+    for(std::size_t count : {2u, 3u, 10u, 50u, 200u}) {
+        matrix::Imatrix_chain_t chain = random_chain(count, 100u, gen);
+        std::vector<std::size_t> order = chain.get_heuristic_order();
+        ASSERT_EQ(order.size(), count - 1);
+
+        std::size_t optimal = chain.get_optimal_order_oper();
+        std::size_t heuristic = chain.get_order_oper(order);
+        ASSERT_GE(heuristic, optimal);
+        ASSERT_LE(heuristic, optimal + optimal / 4);
+    }
+
+    matrix::Imatrix_chain_t single;
+    single.push(3, 4);
+    ASSERT_TRUE(single.get_heuristic_order().empty());
+    ASSERT_EQ(single.get_optimal_order_oper(), 0u);
+}
+
+TEST(MatrixChain, Wavefront) {
+    std::mt19937 gen(12);
+    matrix::Imatrix_chain_t chain = random_chain(150u, 200u, gen);
+    const auto& sizes = chain.get_sizes();
+    auto flops = [&sizes](std::size_t i, std::size_t k, std::size_t j) {return sizes[i] * sizes[k + 1] * sizes[j + 1];};
+
+    auto sequential = matrix::optimal_chain_order(chain.size(), flops);
+    ASSERT_EQ(sequential.cost, chain.get_optimal_order_oper());
+    ASSERT_EQ(sequential.order, chain.get_optimal_order());
+
+    matrix::thread_pool_t pool(4);
+    auto parallel = matrix::optimal_chain_order(chain.size(), flops, matrix::execution_policy_t(pool));
+    ASSERT_EQ(parallel.cost, sequential.cost);
+    ASSERT_EQ(parallel.order, sequential.order);
+}
+
+TEST(MatrixChain, CostModels) {
+    std::mt19937 gen(13);
+    matrix::Imatrix_chain_t chain = random_chain(60u, 300u, gen);
+    const auto& sizes = chain.get_sizes();
+
+    auto flops = matrix::optimal_chain_order(chain.size(), matrix::flops_model_t(sizes));
+    ASSERT_EQ(flops.cost, 2 * chain.get_optimal_order_oper());
+    ASSERT_EQ(flops.order, chain.get_optimal_order());
+
+    /* time of pure flops is the same order */
+    matrix::gemm_timing_t timing;
+    timing.per_flop = 1e-10;
+    auto time = matrix::optimal_chain_order(chain.size(), matrix::time_model_t(sizes, timing));
+    ASSERT_EQ(time.order, flops.order);
+    ASSERT_NEAR(time.cost, flops.cost * 1e-10, 1e-9 * time.cost);
+
+    matrix::memory_model_t memory(sizes, sizeof(double));
+    auto smallest = matrix::optimal_chain_order(chain.size(), memory);
+    std::size_t flops_peak = matrix::chain_order_value(chain.size(), memory, flops.order);
+    ASSERT_LE(smallest.cost, flops_peak);
+    ASSERT_EQ(matrix::chain_order_value(chain.size(), memory, smallest.order), smallest.cost);
+
+    /* budget above peak of optimal order doesn't change it */
+    auto unlimited = matrix::optimal_chain_order(chain.size(), matrix::flops_model_t(sizes), memory, flops_peak);
+    ASSERT_TRUE(unlimited);
+    ASSERT_EQ(unlimited->order, flops.order);
+
+    auto limited = matrix::optimal_chain_order(chain.size(), matrix::flops_model_t(sizes), memory, smallest.cost);
+    ASSERT_TRUE(limited);
+    ASSERT_LE(matrix::chain_order_value(chain.size(), memory, limited->order), smallest.cost);
+    ASSERT_GE(limited->cost, flops.cost);
+    ASSERT_EQ(limited->cost, matrix::chain_order_value(chain.size(), matrix::flops_model_t(sizes), limited->order));
+
+    ASSERT_FALSE(matrix::optimal_chain_order(chain.size(), matrix::flops_model_t(sizes), memory, smallest.cost - 1));
+}
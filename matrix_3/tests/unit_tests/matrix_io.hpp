@@ -0,0 +1,78 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <stdexcept>
+
+#include "../../matrix/matrix_io.hpp"
+#include "common.hpp"
+
+TEST(MatrixIO, Binary) {
+    std::mt19937 gen(41);
+    std::string path = testing::TempDir() + "matrix_io_binary.bin";
+    matrix::matrix_t<double> m = random_matrix(37, 130, gen, -1e3, 1e3);
+
+    for(auto layout : {matrix::layout_t::row_major, matrix::layout_t::col_major}) {
+        matrix::write_binary(path, m, layout);
+        ASSERT_TRUE(identical(matrix::read_binary<double>(path), m));
+
+        matrix::thread_pool_t pool(4);
+        ASSERT_TRUE(identical(matrix::read_binary<double>(path, matrix::execution_policy_t(pool)), m));
+
+        matrix::mapped_matrix_t<double> mapped(path);
+        ASSERT_EQ(mapped.get_rows_number(), 37u);
+        ASSERT_EQ(mapped.get_cols_number(), 130u);
+        ASSERT_EQ(mapped.get_layout(), layout);
+        ASSERT_EQ(mapped.at(5, 101), m[5][101]);
+        ASSERT_EQ(mapped.view()(36, 7), m[36][7]);
+        ASSERT_EQ(matrix::transposition(mapped.view()), matrix::transposition(m));
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % matrix::storage_alignment, 0u);
+
+        matrix::mapped_matrix_t<double> moved(std::move(mapped));
+        ASSERT_TRUE(identical(moved.to_matrix(), m));
+
+        /* elements are converted to type of matrix */
+        matrix::matrix_t<float> converted = matrix::read_binary<float>(path);
+        ASSERT_EQ(converted[36][129], static_cast<float>(m[36][129]));
+        ASSERT_THROW(matrix::mapped_matrix_t<float>{path}, std::runtime_error);
+    }
+
+    matrix::write_binary(path, matrix::matrix_t<long double>(0, 3));
+    ASSERT_EQ(matrix::read_binary<long double>(path).get_cols_number(), 3u);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "MATRIXB";
+    ASSERT_THROW(matrix::read_binary<double>(path), std::runtime_error);
+    ASSERT_THROW(matrix::read_binary<double>(path + ".missing"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(MatrixIO, Text) {
+    std::mt19937 gen(42);
+    matrix::matrix_t<double> m = random_matrix(20, 15, gen, -1e3, 1e3);
+
+    std::stringstream stream;
+    matrix::write_text(stream, m);
+    stream << "tail";
+
+    matrix::matrix_t<double> read(20, 15);
+    ASSERT_TRUE(matrix::read_text(stream, read));
+    ASSERT_TRUE(identical(read, m));
+
+    /* only elements are taken from stream */
+    std::string tail; stream >> tail;
+    ASSERT_EQ(tail, "tail");
+
+    std::istringstream formatted("  1 -2.5\n+3 4e2\n");
+    matrix::matrix_t<double> small(2, 2);
+    ASSERT_TRUE(matrix::read_text(formatted, small));
+    ASSERT_EQ(small, (matrix::matrix_t<double>{{1.0, -2.5}, {3.0, 400.0}}));
+
+    std::istringstream invalid("1 2 x 4");
+    ASSERT_FALSE(matrix::read_text(invalid, small));
+    std::istringstream short_input("1 2 3");
+    ASSERT_FALSE(matrix::read_text(short_input, small));
+}
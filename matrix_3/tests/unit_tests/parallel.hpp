@@ -0,0 +1,61 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <atomic>
+#include <stdexcept>
+
+#include "../../matrix/matrix.hpp"
+#include "common.hpp"
+
+TEST(Parallel, ThreadPool) {
+    matrix::thread_pool_t pool(4);
+    ASSERT_EQ(pool.get_threads_number(), 4u);
+
+    std::vector<std::atomic<int>> counters(1000);
+    pool.parallel_for(counters.size(), [&](std::size_t i) {
+        /* nested parallel_for must not deadlock */
+        pool.parallel_for(3, [&](std::size_t) {++counters[i];});
+    });
+
+    for(auto&& counter : counters) {
+        ASSERT_EQ(counter.load(), 3);
+    }
+
+    ASSERT_THROW(pool.parallel_for(100, [](std::size_t i) {
+        if(i == 42) {throw std::runtime_error("task failed");}
+    }), std::runtime_error);
+}
+
+TEST(Parallel, Deterministic) {
+    std::mt19937 gen(42);
+    matrix::matrix_t<double> lhs = random_matrix(300, 517, gen);
+    matrix::matrix_t<double> rhs = random_matrix(517, 411, gen);
+    matrix::matrix_t<double> other = random_matrix(300, 517, gen);
+
+    matrix::matrix_t<double> product = matrix::multiplication(lhs, rhs);
+    matrix::matrix_t<double> sum = matrix::addition(lhs, other);
+    matrix::matrix_t<double> transposed = matrix::transposition(lhs);
+    matrix::matrix_t<double> straight = lhs;
+    matrix::gauss_straight(straight);
+    matrix::matrix_t<double> reverse = straight;
+    matrix::gauss_reverse(reverse);
+
+    ASSERT_EQ(transposed[5][7], lhs[7][5]);
+    ASSERT_EQ(sum[3][500], lhs[3][500] + other[3][500]);
+
+    for(std::size_t threads_count : {2u, 3u, 8u}) {
+        matrix::thread_pool_t pool(threads_count);
+        matrix::execution_policy_t policy(pool);
+
+        ASSERT_TRUE(identical(matrix::multiplication(lhs, rhs, policy), product));
+        ASSERT_TRUE(identical(matrix::addition(lhs, other, policy), sum));
+        ASSERT_TRUE(identical(matrix::transposition(lhs, policy), transposed));
+
+        matrix::matrix_t<double> m = lhs;
+        matrix::gauss_straight(m, policy);
+        ASSERT_TRUE(identical(m, straight));
+        matrix::gauss_reverse(m, policy);
+        ASSERT_TRUE(identical(m, reverse));
+    }
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../../matrix/sparse_lu.hpp"
+#include "../../matrix/sparse_cholesky.hpp"
+
+namespace {
+
+/* diagonally dominant matrix with a few random off diagonal elements in every row */
+std::vector<matrix::triplet_t<double>> random_sparse_triplets(std::size_t size, std::size_t per_row, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    std::uniform_int_distribution<std::size_t> col(0, size - 1);
+    std::vector<matrix::triplet_t<double>> ret;
+    for(std::size_t i = 0; i < size; ++i) {
+        ret.push_back({i, i, 2.0 * per_row});
+        for(std::size_t k = 0; k < per_row; ++k) {
+            ret.push_back({i, col(gen), dis(gen)});
+        }
+    }
+
+    return ret;
+}
+
+double max_vector_difference(const std::vector<double>& lhs, const std::vector<double>& rhs) {
+    double ret = 0.0;
+    for(std::size_t i = 0; i < lhs.size(); ++i) {
+        ret = std::max(ret, std::abs(lhs[i] - rhs[i]));
+    }
+
+    return ret;
+}
+
+} /* namespace */
+
+TEST(Sparse, Compression) {
+    /* duplicates are summed, unsorted input */
+    std::vector<matrix::triplet_t<double>> triplets = { {1, 2, 1.0}, {0, 1, 2.0}, {1, 0, 3.0}, {1, 2, 4.0}, {0, 1, -2.0} };
+    matrix::matrix_t<double> dense = { {0, 0, 0},
+                                       {3, 0, 5} };
+
+    matrix::csr_matrix_t<double> csr(2, 3, triplets);
+    ASSERT_EQ(csr.get_row_ptr(), (std::vector<std::size_t>{0, 1, 3}));
+    ASSERT_EQ(csr.get_col_idx(), (std::vector<std::size_t>{1, 0, 2}));
+    ASSERT_EQ(csr.to_dense(), dense);
+
+    matrix::csc_matrix_t<double> csc(2, 3, triplets);
+    ASSERT_EQ(csc.get_col_ptr(), (std::vector<std::size_t>{0, 1, 2, 3}));
+    ASSERT_EQ(csc.to_dense(), dense);
+
+    ASSERT_EQ(matrix::csc_matrix_t<double>(csr).to_dense(), dense);
+    ASSERT_EQ(matrix::csr_matrix_t<double>(csc).to_dense(), dense);
+    ASSERT_EQ(matrix::csr_matrix_t<double>(dense).get_nonzeros_number(), 2u);
+
+    ASSERT_THROW(matrix::csr_matrix_t<double>(2, 2, triplets), std::runtime_error);
+}
+
+TEST(Sparse, Multiplication) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    const std::size_t size = 10000;
+
+    auto triplets = random_sparse_triplets(size, 5, gen);
+    matrix::csr_matrix_t<double> csr(size, size, triplets);
+    matrix::csc_matrix_t<double> csc(csr);
+
+    std::vector<double> x(size);
+    for(auto&& elem : x) {
+        elem = dis(gen);
+    }
+
+    std::vector<double> expected(size);
+    for(auto&& t : triplets) {
+        expected[t.row] += t.value * x[t.col];
+    }
+
+    ASSERT_LT(max_vector_difference(csr.multiply(x), expected), 1e-12);
+    ASSERT_LT(max_vector_difference(csc.multiply(x), expected), 1e-12);
+
+    matrix::thread_pool_t pool(4);
+    ASSERT_EQ(csr.multiply(x, matrix::execution_policy_t(pool)), csr.multiply(x));
+
+    ASSERT_THROW(csr.multiply(std::vector<double>(size + 1)), std::runtime_error);
+}
+
+TEST(Sparse, Ordering) {
+    std::mt19937 gen(2);
+    matrix::csc_matrix_t<double> m(500, 500, random_sparse_triplets(500, 3, gen));
+
+    std::vector<std::size_t> order = matrix::amd_order(m);
+    std::sort(order.begin(), order.end());
+    for(std::size_t i = 0; i < order.size(); ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+
+    /* arrow matrix: center must be eliminated in the end (it ties with the last leaf), otherwise factors are dense */
+    const std::size_t size = 200;
+    std::vector<matrix::triplet_t<double>> arrow;
+    for(std::size_t i = 0; i < size; ++i) {
+        arrow.push_back({i, i, 4.0});
+        if(i) {
+            arrow.push_back({0, i, 1.0});
+            arrow.push_back({i, 0, 1.0});
+        }
+    }
+    matrix::csc_matrix_t<double> arrow_matrix(size, size, arrow);
+    std::vector<std::size_t> arrow_order = matrix::amd_order(arrow_matrix);
+    ASSERT_GE(std::find(arrow_order.begin(), arrow_order.end(), 0u) - arrow_order.begin(), static_cast<std::ptrdiff_t>(size - 2));
+
+    matrix::sparse_lu_t<double> lu(arrow_matrix);
+    /* no fill, only unit diagonal of L is added */
+    ASSERT_EQ(lu.get_factor_nonzeros(), arrow_matrix.get_nonzeros_number() + size);
+}
+
+TEST(Sparse, Solve) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    for(std::size_t size : {1u, 7u, 100u, 300u}) {
+        matrix::csc_matrix_t<double> m(size, size, random_sparse_triplets(size, 3, gen));
+        std::vector<double> b(size);
+        for(auto&& elem : b) {
+            elem = dis(gen);
+        }
+
+        matrix::sparse_lu_t<double> lu(m);
+        ASSERT_FALSE(lu.singular());
+        std::vector<double> x = lu.solve(b);
+        ASSERT_LT(max_vector_difference(m.multiply(x), b), 1e-10);
+
+        matrix::matrix_t<double> column(size, 1);
+        for(std::size_t i = 0; i < size; ++i) {
+            column[i][0] = b[i];
+        }
+        matrix::matrix_t<double> dense = matrix::solve_linear_system(m.to_dense(), column).first;
+        for(std::size_t i = 0; i < size; ++i) {
+            ASSERT_NEAR(dense[i][0], x[i], 1e-9);
+        }
+    }
+
+    /* zero diagonal needs off diagonal pivots */
+    matrix::csc_matrix_t<double> permutation(3, 3, {{0, 2, 1.0}, {1, 0, 2.0}, {2, 1, 4.0}});
+    std::vector<double> x = matrix::sparse_lu_t<double>(permutation).solve({1.0, 2.0, 4.0});
+    ASSERT_EQ(x, (std::vector<double>{1.0, 1.0, 1.0}));
+}
+
+TEST(Sparse, Singular) {
+    matrix::csc_matrix_t<double> m(3, 3, {{0, 0, 1.0}, {0, 1, 2.0}, {1, 0, 2.0}, {1, 1, 4.0}, {2, 2, 1.0}});
+    matrix::sparse_lu_t<double> lu(m);
+    ASSERT_TRUE(lu.singular());
+    ASSERT_THROW(lu.solve({1.0, 1.0, 1.0}), std::runtime_error);
+
+    ASSERT_THROW(matrix::sparse_lu_t<double>(matrix::csc_matrix_t<double>(2, 3, {})), std::runtime_error);
+}
+
+TEST(Sparse, Cholesky) {
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+    for(std::size_t size : {1u, 10u, 200u, 1000u}) {
+        /* symmetric diagonally dominant matrix with positive diagonal is positive definite */
+        std::vector<matrix::triplet_t<double>> triplets;
+        for(auto&& t : random_sparse_triplets(size, 3, gen)) {
+            triplets.push_back({t.row, t.col, t.value / 2.0});
+            triplets.push_back({t.col, t.row, t.value / 2.0});
+        }
+        matrix::csc_matrix_t<double> m(size, size, triplets);
+
+        std::vector<double> b(size);
+        for(auto&& elem : b) {
+            elem = dis(gen);
+        }
+
+        matrix::sparse_cholesky_t<double> cholesky(m);
+        ASSERT_TRUE(cholesky.positive_definite());
+        std::vector<double> x = cholesky.solve(b);
+        ASSERT_LT(max_vector_difference(m.multiply(x), b), 1e-10);
+        ASSERT_LT(max_vector_difference(x, matrix::sparse_lu_t<double>(m).solve(b)), 1e-10);
+    }
+
+    /* grid laplacian, one vertex is grounded: no fill for path, moderate fill for grid */
+    const std::size_t side = 30;
+    std::vector<matrix::triplet_t<double>> laplacian;
+    for(std::size_t i = 0; i < side; ++i) {
+        for(std::size_t j = 0; j < side; ++j) {
+            std::size_t v = i * side + j;
+            laplacian.push_back({v, v, (v == 0) ? 5.0 : 4.0});
+            if(j + 1 < side) {
+                laplacian.push_back({v, v + 1, -1.0});
+                laplacian.push_back({v + 1, v, -1.0});
+            }
+
+            if(i + 1 < side) {
+                laplacian.push_back({v, v + side, -1.0});
+                laplacian.push_back({v + side, v, -1.0});
+            }
+        }
+    }
+    matrix::csc_matrix_t<double> grid(side * side, side * side, laplacian);
+    std::vector<double> ones(side * side, 1.0);
+    matrix::sparse_cholesky_t<double> grid_cholesky(grid);
+    ASSERT_LT(max_vector_difference(grid.multiply(grid_cholesky.solve(ones)), ones), 1e-10);
+    ASSERT_LT(grid_cholesky.get_factor_nonzeros(), 20u * side * side);
+
+    matrix::csc_matrix_t<double> indefinite(2, 2, {{0, 0, 1.0}, {0, 1, 2.0}, {1, 0, 2.0}, {1, 1, 1.0}});
+    matrix::sparse_cholesky_t<double> indefinite_cholesky(indefinite);
+    ASSERT_FALSE(indefinite_cholesky.positive_definite());
+    ASSERT_THROW(indefinite_cholesky.solve({1.0, 1.0}), std::runtime_error);
+}